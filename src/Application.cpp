@@ -19,10 +19,20 @@
 #include "gui/FreeTypeGX.h"
 #include "game/GameList.h"
 #include "resources/Resources.h"
+#include "resources/TextureCache.h"
+#include "resources/TextureDiskCache.h"
 #include "settings/CSettings.h"
 #include "sounds/SoundHandler.hpp"
+#include "system/CProfiler.h"
 #include "system/exception_handler.h"
 #include "utils/logger.h"
+#include "video/SpriteBatch.h"
+
+//! frames between redraws while nothing changes on screen
+#define IDLE_REFRESH_FRAMES     60
+//! frames without change before the TV gets a frame with FXAA in the still frames mode,
+//! animations that only step every few frames then do not flicker between AA and no AA
+#define STILL_FRAME_DELAY       10
 
 Application *Application::applicationInstance = NULL;
 bool Application::exitApplication = false;
@@ -63,6 +73,9 @@ Application::~Application()
 
 	AsyncDeleter::destroyInstance();
     Resources::Clear();
+    TextureCache::destroyInstance();
+    TextureDiskCache::destroyInstance();
+    CProfiler::destroyInstance();
 
 	SoundHandler::DestroyInstance();
 }
@@ -90,8 +103,10 @@ void Application::fadeOut()
 	    video->prepareDrcRendering();
 	    mainWindow->drawDrc(video);
 
+        SpriteBatch::flush();
         GX2SetDepthOnlyControl(GX2_DISABLE, GX2_DISABLE, GX2_COMPARE_ALWAYS);
         fadeOut.draw(video);
+        SpriteBatch::flush();
         GX2SetDepthOnlyControl(GX2_ENABLE, GX2_ENABLE, GX2_COMPARE_LEQUAL);
 
 	    video->drcDrawDone();
@@ -101,8 +116,10 @@ void Application::fadeOut()
 
 	    mainWindow->drawTv(video);
 
+        SpriteBatch::flush();
         GX2SetDepthOnlyControl(GX2_DISABLE, GX2_DISABLE, GX2_COMPARE_ALWAYS);
         fadeOut.draw(video);
+        SpriteBatch::flush();
         GX2SetDepthOnlyControl(GX2_ENABLE, GX2_ENABLE, GX2_COMPARE_LEQUAL);
 
 	    video->tvDrawDone();
@@ -145,29 +162,96 @@ void Application::executeThread(void)
 
     mainWindow = new MainWindow(video->getTvWidth(), video->getTvHeight());
 
+    //! frame timing overlay on the DRC, toggled with ZL + ZR + MINUS
+    CProfiler *profiler = CProfiler::instance();
+    GuiFrame profilerFrame(video->getDrcWidth(), video->getDrcHeight());
+    GuiText profilerText("", 18, glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
+    profilerText.setAlignment(ALIGN_LEFT | ALIGN_TOP);
+    profilerText.setPosition(10, -10);
+    profilerText.setMaxWidth(video->getDrcWidth() - 20, GuiText::WRAP);
+    profilerFrame.append(&profilerText);
+
+    u32 idleFrames = 0;
+
     log_printf("Entering main loop\n");
 
     //! main GX2 loop (60 Hz cycle with max priority on core 1)
 	while(!exitApplication)
 	{
+	    profiler->beginFrame();
+
 	    //! Read out inputs
+	    profiler->beginPhase(CProfiler::PHASE_INPUT);
 	    controller.update(video->getTvWidth(), video->getTvHeight(), video->getDrcWidth(), video->getDrcHeight());
 
         if(controller.vpad.btns_d & VPAD_BUTTON_HOME)
             exitApplication = true;
 
+        if((controller.vpad.btns_d & VPAD_BUTTON_MINUS) && ((controller.vpad.btns_h & (VPAD_BUTTON_ZL | VPAD_BUTTON_ZR)) == (VPAD_BUTTON_ZL | VPAD_BUTTON_ZR)))
+        {
+            profiler->setEnabled(!profiler->isEnabled());
+            GuiElement::requestRedraw();
+        }
+
         //! update controller states
         mainWindow->update(&controller);
-
-        //! start rendering DRC
-	    video->prepareDrcRendering();
-	    mainWindow->drawDrc(video);
-	    video->drcDrawDone();
-
-        //! start rendering TV
-	    video->prepareTvRendering();
-	    mainWindow->drawTv(video);
-	    video->tvDrawDone();
+        profiler->endPhase(CProfiler::PHASE_INPUT);
+
+        //! refresh twice per second, the text is laid out again on every change
+        if(profiler->isEnabled() && (video->getFrameCount() % 30) == 0)
+        {
+            char text[512];
+            profiler->getSummary(text, sizeof(text));
+            profilerText.setText(text);
+        }
+
+        //! without input or a redraw request of a changed or moving element the screen stays the same
+        if(controller.isActive() || GuiElement::checkRedrawRequest())
+            idleFrames = 0;
+        else
+            idleFrames++;
+
+        //! effects finish after drawing so one more frame is drawn after the last change,
+        //! the periodic refresh catches elements that changed without telling us
+        u8 fxaaMode = CSettings::getValueAsU8(CSettings::TvAntiAliasing);
+        bool stillFrame = (idleFrames == STILL_FRAME_DELAY) && (fxaaMode == AA_MODE_STILL);
+        bool drawFrame = (idleFrames < 2) || stillFrame || ((idleFrames % IDLE_REFRESH_FRAMES) == 0) || (video->getFrameCount() == 0);
+
+        if(drawFrame)
+        {
+            video->setFXAAMode(fxaaMode);
+            video->setStillFrame(idleFrames >= STILL_FRAME_DELAY);
+
+            //! start rendering DRC
+            profiler->beginPhase(CProfiler::PHASE_DRAW_DRC);
+            video->prepareDrcRendering();
+            mainWindow->drawDrc(video);
+
+            if(profiler->isEnabled())
+            {
+                SpriteBatch::flush();
+                GX2SetDepthOnlyControl(GX2_DISABLE, GX2_DISABLE, GX2_COMPARE_ALWAYS);
+                profilerFrame.draw(video);
+                SpriteBatch::flush();
+                GX2SetDepthOnlyControl(GX2_ENABLE, GX2_ENABLE, GX2_COMPARE_LEQUAL);
+            }
+            profiler->endPhase(CProfiler::PHASE_DRAW_DRC);
+
+            video->drcDrawDone();
+
+            //! start rendering TV
+            profiler->beginPhase(CProfiler::PHASE_DRAW_TV);
+            video->prepareTvRendering();
+            mainWindow->drawTv(video);
+            profiler->endPhase(CProfiler::PHASE_DRAW_TV);
+
+            video->tvDrawDone();
+        }
+        else
+        {
+            //! nothing is submitted and not swapped, the scan buffers keep showing the last frame
+            profiler->count(CProfiler::COUNTER_IDLE_FRAMES);
+        }
 
         //! enable screen after first frame render
 	    if(video->getFrameCount() == 0) {
@@ -176,16 +260,24 @@ void Application::executeThread(void)
 	    }
 
 	    //! as last point update the effects as it can drop elements
+	    profiler->beginPhase(CProfiler::PHASE_EFFECTS);
 	    mainWindow->updateEffects();
+	    profiler->endPhase(CProfiler::PHASE_EFFECTS);
 
+	    profiler->beginPhase(CProfiler::PHASE_VSYNC);
 	    video->waitForVSync();
+	    profiler->endPhase(CProfiler::PHASE_VSYNC);
 
         //! transfer elements to real delete list here after all processes are finished
         //! the elements are transfered to another list to delete the elements in a separate thread
         //! and avoid blocking the GUI thread
+	    profiler->beginPhase(CProfiler::PHASE_DELETER);
         AsyncDeleter::triggerDeleteProcess();
+	    profiler->endPhase(CProfiler::PHASE_DELETER);
 	}
 
+    profilerFrame.removeAll();
+
 	fadeOut();
 
     delete mainWindow;
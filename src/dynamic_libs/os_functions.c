@@ -53,10 +53,18 @@ EXPORT_DECL(void, OSLockMutex, void* mutex);
 EXPORT_DECL(void, OSUnlockMutex, void* mutex);
 EXPORT_DECL(int, OSTryLockMutex, void* mutex);
 
+//!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//! Message queue functions
+//!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+EXPORT_DECL(void, OSInitMessageQueue, void *queue, OSMessage *messages, s32 count);
+EXPORT_DECL(int, OSSendMessage, void *queue, OSMessage *message, s32 flags);
+EXPORT_DECL(int, OSReceiveMessage, void *queue, OSMessage *message, s32 flags);
+
 //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //! System functions
 //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 EXPORT_DECL(u64, OSGetTitleID, void);
+EXPORT_DECL(s64, OSGetTime, void);
 EXPORT_DECL(void, __Exit, void);
 EXPORT_DECL(void, OSFatal, const char* msg);
 #if ((VER == 532) || (VER == 540))
@@ -109,6 +117,7 @@ void InitOSFunctionPointers(void)
     //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     OS_FIND_EXPORT(coreinit_handle, OSFatal);
     OS_FIND_EXPORT(coreinit_handle, OSGetTitleID);
+    OS_FIND_EXPORT(coreinit_handle, OSGetTime);
 #if ((VER == 532) || (VER == 540))
     OS_FIND_EXPORT(coreinit_handle, OSSetExceptionCallbackEx);
 #elif ((VER == 410) || (VER == 500))
@@ -137,6 +146,12 @@ void InitOSFunctionPointers(void)
     OS_FIND_EXPORT(coreinit_handle, OSLockMutex);
     OS_FIND_EXPORT(coreinit_handle, OSUnlockMutex);
     OS_FIND_EXPORT(coreinit_handle, OSTryLockMutex);
+    //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    //! Message queue functions
+    //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+    OS_FIND_EXPORT(coreinit_handle, OSInitMessageQueue);
+    OS_FIND_EXPORT(coreinit_handle, OSSendMessage);
+    OS_FIND_EXPORT(coreinit_handle, OSReceiveMessage);
 
     //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
     //! Memory functions
@@ -62,6 +62,16 @@ extern "C" {
                                         EXPORT_FUNC_WRITE(func_p, funcPointer);
 
 #define OS_MUTEX_SIZE                   44
+#define OS_MESSAGE_QUEUE_SIZE           64
+
+#define OS_MESSAGE_NOBLOCK              0
+#define OS_MESSAGE_BLOCK                1
+
+typedef struct
+{
+    void *message;
+    u32 args[3];
+} OSMessage;
 
 /* Handle for coreinit */
 extern unsigned int coreinit_handle;
@@ -94,10 +104,18 @@ extern void (* OSLockMutex)(void* mutex);
 extern void (* OSUnlockMutex)(void* mutex);
 extern int (* OSTryLockMutex)(void* mutex);
 
+//!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+//! Message queue functions
+//!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+extern void (* OSInitMessageQueue)(void *queue, OSMessage *messages, s32 count);
+extern int (* OSSendMessage)(void *queue, OSMessage *message, s32 flags);
+extern int (* OSReceiveMessage)(void *queue, OSMessage *message, s32 flags);
+
 //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 //! System functions
 //!----------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 extern u64 (* OSGetTitleID)(void);
+extern s64 (* OSGetTime)(void);
 extern void (* __Exit)(void);
 extern void (* OSFatal)(const char* msg);
 extern void (* DCFlushRange)(const void *addr, u32 length);
@@ -28,6 +28,22 @@ using namespace std;
 
 #define ALIGN4(x) (((x) + 3) & ~3)
 
+//! glyphs of one pixel size are packed into page textures of this size
+#define FTGX_ATLAS_PAGE_DIM         256
+//! empty texels right and below each glyph so filtering and blur do not reach the neighbours
+#define FTGX_ATLAS_PADDING          4
+//! above this number of pages per pixel size, unused pages are recycled
+#define FTGX_ATLAS_MAX_PAGES        8
+//! frames a page has to be unused before it is recycled, the GPU may still read it before that
+#define FTGX_ATLAS_EVICT_FRAMES     3
+#define FTGX_ATLAS_NO_PAGE          0xFFFF
+//! code points below this value get their metrics stored in a dense table per pixel size
+#define FTGX_METRICS_TABLE_SIZE     0x500
+//! glyph quads per frame that can be drawn, the vertex ring holds two frames
+#define FTGX_RING_QUADS             4096
+#define FTGX_QUAD_POS_FLOATS        (4 * 3)
+#define FTGX_QUAD_TEX_FLOATS        (4 * 2)
+
 /**
  * Default constructor for the FreeTypeGX class for WiiXplorer.
  */
@@ -35,6 +51,13 @@ FreeTypeGX::FreeTypeGX(const uint8_t* fontBuffer, FT_Long bufferSize, bool lastF
 {
 	int faceIndex = 0;
 	ftPointSize = 0;
+	frameCount = 0;
+	atlasGeneration = 0;
+	ringPosVtxs = NULL;
+	ringTexCoords = NULL;
+	ringFrame = 0;
+	ringFrameIdx = 0;
+	ringUsed = 0;
     GX2InitSampler(&ftSampler, GX2_TEX_CLAMP_CLAMP_BORDER, GX2_TEX_XY_FILTER_BILINEAR);
 
 	FT_Init_FreeType(&ftLibrary);
@@ -56,6 +79,10 @@ FreeTypeGX::FreeTypeGX(const uint8_t* fontBuffer, FT_Long bufferSize, bool lastF
 FreeTypeGX::~FreeTypeGX()
 {
 	unloadFont();
+	if(ringPosVtxs)
+		free(ringPosVtxs);
+	if(ringTexCoords)
+		free(ringTexCoords);
 	FT_Done_Face(ftFace);
 	FT_Done_FreeType(ftLibrary);
 }
@@ -154,24 +181,18 @@ char *FreeTypeGX::wideCharToUTF8(const wchar_t* strChar)
 void FreeTypeGX::unloadFont()
 {
 	map<int16_t, ftGX2Data >::iterator itr;
-	map<wchar_t, ftgxCharData>::iterator itr2;
 
 	for (itr = fontData.begin(); itr != fontData.end(); itr++)
 	{
-		for (itr2 = itr->second.ftgxCharMap.begin(); itr2 != itr->second.ftgxCharMap.end(); itr2++)
-        {
-            if(itr2->second.texture)
-            {
-                if(itr2->second.texture->surface.image_data)
-                    free(itr2->second.texture->surface.image_data);
-
-                delete itr2->second.texture;
-                itr2->second.texture = NULL;
-            }
-        }
+		for (uint32_t i = 0; i < itr->second.atlasPages.size(); i++)
+		{
+			free(itr->second.atlasPages[i].texture->surface.image_data);
+			delete itr->second.atlasPages[i].texture;
+		}
 	}
 
 	fontData.clear();
+	atlasGeneration++;
 }
 
 /**
@@ -224,6 +245,7 @@ ftgxCharData * FreeTypeGX::cacheGlyphData(wchar_t charCode, int16_t pixelSize)
 				textureHeight = 4;
 
             ftgxCharData *charData = &ftData->ftgxCharMap[charCode];
+			charData->atlasPage = FTGX_ATLAS_NO_PAGE;
 			charData->renderOffsetX = (int16_t) ftFace->glyph->bitmap_left;
 			charData->glyphAdvanceX = (uint16_t) (ftFace->glyph->advance.x >> 6);
 			charData->glyphAdvanceY = (uint16_t) (ftFace->glyph->advance.y >> 6);
@@ -231,10 +253,14 @@ ftgxCharData * FreeTypeGX::cacheGlyphData(wchar_t charCode, int16_t pixelSize)
 			charData->renderOffsetY = (int16_t) ftFace->glyph->bitmap_top;
 			charData->renderOffsetMax = (int16_t) ftFace->glyph->bitmap_top;
 			charData->renderOffsetMin = (int16_t) glyphBitmap->rows - ftFace->glyph->bitmap_top;
+			charData->textureWidth = textureWidth;
+			charData->textureHeight = textureHeight;
 
-            //! Initialize texture
-            charData->texture = new GX2Texture;
-            GX2InitTexture(charData->texture, textureWidth,  textureHeight, 1, 0, GX2_SURFACE_FORMAT_TC_R5_G5_B5_A1_UNORM, GX2_SURFACE_DIM_2D, GX2_TILE_MODE_LINEAR_ALIGNED);
+			if(!allocGlyphRect(ftData, charData))
+			{
+				ftData->ftgxCharMap.erase(charCode);
+				return NULL;
+			}
 
 			loadGlyphData(glyphBitmap, charData);
 
@@ -265,10 +291,10 @@ uint16_t FreeTypeGX::cacheGlyphDataComplete(int16_t pixelSize)
 }
 
 /**
- * Loads the rendered bitmap into the relevant structure's data buffer.
+ * Loads the rendered bitmap into the glyph's rectangle of its atlas page.
  *
- * This routine does a simple byte-wise copy of the glyph's rendered 8-bit grayscale bitmap into the structure's buffer.
- * Each byte is converted from the bitmap's intensity value into the a uint32_t RGBA value.
+ * This routine does a simple byte-wise copy of the glyph's rendered 8-bit grayscale bitmap into the page texture.
+ * Each byte is converted from the bitmap's intensity value into a R5G5B5A1 value. The padding around the glyph is cleared.
  *
  * @param bmp   A pointer to the most recently rendered glyph's bitmap.
  * @param charData  A pointer to an allocated ftgxCharData structure whose data represent that of the last rendered glyph.
@@ -276,14 +302,20 @@ uint16_t FreeTypeGX::cacheGlyphDataComplete(int16_t pixelSize)
 
 void FreeTypeGX::loadGlyphData(FT_Bitmap *bmp, ftgxCharData *charData)
 {
-	charData->texture->surface.image_data = (uint8_t *) memalign(charData->texture->surface.align, charData->texture->surface.image_size);
-	if(!charData->texture->surface.image_data)
-        return;
-
-	memset(charData->texture->surface.image_data, 0x00, charData->texture->surface.image_size);
+	GX2Texture *texture = fontData[ftPointSize].atlasPages[charData->atlasPage].texture;
+	uint32_t pitch = texture->surface.pitch;
+	uint32_t rows = charData->textureHeight + FTGX_ATLAS_PADDING;
+	if(charData->atlasY + rows > texture->surface.height)
+		rows = texture->surface.height - charData->atlasY;
+	uint32_t cols = charData->textureWidth + FTGX_ATLAS_PADDING;
+	if(charData->atlasX + cols > texture->surface.width)
+		cols = texture->surface.width - charData->atlasX;
+
+	uint16_t *cell = (uint16_t *)texture->surface.image_data + charData->atlasY * pitch + charData->atlasX;
+	for(uint32_t y = 0; y < rows; y++)
+		memset(cell + y * pitch, 0x00, cols * sizeof(uint16_t));
 
 	uint8_t *src = (uint8_t *)bmp->buffer;
-	uint16_t *dst = (uint16_t *)charData->texture->surface.image_data;
 	int32_t x, y;
 
 	for(y = 0; y < bmp->rows; y++)
@@ -291,10 +323,145 @@ void FreeTypeGX::loadGlyphData(FT_Bitmap *bmp, ftgxCharData *charData)
 		for(x = 0; x < bmp->width; x++)
 		{
 		    uint8_t intensity = src[y * bmp->width + x] >> 3;
-            dst[y * charData->texture->surface.pitch + x] = intensity ? ((intensity << 11) | (intensity << 6) | (intensity << 1) | 1) : 0;
+            cell[y * pitch + x] = intensity ? ((intensity << 11) | (intensity << 6) | (intensity << 1) | 1) : 0;
+		}
+	}
+    GX2Invalidate(GX2_INVALIDATE_CPU_TEXTURE, cell, ((rows - 1) * pitch + cols) * sizeof(uint16_t));
+    CProfiler::instance()->count(CProfiler::COUNTER_INVALIDATES);
+}
+
+/**
+ * Reserves the rectangle of a glyph on the current shelf of a page or on a new shelf below it.
+ *
+ * @param atlasPage The page to place the glyph in.
+ * @param charData  The glyph with its texture size set.
+ * @return true if the glyph fits into the page.
+ */
+bool FreeTypeGX::packGlyphRect(ftgxAtlasPage *atlasPage, ftgxCharData *charData)
+{
+	uint32_t width = charData->textureWidth + FTGX_ATLAS_PADDING;
+	uint32_t height = charData->textureHeight + FTGX_ATLAS_PADDING;
+	uint32_t pageWidth = atlasPage->texture->surface.width;
+	uint32_t pageHeight = atlasPage->texture->surface.height;
+
+	if(charData->textureWidth > pageWidth)
+		return false;
+
+	//! start a new shelf if the current one is full
+	if(atlasPage->shelfX + charData->textureWidth > pageWidth)
+	{
+		atlasPage->shelfY += atlasPage->shelfHeight;
+		atlasPage->shelfX = 0;
+		atlasPage->shelfHeight = 0;
+	}
+
+	if(atlasPage->shelfY + charData->textureHeight > pageHeight)
+		return false;
+
+	charData->atlasX = atlasPage->shelfX;
+	charData->atlasY = atlasPage->shelfY;
+	atlasPage->shelfX += width;
+	if(height > atlasPage->shelfHeight)
+		atlasPage->shelfHeight = height;
+	return true;
+}
+
+/**
+ * Places a glyph in one of the atlas pages of its pixel size.
+ *
+ * Glyphs are packed into shared page textures and addressed by their rectangle in the page.
+ * If all pages are full, the page that was not drawn from for the longest time is recycled.
+ *
+ * @param ftData    The font data of the glyph's pixel size.
+ * @param charData  The glyph with its texture size set.
+ * @return true if the glyph got a rectangle.
+ */
+bool FreeTypeGX::allocGlyphRect(ftGX2Data *ftData, ftgxCharData *charData)
+{
+	for(uint32_t i = 0; i < ftData->atlasPages.size(); i++)
+	{
+		if(packGlyphRect(&ftData->atlasPages[i], charData))
+		{
+			charData->atlasPage = i;
+			ftData->atlasPages[i].lastFrame = frameCount;
+			return true;
+		}
+	}
+
+	int32_t page = -1;
+
+	if(ftData->atlasPages.size() >= FTGX_ATLAS_MAX_PAGES)
+	{
+		//! recycle the least recently drawn page which is large enough
+		for(uint32_t i = 0; i < ftData->atlasPages.size(); i++)
+		{
+			const ftgxAtlasPage & atlasPage = ftData->atlasPages[i];
+			if(atlasPage.texture->surface.width < charData->textureWidth || atlasPage.texture->surface.height < charData->textureHeight
+			   || (atlasPage.lastFrame + FTGX_ATLAS_EVICT_FRAMES) > frameCount)
+				continue;
+
+			if(page < 0 || atlasPage.lastFrame < ftData->atlasPages[page].lastFrame)
+				page = i;
 		}
+
+		if(page >= 0)
+			evictAtlasPage(ftData, page);
+	}
+
+	if(page < 0)
+	{
+		//! glyphs larger than a page get a page of their own size
+		uint32_t width = (charData->textureWidth > FTGX_ATLAS_PAGE_DIM) ? charData->textureWidth : FTGX_ATLAS_PAGE_DIM;
+		uint32_t height = (charData->textureHeight > FTGX_ATLAS_PAGE_DIM) ? charData->textureHeight : FTGX_ATLAS_PAGE_DIM;
+
+		ftgxAtlasPage atlasPage;
+		atlasPage.texture = new GX2Texture;
+		GX2InitTexture(atlasPage.texture, width, height, 1, 0, GX2_SURFACE_FORMAT_TC_R5_G5_B5_A1_UNORM, GX2_SURFACE_DIM_2D, GX2_TILE_MODE_LINEAR_ALIGNED);
+		atlasPage.texture->surface.image_data = memalign(atlasPage.texture->surface.align, atlasPage.texture->surface.image_size);
+		if(!atlasPage.texture->surface.image_data)
+		{
+			delete atlasPage.texture;
+			return false;
+		}
+		atlasPage.shelfX = 0;
+		atlasPage.shelfY = 0;
+		atlasPage.shelfHeight = 0;
+		atlasPage.lastFrame = frameCount;
+
+		page = ftData->atlasPages.size();
+		ftData->atlasPages.push_back(atlasPage);
+	}
+
+	ftgxAtlasPage & atlasPage = ftData->atlasPages[page];
+	if(!packGlyphRect(&atlasPage, charData))
+		return false;
+
+	charData->atlasPage = page;
+	atlasPage.lastFrame = frameCount;
+	return true;
+}
+
+/**
+ * Removes all glyphs stored in an atlas page and makes the page available again.
+ *
+ * @param ftData    The font data of the page's pixel size.
+ * @param page      Index of the page.
+ */
+void FreeTypeGX::evictAtlasPage(ftGX2Data *ftData, uint16_t page)
+{
+	map<wchar_t, ftgxCharData>::iterator itr = ftData->ftgxCharMap.begin();
+	while (itr != ftData->ftgxCharMap.end())
+	{
+		if(itr->second.atlasPage == page)
+			ftData->ftgxCharMap.erase(itr++);
+		else
+			++itr;
 	}
-    GX2Invalidate(GX2_INVALIDATE_CPU_TEXTURE, charData->texture->surface.image_data, charData->texture->surface.image_size);
+
+	ftData->atlasPages[page].shelfX = 0;
+	ftData->atlasPages[page].shelfY = 0;
+	ftData->atlasPages[page].shelfHeight = 0;
+	atlasGeneration++;
 }
 
 /**
@@ -358,8 +525,7 @@ int16_t FreeTypeGX::getStyleOffsetHeight(int16_t format, uint16_t pixelSize)
 /**
  * Processes the supplied text string and prints the results at the specified coordinates.
  *
- * This routine processes each character of the supplied text string, loads the relevant preprocessed bitmap buffer,
- * a texture from said buffer, and loads the resultant texture into the EFB.
+ * This routine lays out the supplied text string with layoutText() and draws the resulting glyph quads.
  *
  * @param x Screen X coordinate at which to output the text.
  * @param y Screen Y coordinate at which to output the text. Note that this value corresponds to the text string origin and not the top or bottom of the glyphs.
@@ -374,10 +540,36 @@ uint16_t FreeTypeGX::drawText(CVideo *video, int16_t x, int16_t y, int16_t z, co
 	if (!text)
         return 0;
 
+	textQuads.clear();
+	uint16_t printed = layoutText(textQuads, 0, 0, text, pixelSize, textStyle, textWidth);
+
+	drawGlyphQuads(video, x, y, z, textQuads, pixelSize, color, textBlur, colorBlurIntensity, blurColor);
+
+	return printed;
+}
+
+/**
+ * Lays out the supplied text string without drawing it.
+ *
+ * This routine caches every glyph of the string and appends one quad per glyph to the supplied list.
+ * The quads can be drawn with drawGlyphQuads() as long as getAtlasGeneration() returns the same value.
+ *
+ * @param quads Glyph quad list to append to.
+ * @param x X offset of the string origin.
+ * @param y Y offset of the string origin.
+ * @param text  NULL terminated string to lay out.
+ * @param textStyle Flags which specify any styling which should be applied to the string.
+ * @return The number of characters placed.
+ */
+uint16_t FreeTypeGX::layoutText(std::vector<ftgxGlyphQuad> & quads, int16_t x, int16_t y, const wchar_t *text, int16_t pixelSize, uint16_t textStyle, uint16_t textWidth)
+{
+	if (!text)
+        return 0;
+
 	uint16_t fullTextWidth = (textWidth > 0) ? textWidth : getWidth(text, pixelSize);
 	uint16_t x_pos = x, printed = 0;
 	uint16_t x_offset = 0, y_offset = 0;
-	FT_Vector pairDelta;
+	ftGX2Data *ftData = &fontData[pixelSize];
 
 	if (textStyle & FTGX_JUSTIFY_MASK)
 	{
@@ -389,6 +581,7 @@ uint16_t FreeTypeGX::drawText(CVideo *video, int16_t x, int16_t y, int16_t z, co
 	}
 
 	int i = 0;
+	uint32_t prevGlyphIndex = 0;
 
 	while (text[i])
 	{
@@ -396,23 +589,207 @@ uint16_t FreeTypeGX::drawText(CVideo *video, int16_t x, int16_t y, int16_t z, co
 
 		if (glyphData != NULL)
 		{
-			if (ftKerningEnabled && i > 0)
-			{
-				FT_Get_Kerning(ftFace, fontData[pixelSize].ftgxCharMap[text[i - 1]].glyphIndex, glyphData->glyphIndex, FT_KERNING_DEFAULT, &pairDelta);
-				x_pos += (pairDelta.x >> 6);
-			}
-
-			copyTextureToFramebuffer(video, glyphData->texture, x_pos + glyphData->renderOffsetX + x_offset, y + glyphData->renderOffsetY - y_offset, z, color, textBlur, colorBlurIntensity, blurColor);
+			if (i > 0)
+				x_pos += getKerning(ftData, pixelSize, prevGlyphIndex, glyphData->glyphIndex);
+
+			//! keep the page from being recycled while the rest of the string is cached
+			ftData->atlasPages[glyphData->atlasPage].lastFrame = frameCount;
+
+			ftgxGlyphQuad quad;
+			quad.atlasPage = glyphData->atlasPage;
+			quad.atlasX = glyphData->atlasX;
+			quad.atlasY = glyphData->atlasY;
+			quad.width = glyphData->textureWidth;
+			quad.height = glyphData->textureHeight;
+			quad.x = x_pos + glyphData->renderOffsetX + x_offset;
+			quad.y = y + glyphData->renderOffsetY - y_offset;
+			quads.push_back(quad);
 
 			x_pos += glyphData->glyphAdvanceX;
+			prevGlyphIndex = glyphData->glyphIndex;
 			++printed;
 		}
+		else
+		{
+			prevGlyphIndex = 0;
+		}
 		++i;
 	}
 
 	return printed;
 }
 
+/**
+ * Draws glyph quads returned by layoutText().
+ *
+ * The vertices of all glyphs are written once into the vertex ring, grouped by atlas page. Every blur pass then
+ * draws each page of the string with a single draw call, for the usual one page strings that is one draw per pass.
+ *
+ * @param x Screen X coordinate of the string origin.
+ * @param y Screen Y coordinate of the string origin.
+ * @param quads Glyph quads of the string.
+ * @param pixelSize Pixel size the quads were laid out with.
+ */
+void FreeTypeGX::drawGlyphQuads(CVideo *video, int16_t x, int16_t y, int16_t z, const std::vector<ftgxGlyphQuad> & quads, int16_t pixelSize, const glm::vec4 & color, const float &textBlur, const float &colorBlurIntensity, const glm::vec4 & blurColor)
+{
+	if (quads.empty())
+        return;
+
+	frameCount = video->getFrameCount();
+
+	if(!ringPosVtxs)
+	{
+		//! two frames worth of quads, one for the CPU and one that the GPU may still read
+		ringPosVtxs = (f32 *) memalign(GX2_VERTEX_BUFFER_ALIGNMENT, 2 * FTGX_RING_QUADS * FTGX_QUAD_POS_FLOATS * sizeof(f32));
+		ringTexCoords = (f32 *) memalign(GX2_VERTEX_BUFFER_ALIGNMENT, 2 * FTGX_RING_QUADS * FTGX_QUAD_TEX_FLOATS * sizeof(f32));
+		if(!ringPosVtxs || !ringTexCoords)
+			return;
+	}
+
+	if(ringFrame != frameCount)
+	{
+		ringFrame = frameCount;
+		ringFrameIdx ^= 1;
+		ringUsed = 0;
+	}
+
+	//! draw the start of the string that still fits into the ring and count the rest
+	uint32_t quadCount = quads.size();
+	if(ringUsed + quadCount > FTGX_RING_QUADS)
+	{
+		quadCount = FTGX_RING_QUADS - ringUsed;
+		CProfiler::instance()->count(CProfiler::COUNTER_GLYPHS_DROPPED, quads.size() - quadCount);
+		if(quadCount == 0)
+			return;
+	}
+
+	ftGX2Data *ftData = &fontData[pixelSize];
+
+	//! count the quads per page, strings rarely span more than one
+	pageRuns.clear();
+	for (uint32_t i = 0; i < quadCount; i++)
+	{
+		uint32_t n = 0;
+		while (n < pageRuns.size() && pageRuns[n].page != quads[i].atlasPage)
+			n++;
+
+		if (n == pageRuns.size())
+		{
+			ftgxPageRun run;
+			run.page = quads[i].atlasPage;
+			run.first = 0;
+			run.count = 0;
+			pageRuns.push_back(run);
+		}
+		pageRuns[n].count++;
+	}
+
+	uint32_t first = ringUsed;
+	for (uint32_t n = 0; n < pageRuns.size(); n++)
+	{
+		pageRuns[n].first = first;
+		first += pageRuns[n].count;
+		pageRuns[n].count = 0;
+
+		//! keep the pages from being recycled while the GPU still draws from them
+		ftData->atlasPages[pageRuns[n].page].lastFrame = frameCount;
+	}
+
+	//! blur doubles  due to blur we have to scale the texture
+	static const f32 blurScale = 2.0f;
+	const f32 widthScale = video->getWidthScaleFactor();
+	const f32 heightScale = video->getHeightScaleFactor();
+	const uint32_t ringBase = ringFrameIdx * FTGX_RING_QUADS;
+
+	for (uint32_t i = 0; i < quadCount; i++)
+	{
+		const ftgxGlyphQuad & quad = quads[i];
+
+		uint32_t n = 0;
+		while (pageRuns[n].page != quad.atlasPage)
+			n++;
+
+		uint32_t quadIdx = ringBase + pageRuns[n].first + pageRuns[n].count++;
+		f32 *pos = ringPosVtxs + quadIdx * FTGX_QUAD_POS_FLOATS;
+		f32 *tc = ringTexCoords + quadIdx * FTGX_QUAD_TEX_FLOATS;
+
+		//! same quad as the default one of the Texture2DShader with offset and scale applied
+		f32 centerX = 2.0f * ((f32)(x + quad.x) + 0.5f * (f32)quad.width) * widthScale;
+		f32 centerY = 2.0f * ((f32)(y + quad.y) - 0.5f * (f32)quad.height) * heightScale;
+		f32 halfWidth = blurScale * (f32)quad.width * widthScale;
+		f32 halfHeight = blurScale * (f32)quad.height * heightScale;
+
+		f32 left = centerX - halfWidth;
+		f32 right = centerX + halfWidth;
+		f32 bottom = centerY - halfHeight;
+		f32 top = centerY + halfHeight;
+
+		pos[0] = left;  pos[1] = bottom; pos[2] = (f32)z;
+		pos[3] = right; pos[4] = bottom; pos[5] = (f32)z;
+		pos[6] = right; pos[7] = top;    pos[8] = (f32)z;
+		pos[9] = left;  pos[10] = top;   pos[11] = (f32)z;
+
+		const GX2Texture *texture = ftData->atlasPages[quad.atlasPage].texture;
+		f32 u0 = (f32)quad.atlasX / (f32)texture->surface.width;
+		f32 u1 = (f32)(quad.atlasX + quad.width) / (f32)texture->surface.width;
+		f32 v0 = (f32)quad.atlasY / (f32)texture->surface.height;
+		f32 v1 = (f32)(quad.atlasY + quad.height) / (f32)texture->surface.height;
+
+		tc[0] = u0; tc[1] = v1;
+		tc[2] = u1; tc[3] = v1;
+		tc[4] = u1; tc[5] = v0;
+		tc[6] = u0; tc[7] = v0;
+	}
+
+	GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, ringPosVtxs + (ringBase + ringUsed) * FTGX_QUAD_POS_FLOATS, quadCount * FTGX_QUAD_POS_FLOATS * sizeof(f32));
+	GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, ringTexCoords + (ringBase + ringUsed) * FTGX_QUAD_TEX_FLOATS, quadCount * FTGX_QUAD_TEX_FLOATS * sizeof(f32));
+	CProfiler::instance()->count(CProfiler::COUNTER_INVALIDATES, 2);
+	ringUsed += quadCount;
+
+	//! the vertices are already transformed
+    Texture2DShader::instance()->setShaders();
+    Texture2DShader::instance()->setAttributeBuffer(ringTexCoords + ringBase * FTGX_QUAD_TEX_FLOATS, ringPosVtxs + ringBase * FTGX_QUAD_POS_FLOATS, FTGX_RING_QUADS * 4);
+    Texture2DShader::instance()->setAngle(0.0f);
+    Texture2DShader::instance()->setOffset(glm::vec3(0.0f));
+    Texture2DShader::instance()->setScale(glm::vec3(1.0f));
+    Texture2DShader::instance()->setTextureAndSampler(ftData->atlasPages[pageRuns[0].page].texture, &ftSampler);
+
+    if(colorBlurIntensity > 0.0f)
+    {
+        //! glow blur color
+        drawGlyphPass(ftData, blurColor, colorBlurIntensity);
+    }
+
+    //! text color
+    drawGlyphPass(ftData, color, textBlur);
+}
+
+/**
+ * Draws the horizontal and vertical blur pass of a string, one draw per atlas page and pass.
+ */
+void FreeTypeGX::drawGlyphPass(ftGX2Data *ftData, const glm::vec4 & color, const float & blur)
+{
+    glm::vec3 blurDirection;
+    blurDirection[2] = 1.0f;
+
+    Texture2DShader::instance()->setColorIntensity(color);
+
+    for(int pass = 0; pass < 2; pass++)
+    {
+        //! horizontal then vertical blur
+        blurDirection[0] = (pass == 0) ? blur : 0.0f;
+        blurDirection[1] = (pass == 0) ? 0.0f : blur;
+        Texture2DShader::instance()->setBlurring(blurDirection);
+
+        for(uint32_t n = 0; n < pageRuns.size(); n++)
+        {
+            Texture2DShader::instance()->setTexture(ftData->atlasPages[pageRuns[n].page].texture);
+
+            CProfiler::instance()->count(CProfiler::COUNTER_DRAWS);
+            GX2DrawEx(GX2_PRIMITIVE_QUADS, pageRuns[n].count * 4, pageRuns[n].first * 4, 1);
+        }
+    }
+}
 
 /**
  * Processes the supplied string and return the width of the string in pixels.
@@ -427,24 +804,23 @@ uint16_t FreeTypeGX::getWidth(const wchar_t *text, int16_t pixelSize)
 {
 	if (!text) return 0;
 
+	ftGX2Data *ftData = &fontData[pixelSize];
 	uint16_t strWidth = 0;
-	FT_Vector pairDelta;
 
 	int i = 0;
+	uint32_t prevGlyphIndex = 0;
 	while (text[i])
 	{
-		ftgxCharData* glyphData = cacheGlyphData(text[i], pixelSize);
+		ftgxGlyphMetrics metrics = getGlyphMetrics(ftData, text[i], pixelSize);
 
-		if (glyphData != NULL)
+		if (metrics.glyphIndex != 0)
 		{
-			if (ftKerningEnabled && (i > 0))
-			{
-				FT_Get_Kerning(ftFace, fontData[pixelSize].ftgxCharMap[text[i - 1]].glyphIndex, glyphData->glyphIndex, FT_KERNING_DEFAULT, &pairDelta);
-				strWidth += pairDelta.x >> 6;
-			}
+			if (i > 0)
+				strWidth += getKerning(ftData, pixelSize, prevGlyphIndex, metrics.glyphIndex);
 
-			strWidth += glyphData->glyphAdvanceX;
+			strWidth += metrics.glyphAdvanceX;
 		}
+		prevGlyphIndex = metrics.glyphIndex;
 		++i;
 	}
 	return strWidth;
@@ -455,23 +831,106 @@ uint16_t FreeTypeGX::getWidth(const wchar_t *text, int16_t pixelSize)
  */
 uint16_t FreeTypeGX::getCharWidth(const wchar_t wChar, int16_t pixelSize, const wchar_t prevChar)
 {
+	ftGX2Data *ftData = &fontData[pixelSize];
 	uint16_t strWidth = 0;
-	ftgxCharData * glyphData = cacheGlyphData(wChar, pixelSize);
+	ftgxGlyphMetrics metrics = getGlyphMetrics(ftData, wChar, pixelSize);
 
-	if (glyphData != NULL)
+	if (metrics.glyphIndex != 0)
 	{
 		if (ftKerningEnabled && prevChar != 0x0000)
 		{
-			FT_Vector pairDelta;
-			FT_Get_Kerning(ftFace, fontData[pixelSize].ftgxCharMap[prevChar].glyphIndex, glyphData->glyphIndex, FT_KERNING_DEFAULT, &pairDelta);
-			strWidth += pairDelta.x >> 6;
+			ftgxGlyphMetrics prevMetrics = getGlyphMetrics(ftData, prevChar, pixelSize);
+			strWidth += getKerning(ftData, pixelSize, prevMetrics.glyphIndex, metrics.glyphIndex);
 		}
-		strWidth += glyphData->glyphAdvanceX;
+		strWidth += metrics.glyphAdvanceX;
 	}
 
 	return strWidth;
 }
 
+/**
+ * Returns the horizontal metrics of a glyph.
+ *
+ * Metrics of code points below FTGX_METRICS_TABLE_SIZE are kept in a dense table of the pixel size and stay
+ * valid when the glyph texture is removed from the atlas. All other code points are looked up in the glyph cache.
+ *
+ * @param ftData    The font data of the pixel size.
+ * @param charCode  The requested glyph's character code.
+ * @return The glyph metrics, glyphIndex is 0 if the glyph is not available.
+ */
+ftgxGlyphMetrics FreeTypeGX::getGlyphMetrics(ftGX2Data *ftData, wchar_t charCode, int16_t pixelSize)
+{
+	ftgxGlyphMetrics metrics;
+
+	if ((uint32_t)charCode < FTGX_METRICS_TABLE_SIZE)
+	{
+		if (ftData->metricsTable.empty())
+			ftData->metricsTable.resize(FTGX_METRICS_TABLE_SIZE);
+
+		if (ftData->metricsTable[charCode].cached)
+			return ftData->metricsTable[charCode];
+	}
+
+	ftgxCharData *glyphData = cacheGlyphData(charCode, pixelSize);
+	if (glyphData == NULL)
+	{
+		metrics.glyphIndex = 0;
+		metrics.glyphAdvanceX = 0;
+		metrics.cached = 0;
+		return metrics;
+	}
+
+	metrics.glyphIndex = glyphData->glyphIndex;
+	metrics.glyphAdvanceX = glyphData->glyphAdvanceX;
+	metrics.cached = 1;
+
+	if ((uint32_t)charCode < FTGX_METRICS_TABLE_SIZE)
+		ftData->metricsTable[charCode] = metrics;
+
+	return metrics;
+}
+
+/**
+ * Returns the kerning between two glyphs in pixels.
+ *
+ * The value is queried from FreeType once per glyph pair and pixel size and kept in a hash table afterwards.
+ *
+ * @param ftData    The font data of the pixel size.
+ * @param leftGlyphIndex    Glyph index of the left glyph.
+ * @param rightGlyphIndex   Glyph index of the right glyph.
+ */
+int16_t FreeTypeGX::getKerning(ftGX2Data *ftData, int16_t pixelSize, uint32_t leftGlyphIndex, uint32_t rightGlyphIndex)
+{
+	if (!ftKerningEnabled || leftGlyphIndex == 0 || rightGlyphIndex == 0)
+		return 0;
+
+	bool storeable = (leftGlyphIndex <= 0xFFFF) && (rightGlyphIndex <= 0xFFFF);
+	uint32_t key = (leftGlyphIndex << 16) | (rightGlyphIndex & 0xFFFF);
+
+	if (storeable)
+	{
+		std::unordered_map<uint32_t, int16_t>::iterator itr = ftData->kerningTable.find(key);
+		if (itr != ftData->kerningTable.end())
+			return itr->second;
+	}
+
+	//! kerning is scaled to the current face size
+	if (ftPointSize != pixelSize)
+	{
+		ftPointSize = pixelSize;
+		FT_Set_Pixel_Sizes(ftFace, 0, ftPointSize);
+	}
+
+	FT_Vector pairDelta;
+	FT_Get_Kerning(ftFace, leftGlyphIndex, rightGlyphIndex, FT_KERNING_DEFAULT, &pairDelta);
+	int16_t kerning = pairDelta.x >> 6;
+
+	if (storeable)
+		ftData->kerningTable[key] = kerning;
+
+	return kerning;
+}
+
 /**
  * Processes the supplied string and return the height of the string in pixels.
  *
@@ -534,75 +993,3 @@ void FreeTypeGX::getOffset(const wchar_t *text, int16_t pixelSize, uint16_t widt
 	fontData[pixelSize].ftgxAlign.max = strMax;
 	fontData[pixelSize].ftgxAlign.min = strMin;
 }
-
-/**
- * Copies the supplied texture quad to the EFB.
- *
- * This routine uses the in-built GX quad builder functions to define the texture bounds and location on the EFB target.
- *
- * @param texObj	A pointer to the glyph's initialized texture object.
- * @param texWidth  The pixel width of the texture object.
- * @param texHeight The pixel height of the texture object.
- * @param screenX   The screen X coordinate at which to output the rendered texture.
- * @param screenY   The screen Y coordinate at which to output the rendered texture.
- * @param color Color to apply to the texture.
- */
-void FreeTypeGX::copyTextureToFramebuffer(CVideo *pVideo, GX2Texture *texture, int16_t x, int16_t y, int16_t z, const glm::vec4 & color, const float & defaultBlur, const float & blurIntensity, const glm::vec4 & blurColor)
-{
-    static const f32 imageAngle = 0.0f;
-    static const f32 blurScale = 2.0f;
-
-    f32 offsetLeft = 2.0f * ((f32)x + 0.5f * (f32)texture->surface.width) * (f32)pVideo->getWidthScaleFactor();
-    f32 offsetTop = 2.0f * ((f32)y - 0.5f * (f32)texture->surface.height) * (f32)pVideo->getHeightScaleFactor();
-
-    f32 widthScale = blurScale * (f32)texture->surface.width * pVideo->getWidthScaleFactor();
-    f32 heightScale = blurScale * (f32)texture->surface.height * pVideo->getHeightScaleFactor();
-
-    glm::vec3 positionOffsets( offsetLeft, offsetTop, (f32)z );
-
-     //! blur doubles  due to blur we have to scale the texture
-    glm::vec3 scaleFactor( widthScale, heightScale, 1.0f );
-
-    glm::vec3 blurDirection;
-    blurDirection[2] = 1.0f;
-
-    Texture2DShader::instance()->setShaders();
-    Texture2DShader::instance()->setAttributeBuffer();
-    Texture2DShader::instance()->setAngle(imageAngle);
-    Texture2DShader::instance()->setOffset(positionOffsets);
-    Texture2DShader::instance()->setScale(scaleFactor);
-    Texture2DShader::instance()->setTextureAndSampler(texture, &ftSampler);
-
-    if(blurIntensity > 0.0f)
-    {
-        //! glow blur color
-        Texture2DShader::instance()->setColorIntensity(blurColor);
-
-        //! glow blur horizontal
-        blurDirection[0] = blurIntensity;
-        blurDirection[1] = 0.0f;
-        Texture2DShader::instance()->setBlurring(blurDirection);
-        Texture2DShader::instance()->draw();
-
-        //! glow blur vertical
-        blurDirection[0] = 0.0f;
-        blurDirection[1] = blurIntensity;
-        Texture2DShader::instance()->setBlurring(blurDirection);
-        Texture2DShader::instance()->draw();
-    }
-
-    //! set text color
-    Texture2DShader::instance()->setColorIntensity(color);
-
-    //! blur horizontal
-    blurDirection[0] = defaultBlur;
-    blurDirection[1] = 0.0f;
-    Texture2DShader::instance()->setBlurring(blurDirection);
-    Texture2DShader::instance()->draw();
-
-    //! blur vertical
-    blurDirection[0] = 0.0f;
-    blurDirection[1] = defaultBlur;
-    Texture2DShader::instance()->setBlurring(blurDirection);
-    Texture2DShader::instance()->draw();
-}
@@ -33,6 +33,8 @@
 #include <string.h>
 #include <wchar.h>
 #include <map>
+#include <vector>
+#include <unordered_map>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -54,7 +56,11 @@ typedef struct ftgxCharData_
     int16_t renderOffsetMax; /**< Texture Y axis bearing maximum value. */
     int16_t renderOffsetMin; /**< Texture Y axis bearing minimum value. */
 
-    GX2Texture * texture;
+    uint16_t atlasPage; /**< Index of the atlas page holding the glyph. */
+    uint16_t atlasX; /**< Left edge of the glyph in the atlas page. */
+    uint16_t atlasY; /**< Top edge of the glyph in the atlas page. */
+    uint16_t textureWidth; /**< Width of the glyph rectangle in texels. */
+    uint16_t textureHeight; /**< Height of the glyph rectangle in texels. */
 } ftgxCharData;
 
 /*! \struct ftgxDataOffset_
@@ -69,8 +75,50 @@ typedef struct ftgxDataOffset_
     int16_t min; /**< Minimum data offset. */
 } ftgxDataOffset;
 
+/*! \struct ftgxAtlasPage_
+ *
+ * Texture which holds the glyphs of one size, packed in rows (shelves).
+ */
+typedef struct ftgxAtlasPage_
+{
+    GX2Texture *texture; /**< Page texture, glyphs are addressed by their rectangle in it. */
+    uint16_t shelfX; /**< Next free column of the current shelf. */
+    uint16_t shelfY; /**< Top edge of the current shelf. */
+    uint16_t shelfHeight; /**< Height of the current shelf. */
+    uint32_t lastFrame; /**< Last frame in which a glyph of this page was drawn. */
+} ftgxAtlasPage;
+
+/*! \struct ftgxGlyphMetrics_
+ *
+ * Horizontal metrics of a glyph as used for string width calculations.
+ */
+typedef struct ftgxGlyphMetrics_
+{
+    uint32_t glyphIndex; /**< Glyph index in the face, 0 if there is no glyph. */
+    uint16_t glyphAdvanceX; /**< Glyph X axis advance in pixels. */
+    uint16_t cached; /**< Non zero once the entry is filled. */
+} ftgxGlyphMetrics;
+
+/*! \struct ftgxGlyphQuad_
+ *
+ * Placement of one glyph of a laid out string, relative to the string origin.
+ */
+typedef struct ftgxGlyphQuad_
+{
+    uint16_t atlasPage; /**< Index of the atlas page, only valid while the atlas generation is unchanged. */
+    uint16_t atlasX; /**< Left edge of the glyph in the atlas page. */
+    uint16_t atlasY; /**< Top edge of the glyph in the atlas page. */
+    uint16_t width; /**< Width of the glyph rectangle. */
+    uint16_t height; /**< Height of the glyph rectangle. */
+    int16_t x; /**< Left edge of the glyph. */
+    int16_t y; /**< Top edge of the glyph. */
+} ftgxGlyphQuad;
+
 typedef struct ftgxCharData_ ftgxCharData;
 typedef struct ftgxDataOffset_ ftgxDataOffset;
+typedef struct ftgxAtlasPage_ ftgxAtlasPage;
+typedef struct ftgxGlyphQuad_ ftgxGlyphQuad;
+typedef struct ftgxGlyphMetrics_ ftgxGlyphMetrics;
 #define _TEXT(t) L ## t /**< Unicode helper macro. */
 
 #define FTGX_NULL			   0x0000
@@ -116,12 +164,31 @@ class FreeTypeGX
 		int16_t ftPointSize; /**< Current set size of the rendered font. */
 		bool ftKerningEnabled; /**< Flag indicating the availability of font kerning data. */
 		uint8_t vertexIndex; /**< Vertex format descriptor index. */
+		uint32_t frameCount; /**< Frame count of the last draw call, used for atlas page eviction. */
+		uint32_t atlasGeneration; /**< Incremented whenever glyphs are removed from the atlas. */
+		std::vector<ftgxGlyphQuad> textQuads; /**< Layout buffer reused by drawText. */
+		f32 *ringPosVtxs; /**< Glyph vertices of this and the previous frame. */
+		f32 *ringTexCoords; /**< Glyph texture coordinates of this and the previous frame. */
+		uint32_t ringFrame; /**< Frame the vertex ring was last written in. */
+		uint32_t ringFrameIdx; /**< Half of the vertex ring used in the current frame. */
+		uint32_t ringUsed; /**< Quads of the current half already in use. */
+
+		typedef struct
+		{
+			uint16_t page;
+			uint32_t first;
+			uint32_t count;
+		} ftgxPageRun;
+		std::vector<ftgxPageRun> pageRuns; /**< Quads of a string grouped by atlas page, reused by drawGlyphQuads. */
         GX2Sampler ftSampler;
 
         typedef struct _ftGX2Data
         {
             ftgxDataOffset ftgxAlign;
             std::map<wchar_t, ftgxCharData> ftgxCharMap;
+            std::vector<ftgxAtlasPage> atlasPages;
+            std::vector<ftgxGlyphMetrics> metricsTable; /**< Metrics of the low code points, indexed by code point. */
+            std::unordered_map<uint32_t, int16_t> kerningTable; /**< Kerning in pixels by glyph index pair. */
         } ftGX2Data;
 
 		std::map<int16_t, ftGX2Data> fontData; /**< Map which holds the glyph data structures for the corresponding characters in one size. */
@@ -133,8 +200,13 @@ class FreeTypeGX
 		ftgxCharData *cacheGlyphData(wchar_t charCode, int16_t pixelSize);
 		uint16_t cacheGlyphDataComplete(int16_t pixelSize);
 		void loadGlyphData(FT_Bitmap *bmp, ftgxCharData *charData);
+		bool allocGlyphRect(ftGX2Data *ftData, ftgxCharData *charData);
+		bool packGlyphRect(ftgxAtlasPage *atlasPage, ftgxCharData *charData);
+		void evictAtlasPage(ftGX2Data *ftData, uint16_t page);
+		ftgxGlyphMetrics getGlyphMetrics(ftGX2Data *ftData, wchar_t charCode, int16_t pixelSize);
+		int16_t getKerning(ftGX2Data *ftData, int16_t pixelSize, uint32_t leftGlyphIndex, uint32_t rightGlyphIndex);
 
-		void copyTextureToFramebuffer(CVideo * pVideo, GX2Texture *tex, int16_t screenX, int16_t screenY, int16_t screenZ, const glm::vec4 & color, const float &textBlur, const float &colorBlurIntensity, const glm::vec4 & blurColor);
+		void drawGlyphPass(ftGX2Data *ftData, const glm::vec4 & color, const float & blur);
 
 	public:
 		FreeTypeGX(const uint8_t* fontBuffer, FT_Long bufferSize, bool lastFace = false);
@@ -143,6 +215,12 @@ class FreeTypeGX
 		uint16_t drawText(CVideo * pVideo, int16_t x, int16_t y, int16_t z, const wchar_t *text, int16_t pixelSize, const glm::vec4 & color,
                             uint16_t textStyling, uint16_t textWidth, const float &textBlur, const float &colorBlurIntensity, const glm::vec4 & blurColor);
 
+		uint16_t layoutText(std::vector<ftgxGlyphQuad> & quads, int16_t x, int16_t y, const wchar_t *text, int16_t pixelSize, uint16_t textStyling, uint16_t textWidth);
+		void drawGlyphQuads(CVideo * pVideo, int16_t x, int16_t y, int16_t z, const std::vector<ftgxGlyphQuad> & quads, int16_t pixelSize, const glm::vec4 & color,
+                            const float &textBlur, const float &colorBlurIntensity, const glm::vec4 & blurColor);
+		uint32_t getAtlasGeneration() const { return atlasGeneration; }
+		void setFrameCount(uint32_t frame) { frameCount = frame; } /**< Frame the following layouts are drawn in, set before laying out. */
+
 		uint16_t getWidth(const wchar_t *text, int16_t pixelSize);
 		uint16_t getCharWidth(const wchar_t wChar, int16_t pixelSize, const wchar_t prevChar = 0x0000);
 		uint16_t getHeight(const wchar_t *text, int16_t pixelSize);
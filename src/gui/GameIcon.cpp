@@ -8,6 +8,15 @@
 static const f32 cfIconMirrorScale = 1.15f;
 static const f32 cfIconMirrorAlpha = 0.45f;
 
+u32 GameIcon::modelRefCounter = 0;
+CMutex * GameIcon::modelMutex = NULL;
+f32 * GameIcon::modelPosVtxs = NULL;
+f32 * GameIcon::modelTexCoords = NULL;
+f32 * GameIcon::modelTexCoordsMirror = NULL;
+f32 * GameIcon::strokePosVtxs = NULL;
+f32 * GameIcon::strokeTexCoords = NULL;
+u8 * GameIcon::strokeColorVtxs = NULL;
+
 GameIcon::GameIcon(const std::string & filename, GuiImageData *preloadImage)
     : GuiImageAsync(filename, preloadImage)
 {
@@ -32,34 +41,68 @@ GameIcon::GameIcon(const std::string & filename, GuiImageData *preloadImage)
     selectionBlurInnerSize = 1.45f;
     selectionBlurInnerBorderSize = 0.95f;
 
+    modelInit();
+
     vtxCount = sizeof(cfGameIconPosVtxs) / (Shader3D::cuVertexAttrSize);
+    posVtxs = modelPosVtxs;
+    texCoords = modelTexCoords;
+}
+
+GameIcon::~GameIcon()
+{
+    //! remove image so it can not be drawn anymore from this point on
+    imageData = NULL;
+
+    //! vertexes are shared and owned by the model
+    posVtxs = NULL;
+    texCoords = NULL;
+
+    modelExit();
+}
+
+void GameIcon::modelInit(void)
+{
+    //! icons are only created on the GUI thread, so the mutex is created before any icon can be deleted
+    //! it is kept for the process lifetime as the deleter thread may still wait on it
+    if(!modelMutex)
+        modelMutex = new CMutex();
+
+    modelMutex->lock();
+
+    ++modelRefCounter;
+
+    if(modelRefCounter > 1)
+    {
+        modelMutex->unlock();
+        return;
+    }
 
     //! texture and vertex coordinates
-    posVtxs = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, sizeof(cfGameIconPosVtxs));
-    texCoords = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, sizeof(cfGameIconTexCoords));
+    modelPosVtxs = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, sizeof(cfGameIconPosVtxs));
+    modelTexCoords = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, sizeof(cfGameIconTexCoords));
 
-    if(posVtxs)
+    if(modelPosVtxs)
     {
-        memcpy((f32*)posVtxs, cfGameIconPosVtxs, sizeof(cfGameIconPosVtxs));
-        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, (f32*)posVtxs, sizeof(cfGameIconPosVtxs));
+        memcpy(modelPosVtxs, cfGameIconPosVtxs, sizeof(cfGameIconPosVtxs));
+        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, modelPosVtxs, sizeof(cfGameIconPosVtxs));
     }
-    if(texCoords)
+    if(modelTexCoords)
     {
-        memcpy((f32*)texCoords, cfGameIconTexCoords, sizeof(cfGameIconTexCoords));
-        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, (f32*)texCoords, sizeof(cfGameIconTexCoords));
+        memcpy(modelTexCoords, cfGameIconTexCoords, sizeof(cfGameIconTexCoords));
+        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, modelTexCoords, sizeof(cfGameIconTexCoords));
     }
 
     //! create vertexes for the mirror frame
-    texCoordsMirror = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, sizeof(cfGameIconTexCoords));
+    modelTexCoordsMirror = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, sizeof(cfGameIconTexCoords));
 
-    if(texCoordsMirror)
+    if(modelTexCoordsMirror)
     {
-        for(u32 i = 0; i < vtxCount; i++)
+        u32 texCoordCount = sizeof(cfGameIconTexCoords) / sizeof(f32);
+        for(u32 i = 0; i < texCoordCount; i++)
         {
-            texCoordsMirror[i*2 + 0] = texCoords[i*2 + 0] * cfIconMirrorScale - ((cfIconMirrorScale - 1.0f) - (cfIconMirrorScale - 1.0f) * 0.5f);
-            texCoordsMirror[i*2 + 1] = texCoords[i*2 + 1] * cfIconMirrorScale - ((cfIconMirrorScale - 1.0f) - (cfIconMirrorScale - 1.0f) * 0.5f);
+            modelTexCoordsMirror[i] = cfGameIconTexCoords[i] * cfIconMirrorScale - ((cfIconMirrorScale - 1.0f) - (cfIconMirrorScale - 1.0f) * 0.5f);
         }
-        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, texCoordsMirror, sizeof(cfGameIconTexCoords));
+        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, modelTexCoordsMirror, sizeof(cfGameIconTexCoords));
     }
 
     //! setup stroke of the icon
@@ -74,8 +117,8 @@ GameIcon::GameIcon(const std::string & filename, GuiImageData *preloadImage)
     {
         for(size_t i = 0, n = 0; i < cuGameIconStrokeVtxCount; n += 2, i += 3)
         {
-            strokeTexCoords[n] = (1.0f + strokePosVtxs[i]) * 0.5f;
-            strokeTexCoords[n+1] = 1.0f - (1.0f + strokePosVtxs[i+1]) * 0.5f;
+            strokeTexCoords[n] = (1.0f + cfGameIconStrokeVtxs[i]) * 0.5f;
+            strokeTexCoords[n+1] = 1.0f - (1.0f + cfGameIconStrokeVtxs[i+1]) * 0.5f;
         }
         GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, strokeTexCoords, cuGameIconStrokeVtxCount * Shader::cuTexCoordAttrSize);
     }
@@ -86,29 +129,39 @@ GameIcon::GameIcon(const std::string & filename, GuiImageData *preloadImage)
             strokeColorVtxs[i] = 0xff;
         GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, strokeColorVtxs, cuGameIconStrokeVtxCount * Shader::cuColorAttrSize);
     }
+
+    modelMutex->unlock();
 }
 
-GameIcon::~GameIcon()
+void GameIcon::modelExit(void)
 {
-    //! remove image so it can not be drawn anymore from this point on
-    imageData = NULL;
+    //! icons are deleted on the AsyncDeleter thread while new ones are created on the GUI thread
+    modelMutex->lock();
+
+    --modelRefCounter;
+
+    if(modelRefCounter > 0)
+    {
+        modelMutex->unlock();
+        return;
+    }
 
     //! main image vertexes
-    if(posVtxs)
+    if(modelPosVtxs)
     {
-        free((void*)posVtxs);
-        posVtxs = NULL;
+        free(modelPosVtxs);
+        modelPosVtxs = NULL;
     }
-    if(texCoords)
+    if(modelTexCoords)
     {
-        free((void*)texCoords);
-        texCoords = NULL;
+        free(modelTexCoords);
+        modelTexCoords = NULL;
     }
     //! mirror image vertexes
-    if(texCoordsMirror)
+    if(modelTexCoordsMirror)
     {
-        free(texCoordsMirror);
-        texCoordsMirror = NULL;
+        free(modelTexCoordsMirror);
+        modelTexCoordsMirror = NULL;
     }
     //! stroke image vertexes
     if(strokePosVtxs)
@@ -126,6 +179,8 @@ GameIcon::~GameIcon()
         free(strokeColorVtxs);
         strokeColorVtxs = NULL;
     }
+
+    modelMutex->unlock();
 }
 
 bool GameIcon::checkRayIntersection(const glm::vec3 & rayOrigin, const glm::vec3 & rayDirFrac)
@@ -173,6 +228,9 @@ bool GameIcon::checkRayIntersection(const glm::vec3 & rayOrigin, const glm::vec3
 
 void GameIcon::draw(CVideo *pVideo, const glm::mat4 & projectionMtx, const glm::mat4 & viewMtx, const glm::mat4 & modelView)
 {
+    //! the culling and depth changes below would also apply to queued quads
+    SpriteBatch::flush();
+
     //! first setup 2D GUI positions
     f32 currPosX = getCenterX() * pVideo->getWidthScaleFactor() * 2.0f;
     f32 currPosY = getCenterY() * pVideo->getHeightScaleFactor() * 2.0f;
@@ -293,7 +351,7 @@ void GameIcon::draw(CVideo *pVideo, const glm::mat4 & projectionMtx, const glm::
         Shader3D::instance()->setDistanceFadeOut(distanceFadeout);
         Shader3D::instance()->setModelViewMtx(m_mirrorView);
         Shader3D::instance()->setColorIntensity(colorIntensityMirror);
-        Shader3D::instance()->setAttributeBuffer(vtxCount, posVtxs, texCoordsMirror);
+        Shader3D::instance()->setAttributeBuffer(vtxCount, posVtxs, modelTexCoordsMirror);
         Shader3D::instance()->draw(GX2_PRIMITIVE_QUADS, vtxCount);
 
         if(bIconLast)
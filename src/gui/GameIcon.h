@@ -68,10 +68,6 @@ private:
     f32 rotationX;
     f32 rgbReduction;
     f32 distanceFadeout;
-    f32 *texCoordsMirror;
-    f32 *strokePosVtxs;
-    f32 *strokeTexCoords;
-    u8 *strokeColorVtxs;
     int strokeFractalEnable;
     f32 strokeBlurBorder;
     glm::vec4 selectionBlurOuterColorIntensity;
@@ -80,6 +76,19 @@ private:
     glm::vec4 selectionBlurInnerColorIntensity;
     f32 selectionBlurInnerSize;
     f32 selectionBlurInnerBorderSize;
+
+    //! the model vertexes are the same for all icons and created once
+    static void modelInit(void);
+    static void modelExit(void);
+
+    static u32 modelRefCounter;
+    static CMutex *modelMutex;
+    static f32 *modelPosVtxs;
+    static f32 *modelTexCoords;
+    static f32 *modelTexCoordsMirror;
+    static f32 *strokePosVtxs;
+    static f32 *strokeTexCoords;
+    static u8 *strokeColorVtxs;
 };
 
 #endif // _GAME_ICON_H_
@@ -49,7 +49,7 @@ GuiButton::GuiButton(f32 w, f32 h)
 	selectable = true;
 	holdable = false;
 	clickable = true;
-
+	updateRequired = true;
 }
 
 /**
@@ -206,6 +206,7 @@ void GuiButton::update(GuiController * c)
 					effects = effectsOver;
 					effectAmount = effectAmountOver;
 					effectTarget = effectTargetOver;
+					requireEffectUpdate();
 				}
 
                 selected(this, c);
@@ -225,6 +226,7 @@ void GuiButton::update(GuiController * c)
 				effects = effectsOver;
 				effectAmount = -effectAmountOver;
 				effectTarget = 100;
+				requireEffectUpdate();
 			}
         }
     }
@@ -50,6 +50,16 @@ public:
         vpadTvY = (tvHeight >> 1) - (int)(tvHeight - ((vpad.tpdata1.y * tvHeight) >> 12));
     }
 
+    //!Checks whether the pad was used in the last two reads
+    //!\return false if no button, stick or touch input arrived
+    bool isActive(void) const
+    {
+        if(vpad.btns_h || vpad.btns_r || vpad.tpdata.touched || vpadLast.tpdata.touched)
+            return true;
+
+        return isStickActive(vpad.lstick) || isStickActive(vpad.rstick);
+    }
+
     int chan;
     int vpadError;
     int vpadErrorLast;
@@ -59,6 +69,11 @@ public:
     int vpadTvY;
     VPADData vpad;
     VPADData vpadLast;
+private:
+    static bool isStickActive(const Vec2D & stick)
+    {
+        return (stick.x > 0.1f) || (stick.x < -0.1f) || (stick.y > 0.1f) || (stick.y < -0.1f);
+    }
 };
 
 #endif
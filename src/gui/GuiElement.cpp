@@ -20,6 +20,8 @@
 static int screenwidth = 1280;
 static int screenheight = 720;
 
+volatile bool GuiElement::redrawRequested = true;
+
 /**
  * Constructor for the Object class.
  */
@@ -54,6 +56,8 @@ GuiElement::GuiElement()
 	effectAmountOver = 0;
 	effectTargetOver = 0;
 	angle = 0.0f;
+	updateRequired = false;
+	effectUpdateRequired = false;
 
 	// default alignment - align to top left
 	alignment = (ALIGN_CENTER | ALIGN_MIDDLE);
@@ -174,6 +178,8 @@ void GuiElement::setEffect(int eff, int amount, int target)
 	effects |= eff;
 	effectAmount = amount;
 	effectTarget = target;
+
+	requireEffectUpdate();
 }
 
 //!Sets an effect to be enabled on wiimote cursor over
@@ -205,6 +211,10 @@ void GuiElement::updateEffects()
 	if(!this->isVisible() && parentElement)
 		return;
 
+	//! every effect step moves the element
+	if(effects != EFFECT_NONE)
+		requestRedraw();
+
 	if(effects & (EFFECT_SLIDE_IN | EFFECT_SLIDE_OUT | EFFECT_SLIDE_FROM))
 	{
 		if(effects & EFFECT_SLIDE_IN)
@@ -339,4 +349,7 @@ void GuiElement::updateEffects()
 			effectFinished(this);
 		}
 	}
+
+	//! parents may skip this element until the next effect is set
+	effectUpdateRequired = (effects != EFFECT_NONE);
 }
@@ -196,12 +196,14 @@ class GuiElement : public AsyncDeleter::Element
 		{
 			width = w;
 			height = h;
+			requestRedraw();
 		}
 		//!Sets the element's visibility
 		//!\param v Visibility (true = visible)
 		virtual void setVisible(bool v)
 		{
 			visible = v;
+			requestRedraw();
 			visibleChanged(this, v);
 		}
 		//!Checks whether or not the element is visible
@@ -246,6 +248,7 @@ class GuiElement : public AsyncDeleter::Element
                     state[i] |= s;
             }
             stateChan = c;
+            requestRedraw();
             stateChanged(this, s, c);
         }
         virtual void clearState(int s, int c = -1)
@@ -260,6 +263,7 @@ class GuiElement : public AsyncDeleter::Element
                     state[i] &= ~s;
             }
             stateChan = c;
+            requestRedraw();
             stateChanged(this, s, c);
         }
         virtual bool isStateSet(int s, int c = -1) const
@@ -289,10 +293,11 @@ class GuiElement : public AsyncDeleter::Element
             for(int i = 0; i < 4; i++)
                 state[i] = STATE_DEFAULT;
             stateChan = -1;
+            requestRedraw();
 		}
 		//!Sets the element's alpha value
 		//!\param a alpha value
-		virtual void setAlpha(f32 a) { alpha = a; }
+		virtual void setAlpha(f32 a) { alpha = a; requestRedraw(); }
 		//!Gets the element's alpha value
 		//!Considers alpha, alphaDyn, and the parent element's getAlpha() value
 		//!\return alpha
@@ -317,16 +322,17 @@ class GuiElement : public AsyncDeleter::Element
 			scaleX = s;
 			scaleY = s;
 			scaleZ = s;
+			requestRedraw();
 		}
 		//!Sets the element's scale
 		//!\param s scale (1 is 100%)
-		virtual void setScaleX(float s) { scaleX = s; }
+		virtual void setScaleX(float s) { scaleX = s; requestRedraw(); }
 		//!Sets the element's scale
 		//!\param s scale (1 is 100%)
-		virtual void setScaleY(float s) { scaleY = s; }
+		virtual void setScaleY(float s) { scaleY = s; requestRedraw(); }
 		//!Sets the element's scale
 		//!\param s scale (1 is 100%)
-		virtual void setScaleZ(float s) { scaleZ = s; }
+		virtual void setScaleZ(float s) { scaleZ = s; requestRedraw(); }
 		//!Gets the element's current scale
 		//!Considers scale, scaleDyn, and the parent element's getScale() value
 		virtual float getScale()
@@ -414,6 +420,7 @@ class GuiElement : public AsyncDeleter::Element
 		{
 			xoffset = x;
 			yoffset = y;
+			requestRedraw();
 		}
 		//!Sets the element's position
 		//!\param x X coordinate
@@ -424,6 +431,7 @@ class GuiElement : public AsyncDeleter::Element
 			xoffset = x;
 			yoffset = y;
 			zoffset = z;
+			requestRedraw();
 		}
 		//!Gets whether or not the element is in STATE_SELECTED
 		//!\return true if selected, false otherwise
@@ -431,11 +439,11 @@ class GuiElement : public AsyncDeleter::Element
 		//!Sets the element's alignment respective to its parent element
 		//!Bitwise ALIGN_LEFT | ALIGN_RIGHT | ALIGN_CENTRE, ALIGN_TOP, ALIGN_BOTTOM, ALIGN_MIDDLE)
 		//!\param align Alignment
-		virtual void setAlignment(int a) { alignment = a; }
+		virtual void setAlignment(int a) { alignment = a; requestRedraw(); }
 		//!Gets the element's alignment
 		virtual int getAlignment() const { return alignment; }
 		//!Angle of the object
-		virtual void setAngle(f32 a) { angle = a; }
+		virtual void setAngle(f32 a) { angle = a; requestRedraw(); }
 		//!Angle of the object
 		virtual f32 getAngle() const { f32 r_angle = angle; if(parentElement) r_angle += parentElement->getAngle(); return r_angle; }
 		//!Called constantly to allow the element to respond to the current input data
@@ -446,6 +454,21 @@ class GuiElement : public AsyncDeleter::Element
 		//!Updates the element's effects (dynamic values)
 		//!Called by Draw(), used for animation purposes
 		virtual void updateEffects();
+		//!Checks whether the element or one of its children reacts on update()
+		//!\return true if the parent frame has to call update(), false otherwise
+		bool isUpdateRequired() const { return updateRequired; }
+		//!Checks whether the element or one of its children has effects running
+		//!\return true if the parent frame has to call updateEffects(), false otherwise
+		virtual bool isEffectUpdateRequired() const { return effectUpdateRequired; }
+		//!Marks the screen content as changed so that the next frame gets drawn
+		static void requestRedraw() { redrawRequested = true; }
+		//!Checks whether anything changed since the last call and resets the request
+		static bool checkRedrawRequest()
+		{
+			bool requested = redrawRequested;
+			redrawRequested = false;
+			return requested;
+		}
 
         typedef struct _POINT {
             s32 x;
@@ -511,6 +534,22 @@ class GuiElement : public AsyncDeleter::Element
 		int effectsOver; //!< Effects to enable when wiimote cursor is over this element. Copied to effects variable on over event
 		int effectAmountOver; //!< EffectAmount to set when wiimote cursor is over this element
 		int effectTargetOver; //!< EffectTarget to set when wiimote cursor is over this element
+		bool updateRequired; //!< Element or one of its children reacts on update()
+		bool effectUpdateRequired; //!< Element or one of its children has effects running
+		static volatile bool redrawRequested; //!< Some element changed since the last drawn frame
+
+		//!Marks the element and its parents to be visited by update()
+		void requireUpdate()
+		{
+			for(GuiElement *e = this; e != NULL; e = e->parentElement)
+				e->updateRequired = true;
+		}
+		//!Marks the element and its parents to be visited by updateEffects()
+		void requireEffectUpdate()
+		{
+			for(GuiElement *e = this; e != NULL; e = e->parentElement)
+				e->effectUpdateRequired = true;
+		}
 };
 
 #endif
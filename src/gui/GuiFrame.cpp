@@ -54,6 +54,12 @@ void GuiFrame::append(GuiElement* e)
 	remove(e);
 	elements.push_back(e);
 	e->setParent(this);
+	requestRedraw();
+
+	if(e->isUpdateRequired())
+		requireUpdate();
+	if(e->isEffectUpdateRequired())
+		requireEffectUpdate();
 }
 
 void GuiFrame::insert(GuiElement* e, u32 index)
@@ -64,6 +70,12 @@ void GuiFrame::insert(GuiElement* e, u32 index)
 	remove(e);
 	elements.insert(elements.begin()+index, e);
 	e->setParent(this);
+	requestRedraw();
+
+	if(e->isUpdateRequired())
+		requireUpdate();
+	if(e->isEffectUpdateRequired())
+		requireEffectUpdate();
 }
 
 void GuiFrame::remove(GuiElement* e)
@@ -76,6 +88,7 @@ void GuiFrame::remove(GuiElement* e)
 		if(e == elements[i])
 		{
 			elements.erase(elements.begin()+i);
+			requestRedraw();
 			break;
 		}
 	}
@@ -84,6 +97,7 @@ void GuiFrame::remove(GuiElement* e)
 void GuiFrame::removeAll()
 {
 	elements.clear();
+	requestRedraw();
 }
 
 void GuiFrame::close()
@@ -188,6 +202,10 @@ void GuiFrame::updateEffects()
 	if(!this->isVisible() && parentElement)
 		return;
 
+	//! nothing is animated in this frame or below it
+	if(!effectUpdateRequired)
+		return;
+
     GuiElement::updateEffects();
 
 	//! render appended items next frame but allow stop of render if size is reached
@@ -197,6 +215,16 @@ void GuiFrame::updateEffects()
 	{
 		elements[i]->updateEffects();
 	}
+
+	//! keep visiting this frame as long as any child has effects running
+	bool required = (effects != EFFECT_NONE);
+
+	for (u32 i = 0; i < elements.size() && !required; ++i)
+	{
+		required = elements[i]->isEffectUpdateRequired();
+	}
+
+	effectUpdateRequired = required;
 }
 
 void GuiFrame::update(GuiController * c)
@@ -204,6 +232,10 @@ void GuiFrame::update(GuiController * c)
 	if(isStateSet(STATE_DISABLED) && parentElement)
 		return;
 
+	//! no element in this frame reacts on input
+	if(!updateRequired)
+		return;
+
 	//! update appended items next frame
 	u32 size = elements.size();
 
@@ -23,7 +23,10 @@
 class GuiGameBrowser : public GuiFrame
 {
 public:
-    GuiGameBrowser(int w, int h) : GuiFrame(w, h) {}
+    GuiGameBrowser(int w, int h) : GuiFrame(w, h) {
+        //! all browsers handle input in their update()
+        updateRequired = true;
+    }
     virtual ~GuiGameBrowser() {}
 
     virtual void setSelectedGame(int idx) = 0;
@@ -31,6 +34,26 @@ public:
 
     sigslot::signal2<GuiGameBrowser *, int> gameLaunchClicked;
     sigslot::signal2<GuiGameBrowser *, int> gameSelectionChanged;
+protected:
+    //!Sort the indices of drawOrder by ascending depth, equal depths by index.
+    //!The order of the last update is nearly sorted already, so the insertion
+    //!sort only moves the few items that passed each other since then.
+    static void sortDrawOrder(std::vector<int> & drawOrder, const std::vector<f32> & drawDepth)
+    {
+        for(size_t i = 1; i < drawOrder.size(); i++)
+        {
+            int idx = drawOrder[i];
+            f32 depth = drawDepth[idx];
+            size_t n = i;
+
+            while(n > 0 && (drawDepth[drawOrder[n - 1]] > depth || (drawDepth[drawOrder[n - 1]] == depth && drawOrder[n - 1] > idx)))
+            {
+                drawOrder[n] = drawOrder[n - 1];
+                n--;
+            }
+            drawOrder[n] = idx;
+        }
+    }
 };
 
 #endif /* GUIGAMEBROWSER_H_ */
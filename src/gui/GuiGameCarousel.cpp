@@ -14,7 +14,6 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  ****************************************************************************/
-#include <map>
 #include <string.h>
 #include <math.h>
 #include <sstream>
@@ -79,6 +78,7 @@ GuiGameCarousel::GuiGameCarousel(int w, int h, int offset)
 
 	game.resize(pagesize);
 	drawOrder.resize(pagesize);
+	drawDepth.resize(pagesize);
 	coverImg.resize(pagesize);
 
     touchButton.setAlignment(ALIGN_LEFT | ALIGN_TOP);
@@ -156,6 +156,9 @@ void GuiGameCarousel::setSelectedGame(int idx)
     touchClickDelay = 20;
     circleSpeedLimit = 1.8f;
     refreshDrawMap = true;
+
+    //! the TV carousel gets its selection here without an update()
+    requireEffectUpdate();
 }
 
 int GuiGameCarousel::getSelectedGame()
@@ -356,9 +359,6 @@ void GuiGameCarousel::updateDrawMap(void)
     const int carousel_x = 0;
     const int carousel_y = -RADIUS + 80;
 
-    std::multimap<float, int> drawMap;
-    std::multimap<float, int>::iterator itr;
-
     for(int i = 0; i < pagesize; i++)
     {
         float setDegree = (currDegree - DEG_OFFSET * i);
@@ -368,15 +368,11 @@ void GuiGameCarousel::updateDrawMap(void)
         game[i]->setPosition(carousel_x + posX, carousel_y + posY);
         game[i]->setAngle(rotationAngle);
 
-        drawMap.insert(std::pair<float, int>(posY, i));
+        drawDepth[i] = posY;
+        coverImg[i]->setColorIntensity(glm::vec4(0.6f, 0.6f, 0.6f, 1.0f));
     }
 
-    int n = 0;
-    for(itr = drawMap.begin(); itr != drawMap.end(); itr++)
-    {
-        drawOrder[n++] = itr->second;
-        coverImg[itr->second]->setColorIntensity(glm::vec4(0.6f, 0.6f, 0.6f, 1.0f));
-    }
+    sortDrawOrder(drawOrder, drawDepth);
 
     if(drawOrder.size())
     {
@@ -392,6 +388,48 @@ void GuiGameCarousel::updateDrawMap(void)
  */
 void GuiGameCarousel::draw(CVideo *v)
 {
+    GuiGameBrowser::draw(v);
+
+    for(u32 i = 0; i < drawOrder.size(); i++)
+    {
+        int idx = drawOrder[i];
+        game[idx]->draw(v);
+    }
+}
+
+void GuiGameCarousel::update(GuiController * c)
+{
+	if (!isStateSet(STATE_DISABLED) && pagesize)
+    {
+        GuiGameBrowser::update(c);
+
+        for(u32 i = 0; i < drawOrder.size(); i++)
+        {
+            int idx = drawOrder[i];
+            game[idx]->update(c);
+        }
+    }
+
+    if(refreshDrawMap)
+    {
+        refreshDrawMap = false;
+        updateDrawMap();
+    }
+
+    if(isEffectUpdatePending())
+        requireEffectUpdate();
+}
+
+
+void GuiGameCarousel::updateEffects()
+{
+    //! counted here as update() is not called for the TV and frames can be skipped
+    gameLaunchTimer++;
+
+    if(touchClickDelay)
+        touchClickDelay--;
+
+    //! the async loader requests a redraw when the new background arrived
     if(bgNewImageDataAsync && bgNewImageDataAsync->getImageData() && !bgFadingImageDataAsync)
     {
         if(bgUsedImageDataAsync)
@@ -450,49 +488,25 @@ void GuiGameCarousel::draw(CVideo *v)
         startRotationDistance = 0.0f;
     }
 
-
     if(refreshDrawMap)
     {
         refreshDrawMap = false;
         updateDrawMap();
     }
 
-    GuiGameBrowser::draw(v);
-
-    for(u32 i = 0; i < drawOrder.size(); i++)
-    {
-        int idx = drawOrder[i];
-        game[idx]->draw(v);
-    }
-}
-
-void GuiGameCarousel::update(GuiController * c)
-{
-	if (isStateSet(STATE_DISABLED) || !pagesize)
-        return;
-
-    GuiGameBrowser::update(c);
-
-    for(u32 i = 0; i < drawOrder.size(); i++)
-    {
-        int idx = drawOrder[i];
-        game[idx]->update(c);
-    }
-}
-
-
-void GuiGameCarousel::updateEffects()
-{
-    gameLaunchTimer++;
-
-    if(touchClickDelay)
-        touchClickDelay--;
-
     GuiGameBrowser::updateEffects();
 
+    //! keep being visited until the rotation, the timers and the background are done
+    if(isEffectUpdatePending())
+        effectUpdateRequired = true;
+
+    //! the covers are not in the element list
     for(u32 i = 0; i < drawOrder.size(); i++)
     {
         int idx = drawOrder[i];
         game[idx]->updateEffects();
+
+        if(game[idx]->isEffectUpdateRequired())
+            effectUpdateRequired = true;
     }
 }
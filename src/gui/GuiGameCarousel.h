@@ -51,6 +51,15 @@ protected:
     void OnBgEffectFinished(GuiElement *element);
 
     void updateDrawMap(void);
+    bool isRotating(void) const {
+        return fabsf(currDegree - destDegree) > 0.5f;
+    }
+    //! the rotation, the click timers and a background that is still loading advance in updateEffects()
+    bool isEffectUpdatePending(void) const {
+        //! a background that failed to load is never swapped in
+        bool bBgPending = bgNewImageDataAsync && (bgNewImageDataAsync->getImageData() || !bgNewImageDataAsync->isLoadFinished());
+        return isRotating() || touchClickDelay || (gameLaunchTimer < 30) || bBgPending;
+    }
 
     void loadBgImage(int idx);
 
@@ -75,6 +84,7 @@ protected:
     std::vector<GuiButton *> game;
     std::vector<GuiImage *> coverImg;
     std::vector<int> drawOrder;
+    std::vector<f32> drawDepth;
 
     f32 currDegree;
     f32 destDegree;
@@ -14,6 +14,7 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  ****************************************************************************/
+#include <algorithm>
 #include "GuiIconCarousel.h"
 #include "GuiController.h"
 #include "common/common.h"
@@ -28,6 +29,10 @@ static const float Yoffset = 0.04f;
 static const float cam_X_rot = 25.0f;
 static const float fIconRgbDrop = 0.395f;
 static const float fOpacy = 1.0f;
+//! icons kept on each side of the front position, the others are out of view or tiny in the back
+static const int ICON_WINDOW = 12;
+//! icons further away from the front than this are drawn without reflection and stroke
+static const int ICON_LOD_DISTANCE = 4;
 
 GuiIconCarousel::GuiIconCarousel(int w, int h)
     : GuiGameBrowser(w, h)
@@ -89,17 +94,11 @@ GuiIconCarousel::GuiIconCarousel(int w, int h)
     append(&launchButton);
 
 
-    for(int i = 0; i < GameList::instance()->size(); i++)
-    {
-		std::string filepath = GameList::instance()->at(i)->gamepath + META_PATH + "/iconTex.tga";
-
-        GameIcon *icon = new GameIcon(filepath, &noIcon);
-        icon->setParent(this);
-
-        gameIcons.push_back(icon);
-        drawOrder.push_back(i);
-        append(icon);
-    }
+    iconWindowFront = -1;
+    gameIcons.resize(GameList::instance()->size(), NULL);
+    drawDepth.resize(gameIcons.size());
+    drawOrder.reserve(2 * ICON_WINDOW + 1);
+    updateIconLayout();
 
     gameTitle.setPosition(0, -320);
     gameTitle.setBlurGlowColor(16.0f, glm::vec4(0.109804, 0.6549, 1.0f, 1.0f));
@@ -115,7 +114,8 @@ GuiIconCarousel::~GuiIconCarousel()
 
     for(size_t i = 0; i < gameIcons.size(); i++)
     {
-        delete gameIcons[i];
+        if(gameIcons[i])
+            delete gameIcons[i];
     }
 
     Resources::RemoveSound(buttonClickSound);
@@ -138,7 +138,7 @@ int GuiIconCarousel::getSelectedGame()
 
 void GuiIconCarousel::setSelectedGame(int selectedIdx)
 {
-    if(selectedIdx < 0 || selectedIdx >= (int)drawOrder.size())
+    if(selectedIdx < 0 || selectedIdx >= (int)gameIcons.size())
         return;
 
     //! normalize to 360°
@@ -158,6 +158,9 @@ void GuiIconCarousel::setSelectedGame(int selectedIdx)
 
     touchClickDelay = 20;
     circleSpeedLimit = 1.8f;
+
+    //! the TV carousel gets its selection here without an update()
+    requireEffectUpdate();
 }
 
 void GuiIconCarousel::OnTouchClick(GuiButton *button, const GuiController *controller, GuiTrigger *trigger)
@@ -225,7 +228,7 @@ void GuiIconCarousel::OnTouchRelease(GuiButton *button, const GuiController *con
 {
     for(size_t i = 0; i < gameIcons.size(); ++i)
     {
-        if(gameIcons[i]->isStateSet(STATE_CLICKED))
+        if(gameIcons[i] && gameIcons[i]->isStateSet(STATE_CLICKED))
         {
             gameIcons[i]->setEffect(EFFECT_SCALE, -4, 100);
             gameIcons[i]->clearState(STATE_CLICKED);
@@ -297,19 +300,17 @@ void GuiIconCarousel::OnRightClick(GuiButton *button, const GuiController *contr
 
 void GuiIconCarousel::updateDrawMap(void)
 {
-    //! create a multimap of Z position which will sort the items by z coordinate
-    std::multimap< float, std::pair<float, int> > drawMap;
-    std::multimap< float, std::pair<float, int> >::const_iterator itr;
-    size_t i;
+    int front = getFrontGame();
 
-    for(i = 0; i < gameIcons.size(); i++)
+    //! drawOrder holds the live icons, sorted by z coordinate of the last update
+    for(size_t i = 0; i < drawOrder.size(); i++)
     {
-        int idx = i;
+        int idx = drawOrder[i];
 
-        float currDegree = DegToRad(360.0f / (radiusScale * gameIcons.size()) * i + circlePosition + 90.0f);
+        float currDegree = DegToRad(360.0f / (radiusScale * gameIcons.size()) * idx + circlePosition + 90.0f);
         float posX = radiusScale * circleRadius * cosf(currDegree);
         float posZ = radiusScale * circleRadius * sinf(currDegree) + RADIUS - gameIcons.size() * (RADIUS / 12.0f);
-        drawMap.insert(std::pair<float, std::pair<float, int> >(posZ, std::pair<float, int>(posX, i)));
+        drawDepth[idx] = posZ;
 
         float rgbReduction = std::min((circleRadius + posZ / 2.0f + fIconRgbDrop) / (2.0f * circleRadius), 1.0f);
         if(rgbReduction < 0.0f)
@@ -321,18 +322,19 @@ void GuiIconCarousel::updateDrawMap(void)
 
         gameIcons[idx]->setColorIntensity(glm::vec4(rgbReduction, rgbReduction, rgbReduction, 1.0f));
         gameIcons[idx]->setAlpha(alphaReduction);
-        gameIcons[idx]->setRenderReflection(true);
+        bool bNearFront = (getFrontDistance(idx, front) <= ICON_LOD_DISTANCE);
+        gameIcons[idx]->setRenderReflection(bNearFront);
+        gameIcons[idx]->setStrokeRender(bNearFront);
         gameIcons[idx]->setRotationX(-cam_X_rot);
         gameIcons[idx]->setPosition(posX * width * 0.5f, Yoffset * height * 0.5f, posZ * width * 0.5f);
     }
 
-    for(itr = drawMap.begin(), i = 0; itr != drawMap.end(); i++, itr++)
-    {
-        int idx = itr->second.second;
+    sortDrawOrder(drawOrder, drawDepth);
 
-        itr++;
-        bool bSelected = (itr == drawMap.end());
-        itr--;
+    for(size_t i = 0; i < drawOrder.size(); i++)
+    {
+        int idx = drawOrder[i];
+        bool bSelected = (i == drawOrder.size() - 1);
 
         if(!bSelected)
         {
@@ -369,36 +371,106 @@ void GuiIconCarousel::updateDrawMap(void)
             gameIcons[idx]->setColorIntensity(glm::vec4(intensity[0], intensity[1], intensity[2], 1.2f * intensity[3]));
         }
 
-        drawOrder[i] = idx;
         gameIcons[idx]->setSelected(bSelected);
     }
 }
 
-void GuiIconCarousel::draw(CVideo *pVideo, const glm::mat4 & modelView)
+int GuiIconCarousel::getFrontGame(void) const
 {
-    if(!this->isVisible())
+    int count = gameIcons.size();
+    if(count == 0)
+        return 0;
+
+    //! inverse of the target position in setSelectedGame
+    f32 partDegree = 360.0f / (radiusScale * count);
+    int front = (int)floorf((360.0f - circlePosition) / partDegree + 0.5f) % count;
+    if(front < 0)
+        front += count;
+    return front;
+}
+
+int GuiIconCarousel::getFrontDistance(int idx, int front) const
+{
+    int count = gameIcons.size();
+    int distance = abs(idx - front) % count;
+    return std::min(distance, count - distance);
+}
+
+void GuiIconCarousel::updateIconWindow(void)
+{
+    int count = gameIcons.size();
+    if(count == 0)
+        return;
+
+    int front = getFrontGame();
+    if(front == iconWindowFront)
         return;
 
+    //! drop the icons that left the window
+    if(iconWindowFront >= 0)
+    {
+        for(int n = -ICON_WINDOW; n <= ICON_WINDOW; n++)
+        {
+            int idx = ((iconWindowFront + n) % count + count) % count;
+
+            if(gameIcons[idx] && getFrontDistance(idx, front) > ICON_WINDOW)
+            {
+                remove(gameIcons[idx]);
+                drawOrder.erase(std::find(drawOrder.begin(), drawOrder.end(), idx));
+                //! the icon may still be in the async loader queue or be drawn this frame
+                AsyncDeleter::pushForDelete(gameIcons[idx]);
+                gameIcons[idx] = NULL;
+            }
+        }
+    }
+
+    //! and create the ones that came in
+    for(int n = -ICON_WINDOW; n <= ICON_WINDOW; n++)
+    {
+        int idx = ((front + n) % count + count) % count;
+        if(gameIcons[idx])
+            continue;
+
+		std::string filepath = GameList::instance()->at(idx)->gamepath + META_PATH + "/iconTex.tga";
+
+        GameIcon *icon = new GameIcon(filepath, &noIcon);
+        icon->setParent(this);
+
+        gameIcons[idx] = icon;
+        drawOrder.push_back(idx);
+        append(icon);
+    }
+
+    iconWindowFront = front;
+    bUpdateMap = true;
+}
+
+void GuiIconCarousel::updateIconLayout(void)
+{
+    updateIconWindow();
+
     if(bUpdateMap)
     {
         bUpdateMap = false;
         updateDrawMap();
     }
+}
 
-    if(bgNewImageDataAsync && bgNewImageDataAsync->getImageData() && !bgFadingImageDataAsync)
-    {
-        if(bgUsedImageDataAsync)
-        {
-            bgFadingImageDataAsync = bgUsedImageDataAsync;
-            bgFadingImageDataAsync->setEffect(EFFECT_FADE, -10, 0);
-            bgFadingImageDataAsync->effectFinished.connect(this, &GuiIconCarousel::OnBgEffectFinished);
-        }
+void GuiIconCarousel::update(GuiController * c)
+{
+    GuiGameBrowser::update(c);
 
-        bgUsedImageDataAsync = bgNewImageDataAsync;
-        bgNewImageDataAsync = NULL;
-        bgUsedImageDataAsync->setEffect(EFFECT_FADE, 5, 255);
-        append(bgUsedImageDataAsync);
-    }
+    //! dragging moves the circle, icons are created and dropped here instead of while drawing
+    updateIconLayout();
+
+    if(isEffectUpdatePending())
+        requireEffectUpdate();
+}
+
+void GuiIconCarousel::draw(CVideo *pVideo, const glm::mat4 & modelView)
+{
+    if(!this->isVisible())
+        return;
 
     pVideo->setStencilRender(true);
 
@@ -418,17 +490,32 @@ void GuiIconCarousel::draw(CVideo *pVideo, const glm::mat4 & modelView)
     }
 
     gameTitle.draw(pVideo);
+}
+
+void GuiIconCarousel::updateEffects()
+{
+    //! counted here as update() is not called for the TV and frames can be skipped
+    gameLaunchTimer++;
 
     if(touchClickDelay)
-    {
         touchClickDelay--;
-    }
 
-    gameLaunchTimer++;
-}
+    //! the async loader requests a redraw when the new background arrived
+    if(bgNewImageDataAsync && bgNewImageDataAsync->getImageData() && !bgFadingImageDataAsync)
+    {
+        if(bgUsedImageDataAsync)
+        {
+            bgFadingImageDataAsync = bgUsedImageDataAsync;
+            bgFadingImageDataAsync->setEffect(EFFECT_FADE, -10, 0);
+            bgFadingImageDataAsync->effectFinished.connect(this, &GuiIconCarousel::OnBgEffectFinished);
+        }
+
+        bgUsedImageDataAsync = bgNewImageDataAsync;
+        bgNewImageDataAsync = NULL;
+        bgUsedImageDataAsync->setEffect(EFFECT_FADE, 5, 255);
+        append(bgUsedImageDataAsync);
+    }
 
-void GuiIconCarousel::updateEffects()
-{
     if((circlePosition - 0.5f) > circleTargetPosition)
     {
         if(startRotationDistance == 0.0f)
@@ -470,5 +557,11 @@ void GuiIconCarousel::updateEffects()
         startRotationDistance = 0.0f;
     }
 
+    updateIconLayout();
+
     GuiGameBrowser::updateEffects();
+
+    //! keep being visited until the rotation, the timers and the background are done
+    if(isEffectUpdatePending())
+        effectUpdateRequired = true;
 }
@@ -41,6 +41,7 @@ public:
 
     void draw(CVideo *pVideo, const glm::mat4 & modelView);
 
+    void update(GuiController * c);
     void updateEffects();
 private:
     void OnTouchClick(GuiButton *button, const GuiController *controller, GuiTrigger *trigger);
@@ -56,6 +57,19 @@ private:
     void OnBgEffectFinished(GuiElement *element);
 
     void updateDrawMap(void);
+    void updateIconWindow(void);
+    void updateIconLayout(void);
+    int getFrontGame(void) const;
+    int getFrontDistance(int idx, int front) const;
+    bool isRotating(void) const {
+        return fabsf(circlePosition - circleTargetPosition) > 0.5f;
+    }
+    //! the rotation, the click timers and a background that is still loading advance in updateEffects()
+    bool isEffectUpdatePending(void) const {
+        //! a background that failed to load is never swapped in
+        bool bBgPending = bgNewImageDataAsync && (bgNewImageDataAsync->getImageData() || !bgNewImageDataAsync->isLoadFinished());
+        return isRotating() || touchClickDelay || (gameLaunchTimer < 30) || bBgPending;
+    }
 
     bool bUpdateMap;
 
@@ -90,8 +104,11 @@ private:
     GuiButton leftButton;
     GuiButton rightButton;
     GuiButton launchButton;
+    //! one entry per game, NULL if the icon is too far from the front
     std::vector<GameIcon *> gameIcons;
     std::vector<int> drawOrder;
+    std::vector<f32> drawDepth;
+    int iconWindowFront;
     int touchClickDelay;
     int selectedGame;
     int selectedGameOnDragStart;
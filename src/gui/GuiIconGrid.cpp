@@ -14,12 +14,14 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  ****************************************************************************/
+#include <string.h>
 #include "GuiIconGrid.h"
 #include "GuiController.h"
 #include "common/common.h"
 #include "Application.h"
 #include "video/CVideo.h"
 #include "game/GameList.h"
+#include "utils/utils.h"
 
 GuiIconGrid::GuiIconGrid(int w, int h)
     : GuiGameBrowser(w, h)
@@ -54,6 +56,8 @@ GuiIconGrid::GuiIconGrid(int w, int h)
     targetLeftPosition = 0;
 
     particleBgImage.setParent(this);
+    //! the particles are animated through updateEffects() of this frame
+    requireEffectUpdate();
 
     leftButton.setTrigger(&leftTrigger);
     leftButton.clicked.connect(this, &GuiIconGrid::OnLeftClick);
@@ -75,42 +79,17 @@ GuiIconGrid::GuiIconGrid(int w, int h)
     launchButton.clicked.connect(this, &GuiIconGrid::OnLaunchClick);
     this->append(&launchButton);
 
-    int maxPages = (GameList::instance()->size() + (MAX_COLS * MAX_ROWS - 1)) / (MAX_COLS * MAX_ROWS);
+    int slotCount = getPageCount() * MAX_COLS * MAX_ROWS;
+    gameIcons.resize(slotCount, NULL);
+    gameButtons.resize(slotCount, NULL);
 
-    for(int idx = 0; idx < (maxPages * MAX_COLS * MAX_ROWS); idx++)
+    for(int i = 0; i < 2; i++)
     {
-        GameIcon *image = NULL;
-        if(idx < GameList::instance()->size())
-        {
-            std::string filepath = GameList::instance()->at(idx)->gamepath + META_PATH + "/iconTex.tga";
-            image = new GameIcon(filepath, &noIcon);
-        }
-        else
-        {
-            image = new GameIcon("", &emptyIcon);
-        }
-
-        image->setRenderReflection(false);
-        image->setStrokeRender(false);
-        image->setSelected(idx == selectedGame);
-        image->setRenderIconLast(true);
-
-        GuiButton * button = new GuiButton(noIcon.getWidth(), noIcon.getHeight());
-        button->setImage(image);
-        button->setPosition(0, 0);
-        button->setEffectGrow();
-        button->setTrigger(&touchTrigger);
-        button->setSoundClick(buttonClickSound);
-        button->setClickable( (idx < GameList::instance()->size()) );
-        button->setSelectable( (idx < GameList::instance()->size()) );
-        button->clicked.connect(this, &GuiIconGrid::OnGameButtonClick);
-        this->append(button);
-
-        gameButtons.push_back(button);
-        gameIcons.push_back(image);
+        loadedPages[i][0] = 0;
+        loadedPages[i][1] = -1;
     }
 
-    updateButtonPositions();
+    updateVisibleIcons();
 
     if((MAX_ROWS * MAX_COLS) < GameList::instance()->size())
     {
@@ -140,6 +119,8 @@ GuiIconGrid::~GuiIconGrid()
         delete gameIcons[i];
         delete gameButtons[i];
     }
+    for(u32 i = 0; i < buttonPool.size(); i++)
+        delete buttonPool[i];
 
     Resources::RemoveImageData(arrowRightImageData);
     Resources::RemoveImageData(arrowLeftImageData);
@@ -180,7 +161,8 @@ void GuiIconGrid::setSelectedGame(int idx)
             }
         }
 
-        gameIcons[i]->setSelected((u32)idx == i);
+        if(gameIcons[i])
+            gameIcons[i]->setSelected((u32)idx == i);
     }
 }
 
@@ -364,37 +346,194 @@ void GuiIconGrid::OnGameButtonClick(GuiButton *button, const GuiController *cont
     }
 }
 
-void GuiIconGrid::updateButtonPositions()
+int GuiIconGrid::getPageCount() const
 {
-    int col = 0, row = 0, listOff = 0;
+    return (GameList::instance()->size() + (MAX_COLS * MAX_ROWS - 1)) / (MAX_COLS * MAX_ROWS);
+}
 
-    for(u32 i = 0; i < gameButtons.size(); i++)
+bool GuiIconGrid::isPageLoaded(int page) const
+{
+    for(int i = 0; i < 2; i++)
+    {
+        if(page >= loadedPages[i][0] && page <= loadedPages[i][1])
+            return true;
+    }
+    return false;
+}
+
+void GuiIconGrid::createGameButton(int idx)
+{
+    GameIcon *image = NULL;
+    if(idx < GameList::instance()->size())
+    {
+        std::string filepath = GameList::instance()->at(idx)->gamepath + META_PATH + "/iconTex.tga";
+        image = new GameIcon(filepath, &noIcon);
+    }
+    else
+    {
+        image = new GameIcon("", &emptyIcon);
+    }
+
+    image->setRenderReflection(false);
+    image->setStrokeRender(false);
+    image->setSelected(idx == selectedGame);
+    image->setRenderIconLast(true);
+
+    GuiButton * button = NULL;
+    if(!buttonPool.empty())
+    {
+        button = buttonPool.back();
+        buttonPool.pop_back();
+        button->resetState();
+        button->resetEffects();
+    }
+    else
+    {
+        button = new GuiButton(noIcon.getWidth(), noIcon.getHeight());
+        button->setTrigger(&touchTrigger);
+        button->setSoundClick(buttonClickSound);
+        button->clicked.connect(this, &GuiIconGrid::OnGameButtonClick);
+    }
+
+    button->setImage(image);
+    button->setEffectGrow();
+    button->setClickable( (idx < GameList::instance()->size()) );
+    button->setSelectable( (idx < GameList::instance()->size()) );
+    insertGameButton(button, idx);
+
+    gameButtons[idx] = button;
+    gameIcons[idx] = image;
+
+    updateButtonPosition(idx);
+}
+
+void GuiIconGrid::insertGameButton(GuiButton *button, int idx)
+{
+    //! keep the slot order behind the launch button and in front of the arrows,
+    //! reused buttons would otherwise end up behind the arrows
+    u32 pos = 0;
+    while(pos < elements.size() && elements[pos] != &launchButton)
+        pos++;
+    pos++;
+
+    for(int i = 0; i < idx; i++)
+    {
+        if(gameButtons[i])
+            pos++;
+    }
+
+    if(pos < elements.size())
+        insert(button, pos);
+    else
+        append(button);
+}
+
+void GuiIconGrid::releaseGameButton(int idx)
+{
+    if(!gameButtons[idx])
+        return;
+
+    remove(gameButtons[idx]);
+    gameButtons[idx]->setImage(NULL);
+    buttonPool.push_back(gameButtons[idx]);
+    gameButtons[idx] = NULL;
+
+    //! the icon may still be in the async loader queue or be drawn this frame
+    AsyncDeleter::pushForDelete(gameIcons[idx]);
+    gameIcons[idx] = NULL;
+}
+
+void GuiIconGrid::updateVisibleIcons()
+{
+    int pageWidth = (int)getWidth();
+    int maxPages = getPageCount();
+    if(pageWidth <= 0 || maxPages <= 0)
+        return;
+
+    //! pages shown during the slide animation and the page it slides to
+    int newPages[2][2];
+    newPages[0][0] = (-currentLeftPosition) / pageWidth - PAGE_MARGIN;
+    newPages[0][1] = (-currentLeftPosition + pageWidth - 1) / pageWidth + PAGE_MARGIN;
+    newPages[1][0] = listOffset - PAGE_MARGIN;
+    newPages[1][1] = listOffset + PAGE_MARGIN;
+
+    bool changed = false;
+
+    for(int i = 0; i < 2; i++)
     {
-        listOff = i / (MAX_COLS * MAX_ROWS);
+        newPages[i][0] = LIMIT(newPages[i][0], 0, maxPages - 1);
+        newPages[i][1] = LIMIT(newPages[i][1], 0, maxPages - 1);
+
+        if(newPages[i][0] != loadedPages[i][0] || newPages[i][1] != loadedPages[i][1])
+            changed = true;
+    }
 
-        float posX = currentLeftPosition + listOff * width + ( col * (noIcon.getWidth() + noIcon.getWidth() * 0.5f) - (MAX_COLS * 0.5f - 0.5f) * (noIcon.getWidth() + noIcon.getWidth() * 0.5f) );
-        float posY = -row * (noIcon.getHeight() + noIcon.getHeight() * 0.5f) + (MAX_ROWS * 0.5f - 0.5f) * (noIcon.getHeight() + noIcon.getHeight() * 0.5f) + 30.0f;
+    if(!changed)
+        return;
 
-        gameButtons[i]->setPosition(posX, posY);
+    int oldPages[2][2];
+    memcpy(oldPages, loadedPages, sizeof(oldPages));
+    memcpy(loadedPages, newPages, sizeof(loadedPages));
 
-        col++;
-        if(col >= MAX_COLS)
+    //! release the slots of pages that are not needed anymore
+    for(int i = 0; i < 2; i++)
+    {
+        for(int page = oldPages[i][0]; page <= oldPages[i][1]; page++)
         {
-            col = 0;
-            row++;
+            if(isPageLoaded(page))
+                continue;
+
+            for(int idx = page * MAX_COLS * MAX_ROWS; idx < (page + 1) * MAX_COLS * MAX_ROWS; idx++)
+                releaseGameButton(idx);
+        }
+    }
+
+    //! and create the ones which came into view
+    for(int i = 0; i < 2; i++)
+    {
+        for(int page = loadedPages[i][0]; page <= loadedPages[i][1]; page++)
+        {
+            for(int idx = page * MAX_COLS * MAX_ROWS; idx < (page + 1) * MAX_COLS * MAX_ROWS; idx++)
+            {
+                if(!gameButtons[idx])
+                    createGameButton(idx);
+            }
         }
-        if(row >= MAX_ROWS)
-            row = 0;
     }
 }
 
-void GuiIconGrid::update(GuiController * c)
+void GuiIconGrid::updateButtonPosition(int idx)
 {
-    GuiFrame::update(c);
+    int listOff = idx / (MAX_COLS * MAX_ROWS);
+    int col = idx % MAX_COLS;
+    int row = (idx % (MAX_COLS * MAX_ROWS)) / MAX_COLS;
+
+    float posX = currentLeftPosition + listOff * width + ( col * (noIcon.getWidth() + noIcon.getWidth() * 0.5f) - (MAX_COLS * 0.5f - 0.5f) * (noIcon.getWidth() + noIcon.getWidth() * 0.5f) );
+    float posY = -row * (noIcon.getHeight() + noIcon.getHeight() * 0.5f) + (MAX_ROWS * 0.5f - 0.5f) * (noIcon.getHeight() + noIcon.getHeight() * 0.5f) + 30.0f;
+
+    gameButtons[idx]->setPosition(posX, posY);
 }
 
-void GuiIconGrid::draw(CVideo *pVideo)
+void GuiIconGrid::updateButtonPositions()
+{
+    for(int i = 0; i < 2; i++)
+    {
+        for(int idx = loadedPages[i][0] * MAX_COLS * MAX_ROWS; idx < (loadedPages[i][1] + 1) * MAX_COLS * MAX_ROWS; idx++)
+        {
+            if(gameButtons[idx])
+                updateButtonPosition(idx);
+        }
+    }
+}
+
+void GuiIconGrid::updateEffects()
 {
+    particleBgImage.updateEffects();
+
+    //! counted and slided here as update() is not called for the TV and frames can be skipped
+    gameLaunchTimer++;
+
+    //! the slide changes which slots are loaded, elements must not be added or removed while drawing
     bool bUpdatePositions = false;
 
     if(currentLeftPosition < targetLeftPosition)
@@ -416,19 +555,26 @@ void GuiIconGrid::draw(CVideo *pVideo)
         bUpdatePositions = true;
     }
 
+    updateVisibleIcons();
+
     if(bUpdatePositions)
     {
         bUpdatePositions = false;
         updateButtonPositions();
     }
 
+    GuiFrame::updateEffects();
 
+    //! visited every frame for the launch timer and the slide
+    effectUpdateRequired = true;
+}
+
+void GuiIconGrid::draw(CVideo *pVideo)
+{
     //! the BG needs to be rendered to stencil
     pVideo->setStencilRender(true);
     particleBgImage.draw(pVideo);
     pVideo->setStencilRender(false);
 
     GuiFrame::draw(pVideo);
-
-    gameLaunchTimer++;
 }
@@ -35,7 +35,7 @@ public:
     void setSelectedGame(int idx);
     int getSelectedGame(void);
 
-    void update(GuiController * t);
+    void updateEffects();
     void draw(CVideo *pVideo);
 private:
     void OnLeftArrowClick(GuiButton *button, const GuiController *controller, GuiTrigger *trigger);
@@ -52,9 +52,18 @@ private:
     }
 
     void updateButtonPositions();
+    void updateButtonPosition(int idx);
+    void updateVisibleIcons();
+    void createGameButton(int idx);
+    void insertGameButton(GuiButton *button, int idx);
+    void releaseGameButton(int idx);
+    bool isPageLoaded(int page) const;
+    int getPageCount() const;
 
     static const int MAX_ROWS = 3;
     static const int MAX_COLS = 5;
+    //! pages left and right of the shown ones that keep their icons
+    static const int PAGE_MARGIN = 1;
 
     GuiSound *buttonClickSound;
     GuiImageData noIcon;
@@ -83,8 +92,13 @@ private:
     GuiButton arrowRightButton;
     GuiButton arrowLeftButton;
 
+    //! one entry per grid slot, NULL if the slot is not on a loaded page
     std::vector<GameIcon *> gameIcons;
     std::vector<GuiButton *> gameButtons;
+    //! buttons of unloaded slots ready for reuse
+    std::vector<GuiButton *> buttonPool;
+    //! loaded page ranges, around the shown pages and around the target page
+    int loadedPages[2][2];
     int listOffset;
     int selectedGame;
     int currentLeftPosition;
@@ -112,6 +112,7 @@ void GuiImage::setImageData(GuiImageData * img)
 		height = img->getHeight();
 	}
 	imgType = IMAGE_TEXTURE;
+	requestRedraw();
 }
 
 GX2Color GuiImage::getPixel(int x, int y)
@@ -140,6 +141,7 @@ void GuiImage::setPixel(int x, int y, const GX2Color & color)
     u32 pitch = imageData->getTexture()->surface.pitch;
     u32 *imagePtr = (u32*)imageData->getTexture()->surface.image_data;
     imagePtr[y * pitch + x] = (color.r << 24) | (color.g << 16)  | (color.b << 8)  | (color.a << 0);
+    requestRedraw();
 }
 
 void GuiImage::setImageColor(const GX2Color & c, int idx)
@@ -167,12 +169,14 @@ void GuiImage::setImageColor(const GX2Color & c, int idx)
         }
         colorVtxsDirty = true;
     }
+    requestRedraw();
 }
 
 void GuiImage::setSize(int w, int h)
 {
 	width = w;
 	height = h;
+	requestRedraw();
 }
 
 void GuiImage::setPrimitiveVertex(s32 prim, const f32 *posVtx, const f32 *texCoord, u32 vtxcount)
@@ -202,6 +206,7 @@ void GuiImage::setPrimitiveVertex(s32 prim, const f32 *posVtx, const f32 *texCoo
         colorCount = vtxCount;
         colorVtxsDirty = true;
     }
+    requestRedraw();
 }
 
 void GuiImage::draw(CVideo *pVideo)
@@ -261,6 +266,7 @@ void GuiImage::draw(CVideo *pVideo)
     if(colorVtxsDirty && colorVtxs) {
         //! flush color vertex only on main GX2 thread
         GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, colorVtxs, colorCount * ColorShader::cuColorAttrSize);
+        CProfiler::instance()->count(CProfiler::COUNTER_INVALIDATES);
         colorVtxsDirty = false;
     }
 
@@ -276,6 +282,11 @@ void GuiImage::draw(CVideo *pVideo)
 	}
     else if(imageData)
 	{
+        //! plain quads are collected and drawn together with the following ones of the same texture
+        if((!posVtxs || !texCoords) && primitive == GX2_PRIMITIVE_QUADS && vtxCount == 4 && imageAngle == 0.0f
+           && SpriteBatch::addQuad(imageData->getTexture(), imageData->getSampler(), positionOffsets, scaleFactor, colorIntensity, blurDirection))
+            return;
+
         Texture2DShader::instance()->setShaders();
         Texture2DShader::instance()->setAttributeBuffer(texCoords, posVtxs, vtxCount);
         Texture2DShader::instance()->setAngle(imageAngle);
@@ -77,11 +77,13 @@ public:
     {
         if(dir < 2) {
             blurDirection[dir] = value;
+            requestRedraw();
         }
     }
     void setColorIntensity(const glm::vec4 & col)
     {
         colorIntensity = col;
+        requestRedraw();
     }
 protected:
     void internalInit(int w, int h);
@@ -16,7 +16,7 @@
  ****************************************************************************/
 #include <unistd.h>
 #include "GuiImageAsync.h"
-#include "fs/fs_utils.h"
+#include "resources/TextureCache.h"
 
 std::vector<GuiImageAsync *> GuiImageAsync::imageQueue;
 CThread * GuiImageAsync::pThread = NULL;
@@ -30,6 +30,7 @@ GuiImageAsync::GuiImageAsync(const u8 *imageBuffer, const u32 & imageBufferSize,
 	, imgData(NULL)
 	, imgBuffer(imageBuffer)
 	, imgBufferSize(imageBufferSize)
+	, bLoadFinished(false)
 {
 	threadInit();
 	threadAddImage(this);
@@ -41,6 +42,7 @@ GuiImageAsync::GuiImageAsync(const std::string & file, GuiImageData * preloadImg
 	, filename(file)
 	, imgBuffer(NULL)
 	, imgBufferSize(0)
+	, bLoadFinished(false)
 {
 	threadInit();
 	threadAddImage(this);
@@ -53,7 +55,13 @@ GuiImageAsync::~GuiImageAsync()
         usleep(1000);
 
 	if (imgData)
-        delete imgData;
+    {
+        //! file textures are owned by the texture cache
+        if(imgBuffer)
+            delete imgData;
+        else
+            TextureCache::instance()->release(imgData);
+    }
 
     threadExit();
 }
@@ -108,37 +116,27 @@ void GuiImageAsync::guiImageAsyncThread(CThread *thread, void *arg)
             if(pInUse->imgBuffer && pInUse->imgBufferSize)
             {
                 pInUse->imgData = new GuiImageData(pInUse->imgBuffer, pInUse->imgBufferSize);
-            }
-            else
-            {
-                u8 *buffer = NULL;
-                u32 bufferSize = 0;
 
-                int iResult = LoadFileToMem(pInUse->filename.c_str(), &buffer, &bufferSize);
-                if(iResult > 0)
+                if(!pInUse->imgData->getTexture())
                 {
-                    pInUse->imgData = new GuiImageData(buffer, bufferSize, GX2_TEX_CLAMP_MIRROR);
-
-                    //! free original image buffer which is converted to texture now and not needed anymore
-                    free(buffer);
+                    delete pInUse->imgData;
+                    pInUse->imgData = NULL;
                 }
             }
+            else
+            {
+                pInUse->imgData = TextureCache::instance()->acquire(pInUse->filename, GX2_TEX_CLAMP_MIRROR);
+            }
 
             if(pInUse->imgData)
             {
-                if(pInUse->imgData->getTexture())
-                {
-                    pInUse->width = pInUse->imgData->getWidth();
-                    pInUse->height = pInUse->imgData->getHeight();
-                    pInUse->imageData = pInUse->imgData;
-                }
-                else
-                {
-                    delete pInUse->imgData;
-                    pInUse->imgData = NULL;
-                }
+                pInUse->width = pInUse->imgData->getWidth();
+                pInUse->height = pInUse->imgData->getHeight();
+                pInUse->imageData = pInUse->imgData;
+                requestRedraw();
             }
 
+            pInUse->bLoadFinished = true;
 			pInUse = NULL;
 		}
 	}
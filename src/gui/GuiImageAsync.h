@@ -30,6 +30,9 @@ class GuiImageAsync : public GuiImage
 		GuiImageAsync(const std::string & filename, GuiImageData * preloadImg);
 		virtual ~GuiImageAsync();
 
+		//!\return true once the loader thread is done with the image, loading may have failed
+		bool isLoadFinished() const { return bLoadFinished; }
+
 		static void clearQueue();
 		static void removeFromQueue(GuiImageAsync * image) {
 		    threadRemoveImage(image);
@@ -42,6 +45,7 @@ class GuiImageAsync : public GuiImage
 	    std::string filename;
 	    const u8 *imgBuffer;
 	    const u32 imgBufferSize;
+	    volatile bool bLoadFinished;
 
 		static void guiImageAsyncThread(CThread *thread, void *arg);
 		static void threadAddImage(GuiImageAsync* Image);
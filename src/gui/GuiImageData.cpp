@@ -18,6 +18,7 @@
 #include <string.h>
 #include "GuiImageData.h"
 #include "system/memory.h"
+#include "utils/utils.h"
 /**
  * Constructor for the GuiImageData class.
  */
@@ -112,6 +113,44 @@ void GuiImageData::loadImage(const u8 *img, int imgSize, int textureClamp, int t
 	u32 width = (gdImageSX(gdImg));
 	u32 height = (gdImageSY(gdImg));
 
+    //! images without transparency do not need the alpha block
+    if(textureFormat == GX2_SURFACE_FORMAT_T_BC3_UNORM && !gdImageHasAlpha(gdImg))
+        textureFormat = GX2_SURFACE_FORMAT_T_BC1_UNORM;
+
+    //! Initialize texture
+    if(!createTexture(width, height, textureFormat)) {
+        gdImageDestroy(gdImg);
+        return;
+    }
+
+    //! convert image to texture
+    switch(textureFormat)
+    {
+    default:
+    case GX2_SURFACE_FORMAT_TCS_R8_G8_B8_A8_UNORM:
+        gdImageToUnormR8G8B8A8(gdImg, (u32*)texture->surface.image_data, texture->surface.width, texture->surface.height, texture->surface.pitch);
+        break;
+    case GX2_SURFACE_FORMAT_TCS_R5_G6_B5_UNORM:
+        gdImageToUnormR5G6B5(gdImg, (u16*)texture->surface.image_data, texture->surface.width, texture->surface.height, texture->surface.pitch);
+        break;
+    case GX2_SURFACE_FORMAT_T_BC1_UNORM:
+        gdImageToBC1(gdImg, (u8*)texture->surface.image_data, texture->surface.width, texture->surface.height, texture->surface.pitch);
+        break;
+    case GX2_SURFACE_FORMAT_T_BC3_UNORM:
+        gdImageToBC3(gdImg, (u8*)texture->surface.image_data, texture->surface.width, texture->surface.height, texture->surface.pitch);
+        break;
+    }
+
+	//! free memory of image as its not needed anymore
+	gdImageDestroy(gdImg);
+
+    finishTexture(textureClamp);
+}
+
+bool GuiImageData::createTexture(u32 width, u32 height, int textureFormat)
+{
+    releaseData();
+
     //! Initialize texture
     texture = new GX2Texture;
     GX2InitTexture(texture, width,  height, 1, 0, textureFormat, GX2_SURFACE_DIM_2D, GX2_TILE_MODE_LINEAR_ALIGNED);
@@ -120,8 +159,7 @@ void GuiImageData::loadImage(const u8 *img, int imgSize, int textureClamp, int t
     if(texture->surface.image_size == 0) {
         delete texture;
         texture = NULL;
-        gdImageDestroy(gdImg);
-        return;
+        return false;
     }
 
     //! allocate memory for the surface
@@ -139,27 +177,19 @@ void GuiImageData::loadImage(const u8 *img, int imgSize, int textureClamp, int t
     }
     //! check if memory is available for image
     if(!texture->surface.image_data) {
-        gdImageDestroy(gdImg);
         delete texture;
         texture = NULL;
-        return;
+        return false;
     }
     //! set mip map data pointer
     texture->surface.mip_data = NULL;
-    //! convert image to texture
-    switch(textureFormat)
-    {
-    default:
-    case GX2_SURFACE_FORMAT_TCS_R8_G8_B8_A8_UNORM:
-        gdImageToUnormR8G8B8A8(gdImg, (u32*)texture->surface.image_data, texture->surface.width, texture->surface.height, texture->surface.pitch);
-        break;
-    case GX2_SURFACE_FORMAT_TCS_R5_G6_B5_UNORM:
-        gdImageToUnormR5G6B5(gdImg, (u16*)texture->surface.image_data, texture->surface.width, texture->surface.height, texture->surface.pitch);
-        break;
-    }
+    return true;
+}
 
-	//! free memory of image as its not needed anymore
-	gdImageDestroy(gdImg);
+void GuiImageData::finishTexture(int textureClamp)
+{
+    if(!texture)
+        return;
 
 	//! invalidate the memory
     GX2Invalidate(GX2_INVALIDATE_CPU_TEXTURE, texture->surface.image_data, texture->surface.image_size);
@@ -188,7 +218,7 @@ void GuiImageData::gdImageToUnormR8G8B8A8(gdImagePtr gdImg, u32 *imgBuffer, u32
     }
 }
 
-//! TODO: figure out why this seems to not work correct yet
+//! the 16 bit formats are read with the red channel in the low bits
 void GuiImageData::gdImageToUnormR5G6B5(gdImagePtr gdImg, u16 *imgBuffer, u32 width, u32 height, u32 pitch)
 {
     for(u32 y = 0; y < height; ++y)
@@ -201,7 +231,205 @@ void GuiImageData::gdImageToUnormR5G6B5(gdImagePtr gdImg, u16 *imgBuffer, u32 wi
             u8 g = gdImageGreen(gdImg, pixel);
             u8 b = gdImageBlue(gdImg, pixel);
 
-            imgBuffer[y * pitch + x] = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+            imgBuffer[y * pitch + x] = ((b >> 3) << 11) | ((g >> 2) << 5) | (r >> 3);
+        }
+    }
+}
+
+bool GuiImageData::gdImageHasAlpha(gdImagePtr gdImg)
+{
+    u32 width = gdImageSX(gdImg);
+    u32 height = gdImageSY(gdImg);
+
+    for(u32 y = 0; y < height; ++y)
+    {
+        for(u32 x = 0; x < width; ++x)
+        {
+            if(gdImageAlpha(gdImg, gdImageGetPixel(gdImg, x, y)) != 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+//! read a 4x4 block of RGBA pixels, pixels outside of the image repeat the border
+static void gdImageGetBlock(gdImagePtr gdImg, u32 blockX, u32 blockY, u32 width, u32 height, u8 block[16][4])
+{
+    for(u32 i = 0; i < 16; ++i)
+    {
+        u32 x = blockX * 4 + (i & 3);
+        u32 y = blockY * 4 + (i >> 2);
+        if(x >= width)  x = width - 1;
+        if(y >= height) y = height - 1;
+
+        u32 pixel = gdImageGetPixel(gdImg, x, y);
+
+        u8 a = 254 - 2*((u8)gdImageAlpha(gdImg, pixel));
+        if(a == 254) a++;
+
+        block[i][0] = gdImageRed(gdImg, pixel);
+        block[i][1] = gdImageGreen(gdImg, pixel);
+        block[i][2] = gdImageBlue(gdImg, pixel);
+        block[i][3] = a;
+    }
+}
+
+static inline u16 rgbToRgb565(const u8 *rgb)
+{
+    return (((rgb[0] * 31 + 127) / 255) << 11) | (((rgb[1] * 63 + 127) / 255) << 5) | ((rgb[2] * 31 + 127) / 255);
+}
+
+static inline void rgb565ToRgb(u16 color, int *rgb)
+{
+    int r = (color >> 11) & 0x1F;
+    int g = (color >> 5) & 0x3F;
+    int b = color & 0x1F;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+//! BC1 color block (DXT1), endpoints from the inset bounding box of the block colors
+static void encodeColorBlock(const u8 block[16][4], u8 *dst)
+{
+    u8 minColor[3] = { 255, 255, 255 };
+    u8 maxColor[3] = { 0, 0, 0 };
+    int mean[3] = { 0, 0, 0 };
+
+    for(int i = 0; i < 16; ++i)
+    {
+        for(int c = 0; c < 3; ++c)
+        {
+            if(block[i][c] < minColor[c]) minColor[c] = block[i][c];
+            if(block[i][c] > maxColor[c]) maxColor[c] = block[i][c];
+            mean[c] += block[i][c];
+        }
+    }
+
+    //! choose the bounding box diagonal which follows the color distribution
+    int covRG = 0, covBG = 0;
+    for(int i = 0; i < 16; ++i)
+    {
+        int g = block[i][1] * 16 - mean[1];
+        covRG += (block[i][0] * 16 - mean[0]) * g;
+        covBG += (block[i][2] * 16 - mean[2]) * g;
+    }
+    if(covRG < 0) { u8 tmp = minColor[0]; minColor[0] = maxColor[0]; maxColor[0] = tmp; }
+    if(covBG < 0) { u8 tmp = minColor[2]; minColor[2] = maxColor[2]; maxColor[2] = tmp; }
+
+    //! inset the box to reduce the error of the end points
+    for(int c = 0; c < 3; ++c)
+    {
+        int inset = ((int)maxColor[c] - (int)minColor[c]) / 16;
+        maxColor[c] = LIMIT((int)maxColor[c] - inset, 0, 255);
+        minColor[c] = LIMIT((int)minColor[c] + inset, 0, 255);
+    }
+
+    u16 color0 = rgbToRgb565(maxColor);
+    u16 color1 = rgbToRgb565(minColor);
+
+    //! four color mode requires color0 > color1
+    if(color0 < color1) { u16 tmp = color0; color0 = color1; color1 = tmp; }
+
+    u32 indices = 0;
+
+    if(color0 != color1)
+    {
+        int palette[4][3];
+        rgb565ToRgb(color0, palette[0]);
+        rgb565ToRgb(color1, palette[1]);
+        for(int c = 0; c < 3; ++c)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for(int i = 15; i >= 0; --i)
+        {
+            int best = 0;
+            int bestDist = 0x7FFFFFFF;
+            for(int p = 0; p < 4; ++p)
+            {
+                int dr = block[i][0] - palette[p][0];
+                int dg = block[i][1] - palette[p][1];
+                int db = block[i][2] - palette[p][2];
+                int dist = dr * dr + dg * dg + db * db;
+                if(dist < bestDist) { bestDist = dist; best = p; }
+            }
+            indices = (indices << 2) | best;
+        }
+    }
+
+    //! block data is little endian
+    dst[0] = color0 & 0xFF;
+    dst[1] = color0 >> 8;
+    dst[2] = color1 & 0xFF;
+    dst[3] = color1 >> 8;
+    dst[4] = indices & 0xFF;
+    dst[5] = (indices >> 8) & 0xFF;
+    dst[6] = (indices >> 16) & 0xFF;
+    dst[7] = indices >> 24;
+}
+
+//! BC3 alpha block, eight interpolated values between the block min and max
+static void encodeAlphaBlock(const u8 block[16][4], u8 *dst)
+{
+    u8 minAlpha = 255;
+    u8 maxAlpha = 0;
+
+    for(int i = 0; i < 16; ++i)
+    {
+        if(block[i][3] < minAlpha) minAlpha = block[i][3];
+        if(block[i][3] > maxAlpha) maxAlpha = block[i][3];
+    }
+
+    u64 indices = 0;
+    int range = maxAlpha - minAlpha;
+
+    if(range > 0)
+    {
+        for(int i = 15; i >= 0; --i)
+        {
+            //! position on the min to max line in 1/7 steps
+            int pos = ((block[i][3] - minAlpha) * 7 + range / 2) / range;
+            int index = (pos == 7) ? 0 : ((pos == 0) ? 1 : (8 - pos));
+            indices = (indices << 3) | index;
+        }
+    }
+
+    dst[0] = maxAlpha;
+    dst[1] = minAlpha;
+    for(int i = 0; i < 6; ++i)
+        dst[2 + i] = (indices >> (i * 8)) & 0xFF;
+}
+
+//! the surface pitch of compressed formats is counted in 4x4 blocks
+void GuiImageData::gdImageToBC1(gdImagePtr gdImg, u8 *imgBuffer, u32 width, u32 height, u32 pitch)
+{
+    u8 block[16][4];
+
+    for(u32 by = 0; by < (height + 3) / 4; ++by)
+    {
+        for(u32 bx = 0; bx < (width + 3) / 4; ++bx)
+        {
+            gdImageGetBlock(gdImg, bx, by, width, height, block);
+            encodeColorBlock(block, imgBuffer + (by * pitch + bx) * 8);
+        }
+    }
+}
+
+void GuiImageData::gdImageToBC3(gdImagePtr gdImg, u8 *imgBuffer, u32 width, u32 height, u32 pitch)
+{
+    u8 block[16][4];
+
+    for(u32 by = 0; by < (height + 3) / 4; ++by)
+    {
+        for(u32 bx = 0; bx < (width + 3) / 4; ++bx)
+        {
+            u8 *dst = imgBuffer + (by * pitch + bx) * 16;
+            gdImageGetBlock(gdImg, bx, by, width, height, block);
+            encodeAlphaBlock(block, dst);
+            encodeColorBlock(block, dst + 8);
         }
     }
 }
@@ -35,7 +35,15 @@ public:
     //!Load image from buffer
     //!\param img Image data
     //!\param imgSize The image size
+    //!\param textureFormat BC3 falls back to BC1 for images without transparency
     void loadImage(const u8 * img, int imgSize, int textureClamp = GX2_TEX_CLAMP_CLAMP, int textureFormat = GX2_SURFACE_FORMAT_TCS_R8_G8_B8_A8_UNORM);
+    //!Allocate an empty texture surface which is filled by the caller
+    //!\param width The image width
+    //!\param height The image height
+    //!\return true if the surface memory could be allocated
+    bool createTexture(u32 width, u32 height, int textureFormat = GX2_SURFACE_FORMAT_TCS_R8_G8_B8_A8_UNORM);
+    //!Flush the filled surface and setup the sampler
+    void finishTexture(int textureClamp = GX2_TEX_CLAMP_CLAMP);
     //! getter functions
     const GX2Texture * getTexture() const { return texture; };
     const GX2Sampler * getSampler() const { return sampler; };
@@ -50,6 +58,9 @@ public:
 private:
     void gdImageToUnormR8G8B8A8(gdImagePtr gdImg, u32 *imgBuffer, u32 width, u32 height, u32 pitch);
     void gdImageToUnormR5G6B5(gdImagePtr gdImg, u16 *imgBuffer, u32 width, u32 height, u32 pitch);
+    void gdImageToBC1(gdImagePtr gdImg, u8 *imgBuffer, u32 width, u32 height, u32 pitch);
+    void gdImageToBC3(gdImagePtr gdImg, u8 *imgBuffer, u32 width, u32 height, u32 pitch);
+    static bool gdImageHasAlpha(gdImagePtr gdImg);
 
     GX2Texture *texture;
     GX2Sampler *sampler;
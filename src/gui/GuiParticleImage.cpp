@@ -19,6 +19,10 @@
 #include "video/shaders/ColorShader.h"
 
 #define CIRCLE_VERTEX_COUNT     36
+#define CIRCLE_INDEX_COUNT      ((CIRCLE_VERTEX_COUNT - 2) * 3)
+
+static f32 circleCos[CIRCLE_VERTEX_COUNT];
+static f32 circleSin[CIRCLE_VERTEX_COUNT];
 
 static inline f32 getRandZeroToOneF32()
 {
@@ -30,99 +34,185 @@ static inline f32 getRandMinusOneToOneF32()
     return getRandZeroToOneF32() * 2.0f - 1.0f;
 }
 
-GuiParticleImage::GuiParticleImage(int w, int h, u32 particleCount)
+GuiParticleImage::GuiParticleImage(int w, int h, u32 count)
     : GuiImage(NULL)
 {
     width = w;
     height = h;
 	imgType = IMAGE_COLOR;
+	particleCount = count;
+	currentBuffer = 0;
+	bVertexUpdate = true;
 
-    posVertexs = (f32 *) memalign(GX2_VERTEX_BUFFER_ALIGNMENT, ColorShader::cuVertexAttrSize * CIRCLE_VERTEX_COUNT);
-    colorVertexs = (u8 *) memalign(GX2_VERTEX_BUFFER_ALIGNMENT, ColorShader::cuColorAttrSize * CIRCLE_VERTEX_COUNT);
+	//! the particles never stop, a screen showing them is not idle
+	effectUpdateRequired = true;
 
     for(u32 i = 0; i < CIRCLE_VERTEX_COUNT; i++)
     {
-        posVertexs[i * 3 + 0] = cosf(DegToRad(i * 360.0f / CIRCLE_VERTEX_COUNT));
-        posVertexs[i * 3 + 1] = sinf(DegToRad(i * 360.0f / CIRCLE_VERTEX_COUNT));
-        posVertexs[i * 3 + 2] = 0.0f;
-
-        colorVertexs[i * 4 + 0] = 0xff;
-        colorVertexs[i * 4 + 1] = 0xff;
-        colorVertexs[i * 4 + 2] = 0xff;
-        colorVertexs[i * 4 + 3] = 0xff;
+        circleCos[i] = cosf(DegToRad(i * 360.0f / CIRCLE_VERTEX_COUNT));
+        circleSin[i] = sinf(DegToRad(i * 360.0f / CIRCLE_VERTEX_COUNT));
+    }
+
+    for(u32 n = 0; n < cuVertexBufferCount; n++)
+    {
+        posVertexs[n] = (f32 *) memalign(GX2_VERTEX_BUFFER_ALIGNMENT, ColorShader::cuVertexAttrSize * CIRCLE_VERTEX_COUNT * particleCount);
+        colorVertexs[n] = (u8 *) memalign(GX2_VERTEX_BUFFER_ALIGNMENT, ColorShader::cuColorAttrSize * CIRCLE_VERTEX_COUNT * particleCount);
+    }
+
+    //! every circle is a triangle fan around its first vertex, all of them are drawn as one triangle list
+    indices = (u32 *) memalign(GX2_VERTEX_BUFFER_ALIGNMENT, CIRCLE_INDEX_COUNT * particleCount * sizeof(u32));
+    if(indices)
+    {
+        for(u32 i = 0, n = 0; i < particleCount; i++)
+        {
+            u32 base = i * CIRCLE_VERTEX_COUNT;
+
+            for(u32 v = 1; v < (CIRCLE_VERTEX_COUNT - 1); v++)
+            {
+                indices[n++] = base;
+                indices[n++] = base + v;
+                indices[n++] = base + v + 1;
+            }
+        }
+        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, indices, CIRCLE_INDEX_COUNT * particleCount * sizeof(u32));
     }
-    GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, posVertexs, ColorShader::cuVertexAttrSize * CIRCLE_VERTEX_COUNT);
-    GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, colorVertexs, ColorShader::cuColorAttrSize * CIRCLE_VERTEX_COUNT);
 
-    particles.resize(particleCount);
+    positionX.resize(particleCount);
+    positionY.resize(particleCount);
+    alpha.resize(particleCount);
+    radius.resize(particleCount);
+    speed.resize(particleCount);
+    direction.resize(particleCount);
 
     for(u32 i = 0; i < particleCount; i++)
     {
-        particles[i].position.x = getRandMinusOneToOneF32() * getWidth() * 0.5f;
-        particles[i].position.y = getRandMinusOneToOneF32() * getHeight() * 0.5f;
-        particles[i].position.z = 0.0f;
-        particles[i].colors = glm::vec4(1.0f, 1.0f, 1.0f, (getRandZeroToOneF32() * 0.6f) + 0.05f);
-        particles[i].radius = getRandZeroToOneF32() * 30.0f;
-        particles[i].speed = (getRandZeroToOneF32() * 0.6f) + 0.2f;
-        particles[i].direction = getRandMinusOneToOneF32();
+        resetParticle(i);
+        positionY[i] = getRandMinusOneToOneF32() * getHeight() * 0.5f;
     }
 }
 
 GuiParticleImage::~GuiParticleImage()
 {
-    free(posVertexs);
-    free(colorVertexs);
+    for(u32 n = 0; n < cuVertexBufferCount; n++)
+    {
+        free(posVertexs[n]);
+        free(colorVertexs[n]);
+    }
+    free(indices);
 }
 
-void GuiParticleImage::draw(CVideo *pVideo)
+void GuiParticleImage::resetParticle(u32 i)
 {
-	if(!this->isVisible())
-		return;
+    positionX[i] = getRandMinusOneToOneF32() * getWidth() * 0.5f;
+    positionY[i] = -getHeight() * 0.5f - 30.0f;
+    alpha[i] = (getRandZeroToOneF32() * 0.6f) + 0.05f;
+    radius[i] = getRandZeroToOneF32() * 30.0f;
+    speed[i] = (getRandZeroToOneF32() * 0.6f) + 0.2f;
+    direction[i] = getRandMinusOneToOneF32();
+}
 
+void GuiParticleImage::updateParticles(void)
+{
+    const f32 limitTop = getHeight() * 0.5f + 30.0f;
+    const f32 limitLeft = -getWidth() * 0.5f - 50.0f;
 
-	f32 currScaleX = getScaleX();
-	f32 currScaleY = getScaleY();
+    for(u32 i = 0; i < particleCount; ++i)
+    {
+        if(positionY[i] > limitTop)
+            resetParticle(i);
 
-    positionOffsets[2] = getDepth() * pVideo->getDepthScaleFactor() * 2.0f;
+        if(positionX[i] < limitLeft)
+            positionX[i] = -positionX[i];
 
-    scaleFactor[2] = getScaleZ();
+        direction[i] += getRandMinusOneToOneF32() * 0.03f;
+        positionX[i] += speed[i] * direction[i];
+        positionY[i] += speed[i];
+    }
+}
 
-    //! add other colors intensities parameters
-    colorIntensity[3] = getAlpha();
+void GuiParticleImage::updateVertexBuffer(f32 *posVtxs, u8 *colorVtxs)
+{
+	f32 currScaleX = getScaleX();
+	f32 currScaleY = getScaleY();
 
-    for(u32 i = 0; i < particles.size(); ++i)
+    //! positions are in pixels relative to the center of the element and doubled like the offsets
+    //! of the other images, the screen scale factor is applied by the shader
+    for(u32 i = 0; i < particleCount; ++i)
     {
-        if(particles[i].position.y > (getHeight() * 0.5f + 30.0f))
-        {
-            particles[i].position.x = getRandMinusOneToOneF32() * getWidth() * 0.5f;
-            particles[i].position.y = -getHeight() * 0.5f - 30.0f;
-            particles[i].colors = glm::vec4(1.0f, 1.0f, 1.0f, (getRandZeroToOneF32() * 0.6f) + 0.05f);
-            particles[i].radius = getRandZeroToOneF32() * 30.0f;
-            particles[i].speed = (getRandZeroToOneF32() * 0.6f) + 0.2f;
-            particles[i].direction = getRandMinusOneToOneF32();
-        }
-        if(particles[i].position.x < (-getWidth() * 0.5f - 50.0f))
+        f32 centerX = positionX[i] * 2.0f;
+        f32 centerY = positionY[i] * 2.0f;
+        f32 radiusX = currScaleX * radius[i];
+        f32 radiusY = currScaleY * radius[i];
+        u8 particleAlpha = (u8)(alpha[i] * 255.0f);
+
+        for(u32 v = 0; v < CIRCLE_VERTEX_COUNT; v++)
         {
-            particles[i].position.x = -particles[i].position.x;
+            *posVtxs++ = centerX + circleCos[v] * radiusX;
+            *posVtxs++ = centerY + circleSin[v] * radiusY;
+            *posVtxs++ = 0.0f;
+
+            *colorVtxs++ = 0xff;
+            *colorVtxs++ = 0xff;
+            *colorVtxs++ = 0xff;
+            *colorVtxs++ = particleAlpha;
         }
+    }
+}
 
+void GuiParticleImage::updateEffects()
+{
+    GuiImage::updateEffects();
+
+    updateParticles();
+    bVertexUpdate = true;
+    requestRedraw();
+
+    effectUpdateRequired = true;
+}
+
+void GuiParticleImage::draw(CVideo *pVideo)
+{
+	if(!this->isVisible())
+		return;
 
-        particles[i].direction += getRandMinusOneToOneF32() * 0.03f;
-        particles[i].position.x += particles[i].speed * particles[i].direction;
-        particles[i].position.y += particles[i].speed;
+    if(bVertexUpdate)
+    {
+        currentBuffer = (currentBuffer + 1) % cuVertexBufferCount;
 
-        positionOffsets[0] = (getCenterX() + particles[i].position.x) * pVideo->getWidthScaleFactor() * 2.0f;
-        positionOffsets[1] = (getCenterY() + particles[i].position.y) * pVideo->getHeightScaleFactor() * 2.0f;
+        if(!posVertexs[currentBuffer] || !colorVertexs[currentBuffer])
+            return;
 
-        scaleFactor[0] = currScaleX * particles[i].radius * pVideo->getWidthScaleFactor();
-        scaleFactor[1] = currScaleY * particles[i].radius * pVideo->getHeightScaleFactor();
+        updateVertexBuffer(posVertexs[currentBuffer], colorVertexs[currentBuffer]);
+        bVertexUpdate = false;
 
-        ColorShader::instance()->setShaders();
-        ColorShader::instance()->setAttributeBuffer(colorVertexs, posVertexs, CIRCLE_VERTEX_COUNT);
-        ColorShader::instance()->setAngle(0.0f);
-        ColorShader::instance()->setOffset(positionOffsets);
-        ColorShader::instance()->setScale(scaleFactor);
-        ColorShader::instance()->setColorIntensity(colorIntensity * particles[i].colors);
-        ColorShader::instance()->draw(GX2_PRIMITIVE_TRIANGLE_FAN, CIRCLE_VERTEX_COUNT);
+        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, posVertexs[currentBuffer], ColorShader::cuVertexAttrSize * CIRCLE_VERTEX_COUNT * particleCount);
+        GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, colorVertexs[currentBuffer], ColorShader::cuColorAttrSize * CIRCLE_VERTEX_COUNT * particleCount);
+        CProfiler::instance()->count(CProfiler::COUNTER_INVALIDATES, 2);
     }
+
+    f32 *posVtxs = posVertexs[currentBuffer];
+    u8 *colorVtxs = colorVertexs[currentBuffer];
+
+    if(!posVtxs || !colorVtxs || !indices)
+        return;
+
+    positionOffsets[0] = getCenterX() * pVideo->getWidthScaleFactor() * 2.0f;
+    positionOffsets[1] = getCenterY() * pVideo->getHeightScaleFactor() * 2.0f;
+    positionOffsets[2] = getDepth() * pVideo->getDepthScaleFactor() * 2.0f;
+
+    scaleFactor[0] = pVideo->getWidthScaleFactor();
+    scaleFactor[1] = pVideo->getHeightScaleFactor();
+    scaleFactor[2] = getScaleZ();
+
+    //! add other colors intensities parameters
+    colorIntensity[3] = getAlpha();
+
+    ColorShader::instance()->setShaders();
+    ColorShader::instance()->setAttributeBuffer(colorVtxs, posVtxs, CIRCLE_VERTEX_COUNT * particleCount);
+    ColorShader::instance()->setAngle(0.0f);
+    ColorShader::instance()->setOffset(positionOffsets);
+    ColorShader::instance()->setScale(scaleFactor);
+    ColorShader::instance()->setColorIntensity(colorIntensity);
+    CProfiler::instance()->count(CProfiler::COUNTER_DRAWS);
+    GX2DrawIndexedEx(GX2_PRIMITIVE_TRIANGLES, CIRCLE_INDEX_COUNT * particleCount, GX2_INDEX_FORMAT_U32, indices, 0, 1);
 }
@@ -26,20 +26,29 @@ public:
     virtual ~GuiParticleImage();
 
     void draw(CVideo *pVideo);
+    void updateEffects();
 private:
-    f32 *posVertexs;
-    u8 *colorVertexs;
+    void resetParticle(u32 idx);
+    void updateParticles(void);
+    void updateVertexBuffer(f32 *posVtxs, u8 *colorVtxs);
 
-    typedef struct
-    {
-        glm::vec3 position;
-        glm::vec4 colors;
-        f32 radius;
-        f32 speed;
-        f32 direction;
-    } Particle;
+    //! vertex buffers are rewritten on every drawn move, the GPU may still read the previous ones
+    static const u32 cuVertexBufferCount = 4;
 
-    std::vector<Particle> particles;
+    f32 *posVertexs[cuVertexBufferCount];
+    u8 *colorVertexs[cuVertexBufferCount];
+    u32 *indices;
+    u32 currentBuffer;
+    u32 particleCount;
+    bool bVertexUpdate;
+
+    //! particle state as separate arrays for a tight update loop
+    std::vector<f32> positionX;
+    std::vector<f32> positionY;
+    std::vector<f32> alpha;
+    std::vector<f32> radius;
+    std::vector<f32> speed;
+    std::vector<f32> direction;
 };
 
 #endif // _GUI_ICON_GRID_H_
@@ -58,7 +58,7 @@ bool GuiSound::Load(const char * filepath)
             if(decoder)
             {
                 voice = i;
-                SoundHandler::instance()->ThreadSignal();
+                SoundHandler::instance()->RequestDecode(voice);
             }
             break;
         }
@@ -89,7 +89,7 @@ bool GuiSound::Load(const u8 * snd, s32 len)
             if(decoder)
             {
                 voice = i;
-                SoundHandler::instance()->ThreadSignal();
+                SoundHandler::instance()->RequestDecode(voice);
             }
             break;
         }
@@ -130,7 +130,7 @@ void GuiSound::Stop()
         decoder->Lock();
         decoder->Rewind();
         decoder->ClearBuffer();
-        SoundHandler::instance()->ThreadSignal();
+        SoundHandler::instance()->RequestDecode(voice);
         decoder->Unlock();
     }
 }
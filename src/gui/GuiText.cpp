@@ -47,12 +47,19 @@ GuiText::GuiText()
 	font = presentFont;
 	linestodraw = MAX_LINES_TO_DRAW;
 	textScrollPos = 0;
+	textScrollFrames = 0;
 	textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
 	textScrollDelay = TEXT_SCROLL_DELAY;
 	defaultBlur = 4.0f;
 	blurGlowIntensity = 0.0f;
 	blurAlpha = 0.0f;
 	blurGlowColor = glm::vec4(0.0f);
+	glyphQuadsDirty = true;
+	glyphQuadsSize = 0;
+	glyphQuadsAlignment = 0;
+	glyphQuadsGeneration = 0;
+	charWidthsSize = 0;
+	scrollGapWidth = 0;
 }
 
 GuiText::GuiText(const char * t, int s, const glm::vec4 & c)
@@ -69,12 +76,19 @@ GuiText::GuiText(const char * t, int s, const glm::vec4 & c)
 	font = presentFont;
 	linestodraw = MAX_LINES_TO_DRAW;
 	textScrollPos = 0;
+	textScrollFrames = 0;
 	textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
 	textScrollDelay = TEXT_SCROLL_DELAY;
 	defaultBlur = 4.0f;
 	blurGlowIntensity = 0.0f;
 	blurAlpha = 0.0f;
 	blurGlowColor = glm::vec4(0.0f);
+	glyphQuadsDirty = true;
+	glyphQuadsSize = 0;
+	glyphQuadsAlignment = 0;
+	glyphQuadsGeneration = 0;
+	charWidthsSize = 0;
+	scrollGapWidth = 0;
 
 	if(t)
 	{
@@ -100,12 +114,19 @@ GuiText::GuiText(const wchar_t * t, int s, const glm::vec4 & c)
 	font = presentFont;
 	linestodraw = MAX_LINES_TO_DRAW;
 	textScrollPos = 0;
+	textScrollFrames = 0;
 	textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
 	textScrollDelay = TEXT_SCROLL_DELAY;
 	defaultBlur = 4.0f;
 	blurGlowIntensity = 0.0f;
 	blurAlpha = 0.0f;
 	blurGlowColor = glm::vec4(0.0f);
+	glyphQuadsDirty = true;
+	glyphQuadsSize = 0;
+	glyphQuadsAlignment = 0;
+	glyphQuadsGeneration = 0;
+	charWidthsSize = 0;
+	scrollGapWidth = 0;
 
 	if(t)
 	{
@@ -136,12 +157,19 @@ GuiText::GuiText(const char * t)
 	font = presentFont;
 	linestodraw = MAX_LINES_TO_DRAW;
 	textScrollPos = 0;
+	textScrollFrames = 0;
 	textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
 	textScrollDelay = TEXT_SCROLL_DELAY;
 	defaultBlur = 4.0f;
 	blurGlowIntensity = 0.0f;
 	blurAlpha = 0.0f;
 	blurGlowColor = glm::vec4(0.0f);
+	glyphQuadsDirty = true;
+	glyphQuadsSize = 0;
+	glyphQuadsAlignment = 0;
+	glyphQuadsGeneration = 0;
+	charWidthsSize = 0;
+	scrollGapWidth = 0;
 
 	if(t)
 	{
@@ -173,6 +201,7 @@ void GuiText::setText(const char * t)
 	text = NULL;
 
 	clearDynamicText();
+	charWidthsSize = 0;
 
 	textScrollPos = 0;
 	textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
@@ -217,6 +246,7 @@ void GuiText::setText(const wchar_t * t)
 	text = NULL;
 
 	clearDynamicText();
+	charWidthsSize = 0;
 
 	textScrollPos = 0;
 	textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
@@ -242,6 +272,8 @@ void GuiText::clearDynamicText()
 	}
 	textDyn.clear();
 	textDynWidth.clear();
+	glyphQuadsDirty = true;
+	requestRedraw();
 }
 
 void GuiText::setPresets(int sz, const glm::vec4 & c, int w, int a)
@@ -260,6 +292,7 @@ void GuiText::setPresetFont(FreeTypeGX *f)
 void GuiText::setFontSize(int s)
 {
 	size = s;
+	requestRedraw();
 }
 
 void GuiText::setMaxWidth(int width, int w)
@@ -270,8 +303,10 @@ void GuiText::setMaxWidth(int width, int w)
 	if(w == SCROLL_HORIZONTAL)
 	{
 		textScrollPos = 0;
+		textScrollFrames = 0;
 		textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
 		textScrollDelay = TEXT_SCROLL_DELAY;
+		requireEffectUpdate();
 	}
 
 	clearDynamicText();
@@ -281,6 +316,7 @@ void GuiText::setColor(const glm::vec4 & c)
 {
 	color = c;
 	alpha = c[3];
+	requestRedraw();
 }
 
 void GuiText::setBlurGlowColor(float blur, const glm::vec4 & c)
@@ -288,6 +324,7 @@ void GuiText::setBlurGlowColor(float blur, const glm::vec4 & c)
 	blurGlowColor = c;
 	blurGlowIntensity = blur;
 	blurAlpha = c[3];
+	requestRedraw();
 }
 
 int GuiText::getTextWidth(int ind)
@@ -316,6 +353,8 @@ bool GuiText::setFont(FreeTypeGX *f)
 
 	font = f;
 	textWidth = font->getWidth(text, currentSize);
+	glyphQuadsDirty = true;
+	charWidthsSize = 0;
 	return true;
 }
 
@@ -335,8 +374,31 @@ std::string GuiText::toUTF8(void) const
 	return strOutput;
 }
 
+/**
+ * Measure the advance of every character once, wrapping and scrolling only sum them up
+ */
+void GuiText::updateCharWidths()
+{
+	int stringlen = text ? wcslen(text) : 0;
+
+	if(charWidthsSize == currentSize && (int)charWidths.size() == stringlen)
+		return;
+
+	charWidths.resize(stringlen);
+	for(int i = 0; i < stringlen; i++)
+		charWidths[i] = font->getCharWidth(text[i], currentSize, i > 0 ? text[i - 1] : 0);
+
+	//! the scroll gap consists of three spaces after the last character
+	scrollGapWidth = font->getCharWidth(L' ', currentSize, stringlen > 0 ? text[stringlen - 1] : 0);
+	scrollGapWidth += 2 * font->getCharWidth(L' ', currentSize, L' ');
+
+	charWidthsSize = currentSize;
+}
+
 void GuiText::makeDottedText()
 {
+	updateCharWidths();
+
 	int pos = textDyn.size();
 	textDyn.resize(pos + 1);
 
@@ -349,7 +411,7 @@ void GuiText::makeDottedText()
 
 	while (text[i])
 	{
-		currentWidth += font->getCharWidth(text[i], currentSize, i > 0 ? text[i - 1] : 0);
+		currentWidth += charWidths[i];
 		if (currentWidth >= maxWidth && i > 2)
 		{
 			textDyn[pos][i - 2] = '.';
@@ -366,54 +428,13 @@ void GuiText::makeDottedText()
 	textDyn[pos][i] = 0;
 }
 
-void GuiText::scrollText(u32 frameCount)
+void GuiText::scrollText()
 {
-	if (textDyn.size() == 0)
-	{
-		int pos = textDyn.size();
-		int i = 0, currentWidth = 0;
-		textDyn.resize(pos + 1);
-
-		textDyn[pos] = new (std::nothrow) wchar_t[maxWidth];
-		if(!textDyn[pos]) {
-			textDyn.resize(pos);
-			return;
-		}
-
-		while (text[i] && currentWidth < maxWidth)
-		{
-			textDyn[pos][i] = text[i];
-
-			currentWidth += font->getCharWidth(text[i], currentSize, i > 0 ? text[i - 1] : 0);
-
-			++i;
-		}
-		textDyn[pos][i] = 0;
-
-		return;
-	}
-
-	if (frameCount % textScrollDelay != 0)
-	{
-		return;
-	}
-
-	if (textScrollInitialDelay)
-	{
-		--textScrollInitialDelay;
-		return;
-	}
-
-	int stringlen = wcslen(text);
+	updateCharWidths();
 
-	++textScrollPos;
-	if (textScrollPos > stringlen)
-	{
-		textScrollPos = 0;
-		textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
-	}
+	if (textDyn.size() == 0)
+		textDyn.resize(1);
 
-	int ch = textScrollPos;
 	int pos = textDyn.size() - 1;
 
 	if (!textDyn[pos])
@@ -424,6 +445,8 @@ void GuiText::scrollText(u32 frameCount)
 		return;
 	}
 
+	int stringlen = wcslen(text);
+	int ch = textScrollPos;
 	int i = 0, currentWidth = 0;
 
 	while (currentWidth < maxWidth)
@@ -431,11 +454,9 @@ void GuiText::scrollText(u32 frameCount)
 		if (ch > stringlen - 1)
 		{
 			textDyn[pos][i++] = ' ';
-			currentWidth += font->getCharWidth(L' ', currentSize, ch > 0 ? text[ch - 1] : 0);
 			textDyn[pos][i++] = ' ';
-			currentWidth += font->getCharWidth(L' ', currentSize, L' ');
 			textDyn[pos][i++] = ' ';
-			currentWidth += font->getCharWidth(L' ', currentSize, L' ');
+			currentWidth += scrollGapWidth;
 			ch = 0;
 
 			if(currentWidth >= maxWidth)
@@ -443,17 +464,60 @@ void GuiText::scrollText(u32 frameCount)
 		}
 
 		textDyn[pos][i] = text[ch];
-		currentWidth += font->getCharWidth(text[ch], currentSize, ch > 0 ? text[ch - 1] : 0);
+		currentWidth += charWidths[ch];
 		++ch;
 		++i;
 	}
 	textDyn[pos][i] = 0;
+	glyphQuadsDirty = true;
+}
+
+/**
+ * Step the scrolling text, counted in frames as skipped frames are not drawn
+ */
+void GuiText::updateEffects()
+{
+	GuiElement::updateEffects();
+
+	if (wrapMode != SCROLL_HORIZONTAL)
+		return;
+
+	effectUpdateRequired = true;
+
+	//! the first window is made by draw() once the text does not fit
+	if (!text || textDyn.size() == 0)
+		return;
+
+	if (++textScrollFrames < textScrollDelay)
+		return;
+
+	textScrollFrames = 0;
+
+	if (textScrollInitialDelay)
+	{
+		--textScrollInitialDelay;
+		return;
+	}
+
+	++textScrollPos;
+	if (textScrollPos > (int)wcslen(text))
+	{
+		textScrollPos = 0;
+		textScrollInitialDelay = TEXT_SCROLL_INITIAL_DELAY;
+	}
+
+	scrollText();
+
+	//! only the frames in which the text moves have to be drawn
+	requestRedraw();
 }
 
 void GuiText::wrapText()
 {
 	if (textDyn.size() > 0) return;
 
+	updateCharWidths();
+
 	int i = 0;
 	int ch = 0;
 	int linenum = 0;
@@ -476,7 +540,7 @@ void GuiText::wrapText()
 		textDyn[linenum][i] = text[ch];
 		textDyn[linenum][i + 1] = 0;
 
-		currentWidth += font->getCharWidth(text[ch], currentSize, ch > 0 ? text[ch - 1] : 0x0000);
+		currentWidth += charWidths[ch];
 
 		if (currentWidth >= maxWidth)
 		{
@@ -510,6 +574,53 @@ void GuiText::wrapText()
 	}
 }
 
+/**
+ * Lay out the glyphs of the drawn lines relative to the text center
+ */
+void GuiText::updateGlyphQuads()
+{
+	glyphQuads.clear();
+	glyphQuadsDirty = false;
+	glyphQuadsSize = currentSize;
+	glyphQuadsAlignment = alignment;
+
+	if(maxWidth > 0 && maxWidth <= textWidth)
+	{
+		if(wrapMode == DOTTED) // text dotted
+		{
+			if(textDyn.size() > 0)
+				font->layoutText(glyphQuads, 0, 0, textDyn[textDyn.size()-1], currentSize, alignment, textDynWidth[textDyn.size()-1]);
+		}
+		else if(wrapMode == SCROLL_HORIZONTAL)
+		{
+			if(textDyn.size() > 0)
+				font->layoutText(glyphQuads, 0, 0, textDyn[textDyn.size()-1], currentSize, alignment, maxWidth);
+		}
+		else if(wrapMode == WRAP)
+		{
+			int lineheight = currentSize + 6;
+			int yoffset = 0;
+			int voffset = 0;
+
+			if(alignment & ALIGN_MIDDLE)
+				voffset = (lineheight * (textDyn.size()-1)) >> 1;
+
+			for(u32 i = 0; i < textDyn.size(); i++)
+			{
+				font->layoutText(glyphQuads, 0, voffset + yoffset, textDyn[i], currentSize, alignment, textDynWidth[i]);
+                yoffset -= lineheight;
+			}
+		}
+	}
+	else
+	{
+		font->layoutText(glyphQuads, 0, 0, text, currentSize, alignment, textWidth);
+	}
+
+	//! laying out may have recycled atlas pages of other texts but not the ones used here
+	glyphQuadsGeneration = font->getAtlasGeneration();
+}
+
 /**
  * Draw the text on screen
  */
@@ -525,6 +636,9 @@ void GuiText::draw(CVideo *pVideo)
     blurGlowColor[3] = blurAlpha * getAlpha();
 	int newSize = size * getScale();
 
+	//! glyphs cached below are placed for this frame, not the one of the last drawn text
+	font->setFrameCount(pVideo->getFrameCount());
+
 	if(newSize != currentSize)
 	{
 		currentSize = newSize;
@@ -539,55 +653,29 @@ void GuiText::draw(CVideo *pVideo)
 		{
 			if(textDyn.size() == 0)
 				makeDottedText();
-
-			if(textDynWidth.size() != textDyn.size())
-            {
-                textDynWidth.resize(textDyn.size());
-
-                for(u32 i = 0; i < textDynWidth.size(); i++)
-                    textDynWidth[i] = font->getWidth(textDyn[i], currentSize);
-            }
-
-			if(textDyn.size() > 0)
-				font->drawText(pVideo, getCenterX(), getCenterY(), getDepth(), textDyn[textDyn.size()-1], currentSize, color, alignment, textDynWidth[textDyn.size()-1], defaultBlur, blurGlowIntensity, blurGlowColor);
 		}
-
 		else if(wrapMode == SCROLL_HORIZONTAL)
 		{
-			scrollText(pVideo->getFrameCount());
-
-			if(textDyn.size() > 0)
-				font->drawText(pVideo, getCenterX(), getCenterY(), getDepth(), textDyn[textDyn.size()-1], currentSize, color, alignment, maxWidth, defaultBlur, blurGlowIntensity, blurGlowColor);
+			if(textDyn.size() == 0)
+				scrollText();
 		}
 		else if(wrapMode == WRAP)
 		{
-			int lineheight = currentSize + 6;
-			int yoffset = 0;
-			int voffset = 0;
-
 			if(textDyn.size() == 0)
 				wrapText();
+		}
 
-			if(textDynWidth.size() != textDyn.size())
-            {
-                textDynWidth.resize(textDyn.size());
+		if(wrapMode != SCROLL_HORIZONTAL && textDynWidth.size() != textDyn.size())
+        {
+            textDynWidth.resize(textDyn.size());
 
-                for(u32 i = 0; i < textDynWidth.size(); i++)
-                    textDynWidth[i] = font->getWidth(textDyn[i], currentSize);
-            }
+            for(u32 i = 0; i < textDynWidth.size(); i++)
+                textDynWidth[i] = font->getWidth(textDyn[i], currentSize);
+        }
+	}
 
-			if(alignment & ALIGN_MIDDLE)
-				voffset = (lineheight * (textDyn.size()-1)) >> 1;
+	if(glyphQuadsDirty || glyphQuadsSize != currentSize || glyphQuadsAlignment != alignment || glyphQuadsGeneration != font->getAtlasGeneration())
+		updateGlyphQuads();
 
-			for(u32 i = 0; i < textDyn.size(); i++)
-			{
-				font->drawText(pVideo, getCenterX(), getCenterY() + voffset + yoffset, getDepth(), textDyn[i], currentSize, color, alignment, textDynWidth[i], defaultBlur, blurGlowIntensity, blurGlowColor);
-                yoffset -= lineheight;
-			}
-		}
-	}
-	else
-	{
-		font->drawText(pVideo, getCenterX(), getCenterY(), getDepth(), text, currentSize, color, alignment, textWidth, defaultBlur, blurGlowIntensity, blurGlowColor);
-	}
+	font->drawGlyphQuads(pVideo, getCenterX(), getCenterY(), getDepth(), glyphQuads, currentSize, color, defaultBlur, blurGlowIntensity, blurGlowColor);
 }
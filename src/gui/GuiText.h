@@ -18,8 +18,7 @@
 #define GUI_TEXT_H_
 
 #include "GuiElement.h"
-//!Forward declaration
-class FreeTypeGX;
+#include "FreeTypeGX.h"
 
 //!Display, manage, and manipulate text in the GUI
 class GuiText : public GuiElement
@@ -92,6 +91,8 @@ public:
     virtual int getStartWidth() { return 0; };
     //!Constantly called to draw the text
     void draw(CVideo *pVideo);
+    //!Steps the scrolling text
+    void updateEffects();
     //! text enums
     enum
     {
@@ -111,10 +112,14 @@ protected:
     void clearDynamicText();
     //!Create a dynamic dotted text if the text is too long
     void makeDottedText();
-    //!Scroll the text once
-    void scrollText(u32 frameCount);
+    //!Make the visible part of the scrolling text
+    void scrollText();
     //!Wrap the text to several lines
     void wrapText();
+    //!Lay out the glyphs of all drawn lines
+    void updateGlyphQuads();
+    //!Measure the advance of every character of the text
+    void updateCharWidths();
 
     wchar_t * text;
     std::vector<wchar_t *> textDyn;
@@ -123,6 +128,7 @@ protected:
     int textScrollPos; //!< Current starting index of text string for scrolling
     int textScrollInitialDelay; //!< Delay to wait before starting to scroll
     int textScrollDelay; //!< Scrolling speed
+    int textScrollFrames; //!< Frames since the last scroll step
     int size; //!< Font size
     int maxWidth; //!< Maximum width of the generated text object (for text wrapping)
     FreeTypeGX *font;
@@ -134,6 +140,14 @@ protected:
     float blurGlowIntensity;
     float blurAlpha;
     glm::vec4 blurGlowColor;
+    std::vector<ftgxGlyphQuad> glyphQuads; //!< Glyph layout of the drawn lines relative to the text center
+    bool glyphQuadsDirty;
+    int glyphQuadsSize;
+    int glyphQuadsAlignment;
+    u32 glyphQuadsGeneration;
+    std::vector<uint16_t> charWidths; //!< Advance of each character including kerning to its predecessor
+    int charWidthsSize; //!< Font size the advances were measured with, 0 if not measured
+    int scrollGapWidth; //!< Width of the gap between the end and the start of a scrolling text
 };
 
 #endif
@@ -78,7 +78,9 @@
 #define SIGSLOT_H__
 
 #include <set>
-#include <list>
+#include <vector>
+#include <algorithm>
+#include <stddef.h>
 
 #define _SIGSLOT_SINGLE_THREADED
 
@@ -344,6 +346,104 @@ namespace sigslot {
 		}
 	};
 
+	// Single threaded signals don't need to lock at all, this spares the two
+	// virtual calls on every emission.
+	template<>
+	class lock_block<single_threaded>
+	{
+	public:
+		lock_block(single_threaded *mtx)
+		{
+			;
+		}
+	};
+
+	// The connections of a signal. They are kept in a vector so emitting a
+	// signal walks contiguous memory and never allocates. A slot may disconnect
+	// itself or others while the signal is emitted. Those entries are only set
+	// to NULL then and the vector is compacted after the last emission returns.
+	// Slots connected during an emission are appended behind the count taken
+	// at its start and are called from the next emission on.
+	template<class connection_type>
+	class _connection_list
+	{
+	public:
+		_connection_list()
+			: m_emitting(0)
+			, m_removed(false)
+			, m_count(0)
+		{
+			;
+		}
+
+		size_t size() const
+		{
+			return m_slots.size();
+		}
+
+		bool empty() const
+		{
+			return m_count == 0;
+		}
+
+		connection_type* operator[](size_t i) const
+		{
+			return m_slots[i];
+		}
+
+		void push_back(connection_type* conn)
+		{
+			m_slots.push_back(conn);
+			m_count++;
+		}
+
+		void remove(size_t i)
+		{
+			delete m_slots[i];
+			m_count--;
+
+			if(m_emitting)
+			{
+				m_slots[i] = NULL;
+				m_removed = true;
+			}
+			else
+			{
+				m_slots.erase(m_slots.begin() + i);
+			}
+		}
+
+		void clear()
+		{
+			for(size_t i = m_slots.size(); i > 0; --i)
+			{
+				if(m_slots[i - 1])
+					remove(i - 1);
+			}
+		}
+
+		size_t begin_emit()
+		{
+			m_emitting++;
+			return m_slots.size();
+		}
+
+		void end_emit()
+		{
+			if(--m_emitting == 0 && m_removed)
+			{
+				m_slots.erase(std::remove(m_slots.begin(), m_slots.end(), (connection_type*)NULL), m_slots.end());
+				m_removed = false;
+			}
+		}
+
+	private:
+		std::vector<connection_type *> m_slots;
+		int m_emitting;
+		bool m_removed;
+		size_t m_count;
+	};
+
 	template<class mt_policy>
 	class has_slots;
 
@@ -538,9 +638,7 @@ namespace sigslot {
 	class _signal_base0 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef typename std::list<_connection_base0<mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base0<mt_policy> > connections_list;
 
 		_signal_base0()
 		{
@@ -551,15 +649,14 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator  it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
@@ -571,81 +668,56 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it  = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -657,9 +729,7 @@ namespace sigslot {
 	class _signal_base1 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef typename std::list<_connection_base1<arg1_type, mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base1<arg1_type, mt_policy> > connections_list;
 
 		_signal_base1()
 		{
@@ -670,32 +740,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -707,64 +771,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -777,10 +821,7 @@ namespace sigslot {
 	class _signal_base2 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef typename std::list<_connection_base2<arg1_type, arg2_type, mt_policy> *>
-			connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base2<arg1_type, arg2_type, mt_policy> > connections_list;
 
 		_signal_base2()
 		{
@@ -791,32 +832,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -828,64 +863,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -897,11 +912,8 @@ namespace sigslot {
 	class _signal_base3 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef std::list<_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> *>
-			connections_list;
+		typedef _connection_list<_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> > connections_list;
 
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
 		_signal_base3()
 		{
 			;
@@ -911,32 +923,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -948,64 +954,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -1017,10 +1003,8 @@ namespace sigslot {
 	class _signal_base4 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef std::list<_connection_base4<arg1_type, arg2_type, arg3_type,
-			arg4_type, mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base4<arg1_type, arg2_type, arg3_type,
+			arg4_type, mt_policy> > connections_list;
 
 		_signal_base4()
 		{
@@ -1031,32 +1015,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -1068,64 +1046,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					this->m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -1138,10 +1096,8 @@ namespace sigslot {
 	class _signal_base5 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef std::list<_connection_base5<arg1_type, arg2_type, arg3_type,
-			arg4_type, arg5_type, mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base5<arg1_type, arg2_type, arg3_type,
+			arg4_type, arg5_type, mt_policy> > connections_list;
 
 		_signal_base5()
 		{
@@ -1153,32 +1109,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -1190,64 +1140,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -1260,10 +1190,8 @@ namespace sigslot {
 	class _signal_base6 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef std::list<_connection_base6<arg1_type, arg2_type, arg3_type,
-			arg4_type, arg5_type, arg6_type, mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base6<arg1_type, arg2_type, arg3_type,
+			arg4_type, arg5_type, arg6_type, mt_policy> > connections_list;
 
 		_signal_base6()
 		{
@@ -1275,32 +1203,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -1312,64 +1234,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -1382,10 +1284,8 @@ namespace sigslot {
 	class _signal_base7 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef std::list<_connection_base7<arg1_type, arg2_type, arg3_type,
-			arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base7<arg1_type, arg2_type, arg3_type,
+			arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> > connections_list;
 
 		_signal_base7()
 		{
@@ -1397,32 +1297,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -1434,64 +1328,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -1504,11 +1378,8 @@ namespace sigslot {
 	class _signal_base8 : public _signal_base<mt_policy>
 	{
 	public:
-		typedef std::list<_connection_base8<arg1_type, arg2_type, arg3_type,
-			arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *>
-			connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		typedef _connection_list<_connection_base8<arg1_type, arg2_type, arg3_type,
+			arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> > connections_list;
 
 		_signal_base8()
 		{
@@ -1520,32 +1391,26 @@ namespace sigslot {
 			: _signal_base<mt_policy>(s)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < s.m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_connect(this);
-				m_connected_slots.push_back((*it)->clone());
+				if(!s.m_connected_slots[i])
+					continue;
 
-				++it;
+				s.m_connected_slots[i]->getdest()->signal_connect(this);
+				m_connected_slots.push_back(s.m_connected_slots[i]->clone());
 			}
 		}
 
 		void slot_duplicate(const has_slots<mt_policy>* oldtarget, has_slots<mt_policy>* newtarget)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+			size_t count = m_connected_slots.size();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				if((*it)->getdest() == oldtarget)
-				{
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-
-				++it;
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == oldtarget)
+					m_connected_slots.push_back(m_connected_slots[i]->duplicate(newtarget));
 			}
 		}
 
@@ -1557,64 +1422,44 @@ namespace sigslot {
 		void disconnect_all()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				(*it)->getdest()->signal_disconnect(this);
-				delete *it;
-
-				++it;
+				if(m_connected_slots[i])
+					m_connected_slots[i]->getdest()->signal_disconnect(this);
 			}
 
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_connected_slots.clear();
 		}
 
 		void disconnect(has_slots<mt_policy>* pclass)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < m_connected_slots.size(); ++i)
 			{
-				if((*it)->getdest() == pclass)
+				if(m_connected_slots[i] && m_connected_slots[i]->getdest() == pclass)
 				{
-					delete *it;
-					m_connected_slots.erase(it);
+					m_connected_slots.remove(i);
 					pclass->signal_disconnect(this);
 					return;
 				}
-
-				++it;
 			}
 		}
 
 		bool connected()
 		{
-			return m_connected_slots.size() != 0;
+			return !m_connected_slots.empty();
 		}
 
 		void slot_disconnect(has_slots<mt_policy>* pslot)
 		{
 			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 
-			while(it != itEnd)
+			for(size_t i = m_connected_slots.size(); i > 0; --i)
 			{
-				iterator itNext = it;
-				++itNext;
-
-				if((*it)->getdest() == pslot)
-				{
-					delete *it;
-					m_connected_slots.erase(it);
-					//			delete *it;
-				}
-
-				it = itNext;
+				if(m_connected_slots[i - 1] && m_connected_slots[i - 1]->getdest() == pslot)
+					m_connected_slots.remove(i - 1);
 			}
 		}
 
@@ -2088,7 +1933,6 @@ namespace sigslot {
 	class signal0 : public _signal_base0<mt_policy>
 	{
 	public:
-		typedef typename _signal_base0<mt_policy>::connections_list::const_iterator const_iterator;
 		signal0()
 		{
 			;
@@ -2118,35 +1962,29 @@ namespace sigslot {
 		void emit()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit();
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit();
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()()
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit();
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit();
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2154,7 +1992,6 @@ namespace sigslot {
 	class signal1 : public _signal_base1<arg1_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base1<arg1_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal1()
 		{
 			;
@@ -2184,35 +2021,29 @@ namespace sigslot {
 		void emit(arg1_type a1)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2220,7 +2051,6 @@ namespace sigslot {
 	class signal2 : public _signal_base2<arg1_type, arg2_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base2<arg1_type, arg2_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal2()
 		{
 			;
@@ -2251,35 +2081,29 @@ namespace sigslot {
 		void emit(arg1_type a1, arg2_type a2)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1, arg2_type a2)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2287,7 +2111,6 @@ namespace sigslot {
 	class signal3 : public _signal_base3<arg1_type, arg2_type, arg3_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base3<arg1_type, arg2_type, arg3_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal3()
 		{
 			;
@@ -2319,35 +2142,29 @@ namespace sigslot {
 		void emit(arg1_type a1, arg2_type a2, arg3_type a3)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1, arg2_type a2, arg3_type a3)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2356,7 +2173,6 @@ namespace sigslot {
 		arg4_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal4()
 		{
 			;
@@ -2388,35 +2204,29 @@ namespace sigslot {
 		void emit(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2426,7 +2236,6 @@ namespace sigslot {
 		arg4_type, arg5_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal5()
 		{
 			;
@@ -2461,36 +2270,30 @@ namespace sigslot {
 			arg5_type a5)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
 			arg5_type a5)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2501,8 +2304,6 @@ namespace sigslot {
 		arg4_type, arg5_type, arg6_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base6<arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal6()
 		{
 			;
@@ -2538,36 +2339,30 @@ namespace sigslot {
 			arg5_type a5, arg6_type a6)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5, a6);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5, a6);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
 			arg5_type a5, arg6_type a6)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5, a6);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5, a6);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2577,8 +2372,6 @@ namespace sigslot {
 		arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base7<arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal7()
 		{
 			;
@@ -2615,36 +2408,30 @@ namespace sigslot {
 			arg5_type a5, arg6_type a6, arg7_type a7)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5, a6, a7);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5, a6, a7);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
 			arg5_type a5, arg6_type a6, arg7_type a7)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5, a6, a7);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5, a6, a7);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
@@ -2654,8 +2441,6 @@ namespace sigslot {
 		arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>
 	{
 	public:
-		typedef typename _signal_base8<arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>::connections_list::const_iterator const_iterator;
 		signal8()
 		{
 			;
@@ -2693,36 +2478,30 @@ namespace sigslot {
 			arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5, a6, a7, a8);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5, a6, a7, a8);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 
 		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
 			arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8)
 		{
 			lock_block<mt_policy> lock(this);
-			const_iterator itNext, it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+			size_t count = this->m_connected_slots.begin_emit();
 
-			while(it != itEnd)
+			for(size_t i = 0; i < count; ++i)
 			{
-				itNext = it;
-				++itNext;
-
-				(*it)->emit(a1, a2, a3, a4, a5, a6, a7, a8);
-
-				it = itNext;
+				if(this->m_connected_slots[i])
+					this->m_connected_slots[i]->emit(a1, a2, a3, a4, a5, a6, a7, a8);
 			}
+
+			this->m_connected_slots.end_emit();
 		}
 	};
 
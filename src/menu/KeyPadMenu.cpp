@@ -51,7 +51,9 @@ KeyPadMenu::KeyPadMenu(int w, int h, const std::string & strTitle, const std::st
     , deleteButtonImgClick(deleteButtonClickImgData)
     , deleteButton(deleteButtonImgData->getWidth(), deleteButtonImgData->getHeight())
 {
-    lastFrameCount = 0;
+    blinkerFrames = 0;
+    //! the field blinker is timed in updateEffects()
+    effectUpdateRequired = true;
     currentText = prefil;
     if(currentText.size() > MAX_FIELDS)
         currentText.resize(MAX_FIELDS);
@@ -262,15 +264,18 @@ void KeyPadMenu::OnDeleteButtonClick(GuiButton *button, const GuiController *con
     }
 }
 
-void KeyPadMenu::draw(CVideo *video)
+void KeyPadMenu::updateEffects()
 {
-    if((video->getFrameCount() - lastFrameCount) >= 30)
+    GuiFrame::updateEffects();
+
+    //! only the frames in which the blinker toggles have to be drawn
+    if(++blinkerFrames >= 30)
     {
-        lastFrameCount = video->getFrameCount();
+        blinkerFrames = 0;
 
         bool blinkerVisible = fieldBlinkerImg.isVisible();
         fieldBlinkerImg.setVisible(!blinkerVisible);
     }
 
-    GuiFrame::draw(video);
+    effectUpdateRequired = true;
 }
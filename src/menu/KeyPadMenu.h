@@ -26,7 +26,7 @@ public:
     KeyPadMenu(int w, int h, const std::string & strTitle, const std::string & prefil);
     virtual ~KeyPadMenu();
 
-    void draw(CVideo *video);
+    void updateEffects();
 
     sigslot::signal2<GuiElement *, const std::string &> settingsOkClicked;
     sigslot::signal1<GuiElement *> settingsBackClicked;
@@ -84,7 +84,7 @@ private:
 
     int textPosition;
     std::string currentText;
-    u32 lastFrameCount;
+    u32 blinkerFrames;
 };
 
 #endif //_KEY_PAD_MENU_H_
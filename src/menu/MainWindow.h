@@ -40,6 +40,7 @@ public:
 
         removeTv(e);
         tvElements.push_back(e);
+        GuiElement::requestRedraw();
     }
     void appendDrc(GuiElement *e)
     {
@@ -48,6 +49,7 @@ public:
 
         removeDrc(e);
         drcElements.push_back(e);
+        GuiElement::requestRedraw();
     }
 
     void append(GuiElement *e)
@@ -63,6 +65,7 @@ public:
 
         removeTv(e);
         tvElements.insert(tvElements.begin() + pos, e);
+        GuiElement::requestRedraw();
     }
     void insertDrc(u32 pos, GuiElement *e)
     {
@@ -71,6 +74,7 @@ public:
 
         removeDrc(e);
         drcElements.insert(drcElements.begin() + pos, e);
+        GuiElement::requestRedraw();
     }
 
     void insert(u32 pos, GuiElement *e)
@@ -86,6 +90,7 @@ public:
             if(e == tvElements[i])
             {
                 tvElements.erase(tvElements.begin() + i);
+                GuiElement::requestRedraw();
                 break;
             }
         }
@@ -97,6 +102,7 @@ public:
             if(e == drcElements[i])
             {
                 drcElements.erase(drcElements.begin() + i);
+                GuiElement::requestRedraw();
                 break;
             }
         }
@@ -111,6 +117,7 @@ public:
     {
         tvElements.clear();
         drcElements.clear();
+        GuiElement::requestRedraw();
     }
 
     void drawDrc(CVideo *video);
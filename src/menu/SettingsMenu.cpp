@@ -39,6 +39,13 @@ static const ValueString ValueGameViewMode[] =
     { 2, "Cover Carousel" }
 };
 
+static const ValueString ValueAntiAliasing[] =
+{
+    { AA_MODE_OFF, "Off" },
+    { AA_MODE_STILL, "Still Frames" },
+    { AA_MODE_ALWAYS, "Always" }
+};
+
 static const ValueString ValueGameSaveModes[] =
 {
     { GAME_SAVES_SHARED, "Shared Mode" },
@@ -60,7 +67,7 @@ static const struct
 }
 stSettingsCategories[] =
 {
-    { "GUI",     "guiSettingsIcon.png",    "guiSettingsIconGlow.png",    "Game View Selection\n" "Background customizations" },
+    { "GUI",     "guiSettingsIcon.png",    "guiSettingsIconGlow.png",    "Game View Selection\n" "Background customizations\n" "TV anti-aliasing" },
     { "Loader",  "loaderSettingsIcon.png", "loaderSettingsIconGlow.png", "Customize games path\nCustomize save path" },
     { "Game",    "gameSettingsIcon.png",   "gameSettingsIconGlow.png",   "Launch method selection\n" "Log server control\n" "Adjust log server IP and port" },
     { "Credits", "creditsIcon.png",        "creditsIconGlow.png",        "Credits to all contributors" }
@@ -69,7 +76,8 @@ stSettingsCategories[] =
 static const SettingType GuiSettings[] =
 {
     { "Game View TV", ValueGameViewMode, Type3Buttons, CSettings::GameViewModeTv },
-    { "Game View DRC", ValueGameViewMode, Type3Buttons, CSettings::GameViewModeDrc }
+    { "Game View DRC", ValueGameViewMode, Type3Buttons, CSettings::GameViewModeDrc },
+    { "TV Anti-Aliasing", ValueAntiAliasing, Type3Buttons, CSettings::TvAntiAliasing }
 };
 
 static const SettingType LoaderSettings[] =
@@ -109,6 +117,8 @@ SettingsMenu::SettingsMenu(int w, int h)
     selectedCategory = 0;
     animationSpeed = 25;
     bUpdatePositions = true;
+    //! the category scrolling is animated in update()
+    updateRequired = true;
 
     quitButton.setImage(&quitImage);
     quitButton.setAlignment(ALIGN_BOTTOM | ALIGN_LEFT);
@@ -0,0 +1,123 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <unistd.h>
+#include "TextureCache.h"
+#include "TextureDiskCache.h"
+#include "gui/GuiImageData.h"
+#include "utils/logger.h"
+
+//! memory that may be kept by textures that are not referenced anymore
+#define TEXTURE_CACHE_BUDGET        (16 * 1024 * 1024)
+//! block compressed textures, falls back to BC1 for images without transparency
+#define TEXTURE_CACHE_FORMAT        GX2_SURFACE_FORMAT_T_BC3_UNORM
+
+TextureCache *TextureCache::cacheInstance = NULL;
+
+TextureCache::TextureCache()
+    : useCounter(0)
+    , hits(0)
+    , misses(0)
+    , totalBytes(0)
+{
+}
+
+TextureCache::~TextureCache()
+{
+    log_printf("Texture cache: %i hits, %i misses, %i kB\n", hits, misses, totalBytes >> 10);
+
+    for(std::map<CacheKey, CacheEntry>::iterator itr = entries.begin(); itr != entries.end(); ++itr)
+        delete itr->second.image;
+}
+
+GuiImageData * TextureCache::acquire(const std::string & filepath, int textureClamp)
+{
+    CacheKey key(filepath, textureClamp);
+
+    cacheMutex.lock();
+    std::map<CacheKey, CacheEntry>::iterator itr = entries.find(key);
+    if(itr != entries.end())
+    {
+        itr->second.refCount++;
+        itr->second.lastUse = ++useCounter;
+        hits++;
+        GuiImageData *image = itr->second.image;
+        cacheMutex.unlock();
+        return image;
+    }
+    misses++;
+    cacheMutex.unlock();
+
+    //! load without holding the lock, this can take a while
+    GuiImageData *image = TextureDiskCache::instance()->loadImage(filepath, textureClamp, TEXTURE_CACHE_FORMAT);
+    if(!image)
+        return NULL;
+
+    cacheMutex.lock();
+    CacheEntry & entry = entries[key];
+    entry.image = image;
+    entry.refCount = 1;
+    entry.lastUse = ++useCounter;
+    entry.size = image->getTexture()->surface.image_size;
+    imageKeys[image] = key;
+    totalBytes += entry.size;
+    cacheMutex.unlock();
+
+    evictUnused();
+
+    return image;
+}
+
+void TextureCache::release(GuiImageData *image)
+{
+    cacheMutex.lock();
+    std::map<GuiImageData *, CacheKey>::iterator itr = imageKeys.find(image);
+    if(itr != imageKeys.end())
+    {
+        CacheEntry & entry = entries[itr->second];
+        if(entry.refCount > 0)
+            entry.refCount--;
+    }
+    cacheMutex.unlock();
+
+    evictUnused();
+}
+
+void TextureCache::evictUnused(void)
+{
+    cacheMutex.lock();
+
+    while(totalBytes > TEXTURE_CACHE_BUDGET)
+    {
+        //! find the least recently used texture that nobody holds anymore
+        std::map<CacheKey, CacheEntry>::iterator oldest = entries.end();
+        for(std::map<CacheKey, CacheEntry>::iterator itr = entries.begin(); itr != entries.end(); ++itr)
+        {
+            if(itr->second.refCount == 0 && (oldest == entries.end() || itr->second.lastUse < oldest->second.lastUse))
+                oldest = itr;
+        }
+
+        if(oldest == entries.end())
+            break;
+
+        totalBytes -= oldest->second.size;
+        imageKeys.erase(oldest->second.image);
+        delete oldest->second.image;
+        entries.erase(oldest);
+    }
+
+    cacheMutex.unlock();
+}
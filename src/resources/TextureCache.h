@@ -0,0 +1,86 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _TEXTURE_CACHE_H_
+#define _TEXTURE_CACHE_H_
+
+#include <map>
+#include <string>
+#include <gctypes.h>
+#include "system/CMutex.h"
+
+//! forward declaration
+class GuiImageData;
+
+//!Process wide cache of textures loaded from files. Every GuiImageAsync
+//!requesting the same file with the same clamp mode gets the same
+//!GuiImageData. Textures that are no longer referenced stay in memory
+//!until the memory budget is exceeded.
+class TextureCache
+{
+public:
+    static TextureCache *instance() {
+        if(!cacheInstance)
+            cacheInstance = new TextureCache();
+
+        return cacheInstance;
+    }
+
+    static void destroyInstance() {
+        delete cacheInstance;
+        cacheInstance = NULL;
+    }
+
+    //!Get the texture of a file and increase its reference count
+    //!\param filepath Path of the source image
+    //!\param textureClamp Texture clamp mode of the sampler
+    //!\return image data or NULL if the file could not be loaded
+    GuiImageData * acquire(const std::string & filepath, int textureClamp);
+    //!Decrease the reference count of a texture returned by acquire()
+    void release(GuiImageData *image);
+
+    //! statistics
+    u32 getHits() const { return hits; }
+    u32 getMisses() const { return misses; }
+    u32 getBytes() const { return totalBytes; }
+private:
+    TextureCache();
+    ~TextureCache();
+
+    static TextureCache *cacheInstance;
+
+    typedef std::pair<std::string, int> CacheKey;
+
+    typedef struct
+    {
+        GuiImageData *image;
+        u32 refCount;
+        u32 lastUse;
+        u32 size;
+    } CacheEntry;
+
+    void evictUnused(void);
+
+    std::map<CacheKey, CacheEntry> entries;
+    std::map<GuiImageData *, CacheKey> imageKeys;
+    u32 useCounter;
+    u32 hits;
+    u32 misses;
+    u32 totalBytes;
+    CMutex cacheMutex;
+};
+
+#endif // _TEXTURE_CACHE_H_
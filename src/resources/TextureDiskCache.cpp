@@ -0,0 +1,355 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <malloc.h>
+#include <string.h>
+#include <unistd.h>
+#include "TextureDiskCache.h"
+#include "common/common.h"
+#include "fs/CFile.hpp"
+#include "fs/DirList.h"
+#include "fs/fs_utils.h"
+#include "gui/GuiImageData.h"
+#include "utils/StringTools.h"
+#include "utils/logger.h"
+
+#define CACHE_MAGIC             0x4C475443      // LGTC
+#define CACHE_VERSION           2
+#define CACHE_INDEX_MAGIC       0x4C475449      // LGTI
+#define CACHE_MAX_SIZE          (64 * 1024 * 1024)
+#define CACHE_FILE_EXT          ".tex"
+#define CACHE_INDEX_FILE        "/index.bin"
+
+TextureDiskCache *TextureDiskCache::cacheInstance = NULL;
+
+TextureDiskCache::TextureDiskCache()
+    : totalSize(0)
+    , useCounter(0)
+{
+    cachePath = SD_PATH SD_LOADIINE_PATH "/apps/loadiine_gx2/cache/textures";
+    CreateSubfolder(cachePath.c_str());
+    loadIndex();
+}
+
+TextureDiskCache::~TextureDiskCache()
+{
+    saveIndex();
+}
+
+u32 TextureDiskCache::hashPath(const std::string & filepath)
+{
+    //! FNV-1a
+    u32 hash = 2166136261U;
+    for(u32 i = 0; i < filepath.size(); ++i)
+    {
+        hash ^= (u8)filepath[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+std::string TextureDiskCache::entryPath(u32 hash) const
+{
+    return strfmt("%s/%08X" CACHE_FILE_EXT, cachePath.c_str(), hash);
+}
+
+GuiImageData * TextureDiskCache::loadImage(const std::string & filepath, int textureClamp, int textureFormat)
+{
+    struct stat filestat;
+    if(stat(filepath.c_str(), &filestat) != 0)
+        return NULL;
+
+    GuiImageData *imgData = new GuiImageData();
+
+    if(readEntry(filepath, filestat, imgData, textureClamp, textureFormat))
+        return imgData;
+
+    u8 *buffer = NULL;
+    u32 bufferSize = 0;
+
+    int iResult = LoadFileToMem(filepath.c_str(), &buffer, &bufferSize);
+    if(iResult > 0)
+    {
+        imgData->loadImage(buffer, bufferSize, textureClamp, textureFormat);
+
+        //! free original image buffer which is converted to texture now and not needed anymore
+        free(buffer);
+    }
+
+    if(!imgData->getTexture())
+    {
+        delete imgData;
+        return NULL;
+    }
+
+    writeEntry(filepath, filestat, imgData, textureFormat);
+    return imgData;
+}
+
+bool TextureDiskCache::readEntry(const std::string & filepath, const struct stat & filestat, GuiImageData *imgData, int textureClamp, int textureFormat)
+{
+    u32 hash = hashPath(filepath);
+
+    CFile file(entryPath(hash), CFile::ReadOnly);
+    if(!file.isOpen())
+        return false;
+
+    CacheHeader header;
+    if(file.read((u8*)&header, sizeof(header)) != (int)sizeof(header)
+       || header.magic != CACHE_MAGIC
+       || header.version != CACHE_VERSION
+       || header.requestFormat != (u32)textureFormat
+       || header.sourceSize != (u32)filestat.st_size
+       || header.sourceMtime != (u32)filestat.st_mtime
+       || header.pathLength != filepath.size()
+       || file.size() != (sizeof(header) + header.pathLength + header.imageSize))
+    {
+        file.close();
+        removeEntry(hash);
+        return false;
+    }
+
+    //! make sure the entry belongs to this file and not to a hash collision
+    std::string entrySource;
+    entrySource.resize(header.pathLength);
+    if(file.read((u8*)&entrySource[0], header.pathLength) != (int)header.pathLength)
+    {
+        file.close();
+        removeEntry(hash);
+        return false;
+    }
+    if(entrySource != filepath)
+        return false;
+
+    if(!imgData->createTexture(header.width, header.height, header.format))
+        return false;
+
+    const GX2Texture *texture = imgData->getTexture();
+
+    //! surface layout differs from the stored one, rebuild the entry
+    if(texture->surface.pitch != header.pitch || texture->surface.image_size != header.imageSize)
+    {
+        imgData->releaseData();
+        file.close();
+        removeEntry(hash);
+        return false;
+    }
+
+    //! read the whole surface in one go
+    u8 *surface = (u8*)texture->surface.image_data;
+    u32 done = 0;
+    while(done < header.imageSize)
+    {
+        int ret = file.read(surface + done, header.imageSize - done);
+        if(ret <= 0)
+            break;
+        done += ret;
+    }
+
+    //! a truncated entry would fail on every start, drop it
+    if(done != header.imageSize)
+    {
+        imgData->releaseData();
+        file.close();
+        removeEntry(hash);
+        return false;
+    }
+
+    imgData->finishTexture(textureClamp);
+
+    cacheMutex.lock();
+    CacheEntry & entry = entries[hash];
+    if(entry.fileSize == 0)
+    {
+        entry.fileSize = file.size();
+        totalSize += entry.fileSize;
+    }
+    entry.lastUse = ++useCounter;
+    cacheMutex.unlock();
+
+    return true;
+}
+
+void TextureDiskCache::writeEntry(const std::string & filepath, const struct stat & filestat, const GuiImageData *imgData, int textureFormat)
+{
+    const GX2Texture *texture = imgData->getTexture();
+    if(!texture)
+        return;
+
+    CacheHeader header;
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.requestFormat = textureFormat;
+    header.format = texture->surface.format;
+    header.width = texture->surface.width;
+    header.height = texture->surface.height;
+    header.pitch = texture->surface.pitch;
+    header.imageSize = texture->surface.image_size;
+    header.sourceSize = filestat.st_size;
+    header.sourceMtime = filestat.st_mtime;
+    header.pathLength = filepath.size();
+
+    u32 fileSize = sizeof(header) + header.pathLength + header.imageSize;
+    if(fileSize > CACHE_MAX_SIZE)
+        return;
+
+    u32 hash = hashPath(filepath);
+    std::string path = entryPath(hash);
+
+    CFile file(path, CFile::WriteOnly);
+    if(!file.isOpen())
+        return;
+
+    bool result = (file.write((const u8*)&header, sizeof(header)) == (int)sizeof(header))
+               && (file.write((const u8*)filepath.c_str(), header.pathLength) == (int)header.pathLength)
+               && (file.write((const u8*)texture->surface.image_data, header.imageSize) == (int)header.imageSize);
+    file.close();
+
+    if(!result)
+    {
+        unlink(path.c_str());
+        return;
+    }
+
+    cacheMutex.lock();
+    CacheEntry & entry = entries[hash];
+    totalSize -= entry.fileSize;
+    entry.fileSize = fileSize;
+    entry.lastUse = ++useCounter;
+    totalSize += fileSize;
+    cacheMutex.unlock();
+
+    evictEntries();
+}
+
+void TextureDiskCache::removeEntry(u32 hash)
+{
+    cacheMutex.lock();
+    std::map<u32, CacheEntry>::iterator itr = entries.find(hash);
+    if(itr != entries.end())
+    {
+        totalSize -= itr->second.fileSize;
+        entries.erase(itr);
+    }
+    cacheMutex.unlock();
+
+    unlink(entryPath(hash).c_str());
+}
+
+void TextureDiskCache::evictEntries(void)
+{
+    while(true)
+    {
+        cacheMutex.lock();
+        if(totalSize <= CACHE_MAX_SIZE || entries.empty())
+        {
+            cacheMutex.unlock();
+            break;
+        }
+
+        //! drop the least recently used entry
+        std::map<u32, CacheEntry>::iterator oldest = entries.begin();
+        for(std::map<u32, CacheEntry>::iterator itr = entries.begin(); itr != entries.end(); ++itr)
+        {
+            if(itr->second.lastUse < oldest->second.lastUse)
+                oldest = itr;
+        }
+        u32 hash = oldest->first;
+        cacheMutex.unlock();
+
+        removeEntry(hash);
+    }
+}
+
+void TextureDiskCache::clear()
+{
+    DirList dirList(cachePath, CACHE_FILE_EXT, DirList::Files);
+
+    for(int i = 0; i < dirList.GetFilecount(); i++)
+        unlink(dirList.GetFilepath(i));
+
+    cacheMutex.lock();
+    entries.clear();
+    totalSize = 0;
+    useCounter = 0;
+    cacheMutex.unlock();
+}
+
+void TextureDiskCache::loadIndex(void)
+{
+    std::string indexPath = cachePath + CACHE_INDEX_FILE;
+
+    CFile file(indexPath, CFile::ReadOnly);
+    if(!file.isOpen())
+    {
+        //! without an index the entries on disk are unknown, start over
+        clear();
+        return;
+    }
+
+    u32 indexHeader[4];
+    if(file.read((u8*)indexHeader, sizeof(indexHeader)) != (int)sizeof(indexHeader)
+       || indexHeader[0] != CACHE_INDEX_MAGIC || indexHeader[1] != CACHE_VERSION
+       || file.size() != (sizeof(indexHeader) + indexHeader[2] * (sizeof(u32) + sizeof(CacheEntry))))
+    {
+        file.close();
+        clear();
+        unlink(indexPath.c_str());
+        return;
+    }
+
+    u32 count = indexHeader[2];
+    useCounter = indexHeader[3];
+
+    for(u32 i = 0; i < count; i++)
+    {
+        u32 hash;
+        CacheEntry entry;
+        if(file.read((u8*)&hash, sizeof(hash)) != (int)sizeof(hash) || file.read((u8*)&entry, sizeof(entry)) != (int)sizeof(entry))
+            break;
+
+        entries[hash] = entry;
+        totalSize += entry.fileSize;
+    }
+    file.close();
+
+    //! the index is written back on exit, if we never get there the
+    //! next start will not trust stale data and rebuild the cache
+    unlink(indexPath.c_str());
+
+    log_printf("Texture cache: %i entries, %i kB\n", entries.size(), totalSize >> 10);
+}
+
+void TextureDiskCache::saveIndex(void)
+{
+    CFile file(cachePath + CACHE_INDEX_FILE, CFile::WriteOnly);
+    if(!file.isOpen())
+        return;
+
+    u32 indexHeader[4];
+    indexHeader[0] = CACHE_INDEX_MAGIC;
+    indexHeader[1] = CACHE_VERSION;
+    indexHeader[2] = entries.size();
+    indexHeader[3] = useCounter;
+    file.write((const u8*)indexHeader, sizeof(indexHeader));
+
+    for(std::map<u32, CacheEntry>::iterator itr = entries.begin(); itr != entries.end(); ++itr)
+    {
+        file.write((const u8*)&itr->first, sizeof(itr->first));
+        file.write((const u8*)&itr->second, sizeof(itr->second));
+    }
+    file.close();
+}
@@ -0,0 +1,99 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _TEXTURE_DISK_CACHE_H_
+#define _TEXTURE_DISK_CACHE_H_
+
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <gctypes.h>
+#include "dynamic_libs/gx2_types.h"
+#include "system/CMutex.h"
+
+//! forward declaration
+class GuiImageData;
+
+//!Stores converted texture surfaces on the SD card so that images from the
+//!game folders are only decoded once. Each entry holds the raw surface as
+//!GX2InitTexture lays it out and is read back with a single read.
+class TextureDiskCache
+{
+public:
+    static TextureDiskCache *instance() {
+        if(!cacheInstance)
+            cacheInstance = new TextureDiskCache();
+
+        return cacheInstance;
+    }
+
+    static void destroyInstance() {
+        delete cacheInstance;
+        cacheInstance = NULL;
+    }
+
+    //!Load an image file through the cache
+    //!\param filepath Path of the source image
+    //!\return new image data or NULL if the image could not be loaded
+    GuiImageData * loadImage(const std::string & filepath, int textureClamp = GX2_TEX_CLAMP_CLAMP, int textureFormat = GX2_SURFACE_FORMAT_TCS_R8_G8_B8_A8_UNORM);
+    //!Remove all cache entries
+    void clear();
+private:
+    TextureDiskCache();
+    ~TextureDiskCache();
+
+    static TextureDiskCache *cacheInstance;
+
+    typedef struct
+    {
+        u32 magic;
+        u32 version;
+        u32 requestFormat;
+        u32 format;
+        u32 width;
+        u32 height;
+        u32 pitch;
+        u32 imageSize;
+        u32 sourceSize;
+        u32 sourceMtime;
+        u32 pathLength;
+    } CacheHeader;
+
+    typedef struct
+    {
+        u32 fileSize;
+        u32 lastUse;
+    } CacheEntry;
+
+    static u32 hashPath(const std::string & filepath);
+    std::string entryPath(u32 hash) const;
+
+    bool readEntry(const std::string & filepath, const struct stat & filestat, GuiImageData *imgData, int textureClamp, int textureFormat);
+    void writeEntry(const std::string & filepath, const struct stat & filestat, const GuiImageData *imgData, int textureFormat);
+    void removeEntry(u32 hash);
+    void evictEntries(void);
+
+    void loadIndex(void);
+    void saveIndex(void);
+
+    std::string cachePath;
+    std::map<u32, CacheEntry> entries;
+    u32 totalSize;
+    u32 useCounter;
+    CMutex cacheMutex;
+};
+
+#endif // _TEXTURE_DISK_CACHE_H_
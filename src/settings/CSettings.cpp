@@ -104,6 +104,10 @@ void CSettings::SetDefault()
     settingsNames[ConsoleRegionCode] = "ConsoleRegionCode";
     settingsValues[ConsoleRegionCode].dataType = TypeString;
     settingsValues[ConsoleRegionCode].strValue = new std::string("EN");
+
+    settingsNames[TvAntiAliasing] = "TvAntiAliasing";
+    settingsValues[TvAntiAliasing].dataType = TypeU8;
+    settingsValues[TvAntiAliasing].ucValue = AA_MODE_ALWAYS;
 }
 
 bool CSettings::Load()
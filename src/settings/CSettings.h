@@ -76,6 +76,7 @@ public:
         BgMusicPath,
         GameCover3DPath,
         ConsoleRegionCode,
+        TvAntiAliasing,
         MAX_VALUE
     };
 
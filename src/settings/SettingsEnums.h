@@ -14,4 +14,11 @@ enum eGameSaveModes
     GAME_SAVES_UNIQUE
 };
 
+enum eAntiAliasingModes
+{
+    AA_MODE_OFF,
+    AA_MODE_STILL,
+    AA_MODE_ALWAYS
+};
+
 #endif // SETTINGS_ENUMS_H_
@@ -28,80 +28,46 @@
 #include "BufferCircle.hpp"
 
 BufferCircle::BufferCircle()
+	: readPos(0)
+	, writePos(0)
 {
-	which = 0;
 	BufferBlockSize = 0;
 }
 
 BufferCircle::~BufferCircle()
 {
 	FreeBuffer();
-	SoundBuffer.clear();
-	BufferSize.clear();
-	BufferReady.clear();
 }
 
-void BufferCircle::SetBufferBlockSize(int size)
+bool BufferCircle::Allocate(int count, int size)
 {
-	if(size < 0)
-		return;
+	FreeBuffer();
+
+	//! at least one block has to be free for the producer
+	if(count <= (int)PlayingBlocks || size <= 0)
+		return false;
 
 	BufferBlockSize = size;
+	SoundBuffer.resize(count, NULL);
+	BufferSize.resize(count, 0);
 
-	for(int i = 0; i < Size(); i++)
+	for(int i = 0; i < count; i++)
 	{
-		if(SoundBuffer[i] != NULL)
-			free(SoundBuffer[i]);
-
 		SoundBuffer[i] = (u8 *) memalign(32, ALIGN32(BufferBlockSize));
-		BufferSize[i] = 0;
-		BufferReady[i] = false;
+		if(!SoundBuffer[i])
+		{
+			FreeBuffer();
+			return false;
+		}
 	}
-}
 
-void BufferCircle::Resize(int size)
-{
-	while(size < Size())
-		RemoveBuffer(Size()-1);
-
-	int oldSize = Size();
-
-	SoundBuffer.resize(size);
-	BufferSize.resize(size);
-	BufferReady.resize(size);
-
-	for(int i = oldSize; i < Size(); i++)
-	{
-		if(BufferBlockSize > 0)
-			SoundBuffer[i] = (u8 *) memalign(32, ALIGN32(BufferBlockSize));
-		else
-			SoundBuffer[i] = NULL;
-		BufferSize[i] = 0;
-		BufferReady[i] = false;
-	}
-}
-
-void BufferCircle::RemoveBuffer(int pos)
-{
-	if(!Valid(pos))
-		return;
-
-	if(SoundBuffer[pos] != NULL)
-		free(SoundBuffer[pos]);
-
-	SoundBuffer.erase(SoundBuffer.begin()+pos);
-	BufferSize.erase(BufferSize.begin()+pos);
-	BufferReady.erase(BufferReady.begin()+pos);
+	return true;
 }
 
 void BufferCircle::ClearBuffer()
 {
-	for(int i = 0; i < Size(); i++)
-	{
-		BufferSize[i] = 0;
-		BufferReady[i] = false;
-	}
-	which = 0;
+	readPos.store(0, std::memory_order_relaxed);
+	writePos.store(0, std::memory_order_release);
 }
 
 void BufferCircle::FreeBuffer()
@@ -110,33 +76,53 @@ void BufferCircle::FreeBuffer()
 	{
 		if(SoundBuffer[i] != NULL)
 			free(SoundBuffer[i]);
-
-		SoundBuffer[i] = NULL;
-		BufferSize[i] = 0;
-		BufferReady[i] = false;
 	}
+
+	SoundBuffer.clear();
+	BufferSize.clear();
+	BufferBlockSize = 0;
+	ClearBuffer();
 }
 
-void BufferCircle::LoadNext()
+u8 * BufferCircle::GetWriteBuffer()
 {
-	BufferReady[which] = false;
-	BufferSize[which] = 0;
+	if(SoundBuffer.empty())
+		return NULL;
+
+	u32 write = writePos.load(std::memory_order_relaxed);
+	u32 read = readPos.load(std::memory_order_acquire);
+
+	//! the blocks handed to the voice last are still being played
+	if(write - read >= SoundBuffer.size() - PlayingBlocks)
+		return NULL;
 
-	which = Next();
+	return SoundBuffer[Index(write)];
 }
 
-void BufferCircle::SetBufferReady(int pos, bool state)
+void BufferCircle::CommitWriteBuffer(u32 size)
 {
-	if(!Valid(pos))
-		return;
+	u32 write = writePos.load(std::memory_order_relaxed);
+	BufferSize[Index(write)] = size;
+	writePos.store(write + 1, std::memory_order_release);
+}
 
-	BufferReady[pos] = state;
+u32 BufferCircle::GetQueuedBytes()
+{
+	u32 read = readPos.load(std::memory_order_relaxed);
+	u32 write = writePos.load(std::memory_order_acquire);
+	u32 bytes = 0;
+
+	for(u32 pos = read; pos != write; pos++)
+		bytes += BufferSize[Index(pos)];
+
+	return bytes;
 }
 
-void BufferCircle::SetBufferSize(int pos, int size)
+void BufferCircle::LoadNext()
 {
-	if(!Valid(pos))
+	u32 read = readPos.load(std::memory_order_relaxed);
+	if(read == writePos.load(std::memory_order_acquire))
 		return;
 
-	BufferSize[pos] = size;
+	readPos.store(read + 1, std::memory_order_release);
 }
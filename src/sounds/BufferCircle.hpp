@@ -26,61 +26,60 @@
 #ifndef BUFFER_CIRCLE_HPP_
 #define BUFFER_CIRCLE_HPP_
 
+#include <atomic>
 #include <vector>
 #include <gctypes.h>
 
+//!Single producer / single consumer ring of PCM blocks. The decoder thread
+//!fills blocks at the write index and the AX frame callback takes them at
+//!the read index, each side only ever moves its own index.
 class BufferCircle
 {
 	public:
+		//!> Blocks behind the read index that are still played by the voice
+		static const u32 PlayingBlocks = 2;
+
 		//!> Constructor
 		BufferCircle();
 		//!> Destructor
 		~BufferCircle();
-		//!> Set circle size
-		void Resize(int size);
+		//!> Allocate count blocks of size bytes each, drops all queued blocks
+		bool Allocate(int count, int size);
 		//!> Get the circle size
 		int Size() { return SoundBuffer.size(); };
-		//!> Set/resize the buffer size
-		void SetBufferBlockSize(int size);
-		//!> Remove a buffer
-		void RemoveBuffer(int pos);
-		//!> Set all buffers clear
+		//!> Get the size of a block
+		u32 GetBufferBlockSize() { return BufferBlockSize; };
+		//!> Drop all queued blocks, both sides have to be idle
 		void ClearBuffer();
 		//!> Free all buffers
 		void FreeBuffer();
-		//!> Switch to next buffer
-		void LoadNext();
-		//!> Get the current buffer
-		u8 * GetBuffer() { return GetBuffer(which); };
-		//!> Get a buffer at a position
-		u8 * GetBuffer(int pos) { if(!Valid(pos)) return NULL; else return SoundBuffer[pos]; };
-		//!> Get current buffer size
-		u32 GetBufferSize() { return GetBufferSize(which); };
-		//!> Get buffer size at position
-		u32 GetBufferSize(int pos) { if(!Valid(pos)) return 0; else return BufferSize[pos]; };
-		//!> Is current buffer ready
-		bool IsBufferReady() { return IsBufferReady(which); };
-		//!> Is  a buffer at a position ready
-		bool IsBufferReady(int pos) { if(!Valid(pos)) return false; else return BufferReady[pos]; };
-		//!> Set a buffer at a position to a ready state
-		void SetBufferReady(int pos, bool st);
-		//!> Set the buffersize at a position
-		void SetBufferSize(int pos, int size);
-		//!> Get the current position in the circle
-		u16 Which() { return which; };
 
-		//!> Get the next location
-		inline u16 Next() { return (which+1 >= Size()) ? 0 : which+1; }
-		inline u16 Prev() { if(Size() == 0) return 0; else return ((int)which-1 < 0) ? Size()-1 : which-1; }
+		//!> Producer: get the block to fill or NULL if the circle is full
+		u8 * GetWriteBuffer();
+		//!> Producer: queue the filled block
+		void CommitWriteBuffer(u32 size);
+
+		//!> Consumer: is a queued block available
+		bool IsBufferReady() { return writePos.load(std::memory_order_acquire) != readPos.load(std::memory_order_relaxed); };
+		//!> Consumer: get the oldest queued block
+		u8 * GetBuffer() { return SoundBuffer.empty() ? NULL : SoundBuffer[Index(readPos.load(std::memory_order_relaxed))]; };
+		//!> Consumer: get the size of the oldest queued block
+		u32 GetBufferSize() { return SoundBuffer.empty() ? 0 : BufferSize[Index(readPos.load(std::memory_order_relaxed))]; };
+		//!> Consumer: release the oldest queued block
+		void LoadNext();
+		//!> Consumer: number of queued blocks
+		u32 GetQueuedBlocks() { return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_relaxed); };
+		//!> Consumer: number of queued bytes
+		u32 GetQueuedBytes();
 	protected:
-		//!> Check if the position is a valid position in the vector
-		bool Valid(int pos) { return !(pos < 0 || pos >= Size()); };
+		u32 Index(u32 pos) { return pos % SoundBuffer.size(); };
 
-		u16 which;
 		u32 BufferBlockSize;
 		std::vector<u8 *> SoundBuffer;
 		std::vector<u32> BufferSize;
-		std::vector<bool> BufferReady;
+		//!> free running counters, only the producer writes writePos and only the consumer readPos
+		std::atomic<u32> readPos;
+		std::atomic<u32> writePos;
 };
 
 #endif
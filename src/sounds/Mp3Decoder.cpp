@@ -82,6 +82,10 @@ Mp3Decoder::~Mp3Decoder()
 void Mp3Decoder::OpenFile()
 {
 	GuardPtr = NULL;
+
+	//! music streams, bigger blocks wake the decoder up less often
+	SetBufferBlocks(8, 0x8000);
+
 	ReadBuffer = (u8 *) memalign(32, SoundBlockSize*SoundBlocks);
 	if(!ReadBuffer)
 	{
@@ -124,49 +128,28 @@ int Mp3Decoder::Rewind()
 	return SoundDecoder::Rewind();
 }
 
-static inline s16 FixedToShort(mad_fixed_t Fixed)
-{
-	/* Clipping */
-	if(Fixed>=MAD_F_ONE)
-		return(SHRT_MAX);
-	if(Fixed<=-MAD_F_ONE)
-		return(-SHRT_MAX);
-
-	Fixed=Fixed>>(MAD_F_FRACBITS-15);
-	return((s16)Fixed);
-}
-
-int Mp3Decoder::Read(u8 * buffer, int buffer_size, int pos)
+//! convert a run of libmad samples to 16 bit, step is the distance between two output samples
+static void FixedToShort(s16 *out, const mad_fixed_t *in, u32 count, u32 step)
 {
-	if(!file_fd)
-		return -1;
+	for(u32 i = 0; i < count; i++)
+	{
+		s32 sample = in[i] >> (MAD_F_FRACBITS - 15);
 
-	if(Format == (FORMAT_PCM_16_BIT | CHANNELS_STEREO))
-		buffer_size &= ~0x0003;
-	else
-		buffer_size &= ~0x0001;
+		//! saturate without branches, the masks are all ones where the limit is exceeded
+		s32 over = (SHRT_MAX - sample) >> 31;
+		sample = (sample & ~over) | (SHRT_MAX & over);
+		s32 under = (sample + SHRT_MAX) >> 31;
+		sample = (sample & ~under) | (-SHRT_MAX & under);
 
-	u8 * write_pos = buffer;
-	u8 * write_end = buffer+buffer_size;
+		*out = (s16)sample;
+		out += step;
+	}
+}
 
+bool Mp3Decoder::DecodeFrame()
+{
 	while(1)
 	{
-		while(SynthPos < Synth.pcm.length)
-		{
-			if(write_pos >= write_end)
-				return write_pos-buffer;
-
-			*((s16 *) write_pos) = FixedToShort(Synth.pcm.samples[0][SynthPos]);
-			write_pos += 2;
-
-			if(MAD_NCHANNELS(&Frame.header) == 2)
-			{
-				*((s16 *) write_pos) = FixedToShort(Synth.pcm.samples[1][SynthPos]);
-				write_pos += 2;
-			}
-			SynthPos++;
-		}
-
 		if(Stream.buffer == NULL || Stream.error == MAD_ERROR_BUFLEN)
 		{
 			u8 * ReadStart = ReadBuffer;
@@ -202,16 +185,92 @@ int Mp3Decoder::Read(u8 * buffer, int buffer_size, int pos)
 			}
 			else
 			{
-				if(Stream.error != MAD_ERROR_BUFLEN)
-					return -1;
-				else if(Stream.error == MAD_ERROR_BUFLEN && GuardPtr)
-					return -1;
+				if(Stream.error != MAD_ERROR_BUFLEN || GuardPtr)
+					return false;
+
+				//! refill the stream instead of synthesizing the last frame again
+				continue;
 			}
 		}
 
 		mad_timer_add(&Timer,Frame.header.duration);
 		mad_synth_frame(&Synth,&Frame);
 		SynthPos = 0;
+		return true;
 	}
-	return 0;
+}
+
+int Mp3Decoder::Read(u8 * buffer, int buffer_size, int pos)
+{
+	if(!file_fd)
+		return -1;
+
+	bool stereo = (Format == (FORMAT_PCM_16_BIT | CHANNELS_STEREO));
+	u32 frameSize = stereo ? 4 : 2;
+	u32 frames = buffer_size / frameSize;
+	u32 done = 0;
+
+	while(done < frames)
+	{
+		if(SynthPos >= Synth.pcm.length)
+		{
+			if(!DecodeFrame())
+				return (done > 0) ? (int)(done * frameSize) : -1;
+			continue;
+		}
+
+		u32 count = Synth.pcm.length - SynthPos;
+		if(count > frames - done)
+			count = frames - done;
+
+		s16 *out = ((s16 *) buffer) + (stereo ? (done << 1) : done);
+		const mad_fixed_t *left = &Synth.pcm.samples[0][SynthPos];
+
+		if(stereo)
+		{
+			const mad_fixed_t *right = (MAD_NCHANNELS(&Frame.header) == 2) ? &Synth.pcm.samples[1][SynthPos] : left;
+			FixedToShort(out, left, count, 2);
+			FixedToShort(out + 1, right, count, 2);
+		}
+		else
+		{
+			FixedToShort(out, left, count, 1);
+		}
+
+		SynthPos += count;
+		done += count;
+	}
+
+	return done * frameSize;
+}
+
+int Mp3Decoder::ReadPlanar(s16 * left, s16 * right, int frames)
+{
+	if(!file_fd)
+		return -1;
+
+	int done = 0;
+
+	while(done < frames)
+	{
+		if(SynthPos >= Synth.pcm.length)
+		{
+			if(!DecodeFrame())
+				return (done > 0) ? done : -1;
+			continue;
+		}
+
+		u32 count = Synth.pcm.length - SynthPos;
+		if(count > (u32)(frames - done))
+			count = frames - done;
+
+		int channel = (MAD_NCHANNELS(&Frame.header) == 2) ? 1 : 0;
+		FixedToShort(left + done, &Synth.pcm.samples[0][SynthPos], count, 1);
+		FixedToShort(right + done, &Synth.pcm.samples[channel][SynthPos], count, 1);
+
+		SynthPos += count;
+		done += count;
+	}
+
+	return done;
 }
@@ -35,8 +35,11 @@ class Mp3Decoder : public SoundDecoder
 		virtual ~Mp3Decoder();
 		int Rewind();
 		int Read(u8 * buffer, int buffer_size, int pos);
+		bool SupportsPlanarRead() { return true; }
+		int ReadPlanar(s16 * left, s16 * right, int frames);
 	protected:
 		void OpenFile();
+		bool DecodeFrame();
 		struct mad_stream Stream;
 		struct mad_frame Frame;
 		struct mad_synth Synth;
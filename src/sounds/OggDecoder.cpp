@@ -90,6 +90,9 @@ OggDecoder::~OggDecoder()
 
 void OggDecoder::OpenFile()
 {
+	//! music streams, bigger blocks wake the decoder up less often
+	SetBufferBlocks(8, 0x8000);
+
 	if (ov_open_callbacks(file_fd, &ogg_file, NULL, 0, callbacks) < 0)
 	{
 		delete file_fd;
@@ -16,13 +16,29 @@
  ****************************************************************************/
 #include <gctypes.h>
 #include <malloc.h>
+#include <math.h>
 #include <string.h>
 #include <unistd.h>
 #include "dynamic_libs/os_functions.h"
 #include "SoundDecoder.hpp"
 
-static const u32 FixedPointShift = 15;
-static const u32 FixedPointScale = 1 << FixedPointShift;
+//! FIR length of each polyphase filter
+static const u32 ResampleTaps = 16;
+//! more phases than this means an odd rate, leave those to the AX sample rate converter
+static const u32 ResampleMaxPhases = 1024;
+//! coefficients are stored as Q15
+static const u32 ResampleCoeffShift = 15;
+
+static u32 GreatestCommonDivisor(u32 a, u32 b)
+{
+	while(b)
+	{
+		u32 t = a % b;
+		a = b;
+		b = t;
+	}
+	return a;
+}
 
 SoundDecoder::SoundDecoder()
 {
@@ -58,6 +74,10 @@ SoundDecoder::~SoundDecoder()
 
 	if(ResampleBuffer)
 		free(ResampleBuffer);
+	if(ResampleCoeffs)
+		free(ResampleCoeffs);
+	if(ChannelBuffer)
+		free(ChannelBuffer);
 }
 
 void SoundDecoder::Init()
@@ -67,15 +87,73 @@ void SoundDecoder::Init()
 	SoundBlockSize = 0x4000;
 	ResampleTo48kHz = false;
 	CurPos = 0;
-	whichLoad = 0;
 	Loop = false;
 	EndOfFile = false;
 	Decoding = false;
 	ExitRequested = false;
-	SoundBuffer.SetBufferBlockSize(SoundBlockSize);
-	SoundBuffer.Resize(SoundBlocks);
+	StereoOutput = false;
+	SoundBuffer.Allocate(SoundBlocks, SoundBlockSize);
+	LowWaterBlocks = (SoundBlocks - BufferCircle::PlayingBlocks) / 2;
 	ResampleBuffer = NULL;
-	ResampleRatio = 0;
+	ChannelBuffer = NULL;
+	ResampleCoeffs = NULL;
+	ResampleUp = 0;
+	ResampleDown = 0;
+	ResetResampler();
+}
+
+bool SoundDecoder::SetBufferBlocks(u16 blocks, int blockSize)
+{
+	if(Decoding)
+		return false;
+
+	//! the resampler read size and history are made for the old block size
+	bool upsample = (ResampleBuffer != NULL);
+	if(upsample)
+	{
+		SampleRate = 48000 * ResampleDown / ResampleUp;
+		free(ResampleBuffer);
+		free(ResampleCoeffs);
+		ResampleBuffer = NULL;
+		ResampleCoeffs = NULL;
+		ResampleUp = 0;
+		ResampleDown = 0;
+	}
+
+	if(ChannelBuffer)
+	{
+		free(ChannelBuffer);
+		ChannelBuffer = NULL;
+	}
+
+	bool result = SoundBuffer.Allocate(blocks, blockSize);
+	if(!result)
+	{
+		//! keep the decoder usable with the default blocks
+		blocks = 8;
+		blockSize = 0x4000;
+		SoundBuffer.Allocate(blocks, blockSize);
+	}
+
+	SoundBlocks = blocks;
+	SoundBlockSize = blockSize;
+	LowWaterBlocks = (SoundBlocks - BufferCircle::PlayingBlocks) / 2;
+	ResetResampler();
+
+	if(upsample)
+		EnableUpsample();
+
+	return result;
+}
+
+u32 SoundDecoder::GetQueuedTime()
+{
+	u32 rate = (ResampleBuffer && ResampleUp) ? 48000 : SampleRate;
+	u32 frameSize = (Is16Bit() ? 2 : 1) * (IsStereoOutput() ? 2 : 1);
+	if(rate == 0)
+		return 0;
+
+	return (u32)((u64)SoundBuffer.GetQueuedBytes() * 1000000 / (frameSize * rate));
 }
 
 int SoundDecoder::Rewind()
@@ -97,72 +175,228 @@ int SoundDecoder::Read(u8 * buffer, int buffer_size, int pos)
 
 void SoundDecoder::EnableUpsample(void)
 {
-	if(   (ResampleBuffer == NULL)
-	   && IsStereo() && Is16Bit()
-	   && SampleRate != 32000
-	   && SampleRate != 48000)
+	if(ResampleBuffer || !Is16Bit() || SampleRate == 0 || SampleRate == 48000)
+		return;
+
+	//! output rate = input rate * ResampleUp / ResampleDown
+	u32 gcd = GreatestCommonDivisor(48000, SampleRate);
+	u32 up = 48000 / gcd;
+	u32 down = SampleRate / gcd;
+	if(up > ResampleMaxPhases || down > up * ResampleTaps)
+		return;
+
+	//! read as much as still fits into a sound block after the conversion
+	u32 frameSize = (IsStereo() ? 2 : 1) * sizeof(s16);
+	int outFrames = SoundBlockSize / frameSize;
+	int readFrames = ((outFrames - 1) * down) / up - 2 * ResampleTaps;
+	if(readFrames <= 0)
+		return;
+
+	ResampleCoeffs = (s16*)memalign(32, up * ResampleTaps * sizeof(s16));
+	ResampleBuffer = (u8*)memalign(32, (readFrames + 2 * ResampleTaps) * frameSize);
+	if(!ResampleCoeffs || !ResampleBuffer)
 	{
-		ResampleBuffer = (u8*)memalign(32, SoundBlockSize);
-		ResampleRatio =  ( FixedPointScale * SampleRate ) / 48000;
-		SoundBlockSize = ( SoundBlockSize * ResampleRatio ) / FixedPointScale;
-		SoundBlockSize &= ~0x03;
-		// set new sample rate
-		SampleRate = 48000;
+		if(ResampleCoeffs)
+			free(ResampleCoeffs);
+		if(ResampleBuffer)
+			free(ResampleBuffer);
+		ResampleCoeffs = NULL;
+		ResampleBuffer = NULL;
+		return;
+	}
+
+	//! Blackman windowed sinc, cut off a bit below the lower of both nyquist frequencies
+	f32 cutoff = 0.45f * ((up < down) ? ((f32)up / (f32)down) : 1.0f);
+
+	for(u32 phase = 0; phase < up; phase++)
+	{
+		s16 *coeffs = ResampleCoeffs + phase * ResampleTaps;
+		f32 taps[ResampleTaps];
+		f32 sum = 0.0f;
+
+		for(u32 t = 0; t < ResampleTaps; t++)
+		{
+			//! distance of the input sample to the output position
+			f32 x = (f32)t - (f32)(ResampleTaps / 2 - 1) - (f32)phase / (f32)up;
+			f32 sinc = (x == 0.0f) ? 1.0f : sinf((f32)M_PI * 2.0f * cutoff * x) / ((f32)M_PI * 2.0f * cutoff * x);
+			f32 w = (x + (f32)(ResampleTaps / 2)) / (f32)ResampleTaps;
+			f32 window = 0.42f - 0.5f * cosf(2.0f * (f32)M_PI * w) + 0.08f * cosf(4.0f * (f32)M_PI * w);
+
+			taps[t] = sinc * window;
+			sum += taps[t];
+		}
+
+		//! unity gain on every phase so that the phases do not modulate the signal
+		for(u32 t = 0; t < ResampleTaps; t++)
+			coeffs[t] = (s16)lrintf(taps[t] / sum * (f32)(1 << ResampleCoeffShift));
 	}
+
+	ResampleUp = up;
+	ResampleDown = down;
+	ResetResampler();
+
+	SoundBlockSize = readFrames * frameSize;
+	// set new sample rate
+	SampleRate = 48000;
 }
 
-void SoundDecoder::Upsample(s16 *src, s16 *dst, u32 nr_src_samples, u32 nr_dst_samples)
+void SoundDecoder::ResetResampler(void)
 {
-	int timer = 0;
+	ResamplePhase = 0;
+	ResampleFrames = 0;
 
-	for(u32 i = 0, n = 0; i < nr_dst_samples; i += 2)
+	//! start with silence as history so the first block can be filtered completely
+	if(ResampleBuffer)
 	{
-		if((n+3) < nr_src_samples) {
-			// simple fixed point linear interpolation
-			dst[i]   = src[n] +   ( ((src[n+2] - src[n]  ) * timer) >> FixedPointShift );
-			dst[i+1] = src[n+1] + ( ((src[n+3] - src[n+1]) * timer) >> FixedPointShift );
+		ResampleFrames = ResampleTaps - 1;
+		memset(ResampleBuffer, 0, ResampleFrames * (IsStereo() ? 2 : 1) * sizeof(s16));
+	}
+}
+
+int SoundDecoder::Resample(u8 *buffer, int size)
+{
+	u32 channels = IsStereo() ? 2 : 1;
+	u32 frameSize = channels * sizeof(s16);
+
+	//! append the new block to the frames kept from the last one
+	memcpy(ResampleBuffer + ResampleFrames * frameSize, buffer, size);
+
+	const s16 *src = (const s16*)ResampleBuffer;
+	s16 *dst = (s16*)buffer;
+	u32 totalFrames = ResampleFrames + size / frameSize;
+	u32 pos = 0;
+	u32 phase = ResamplePhase;
+	u32 out = 0;
+
+	while(pos + ResampleTaps <= totalFrames)
+	{
+		const s16 *coeffs = ResampleCoeffs + phase * ResampleTaps;
+		const s16 *in = src + pos * channels;
+
+		for(u32 ch = 0; ch < channels; ch++)
+		{
+			s32 acc = 0;
+			for(u32 t = 0; t < ResampleTaps; t++)
+				acc += in[t * channels + ch] * coeffs[t];
+
+			acc >>= ResampleCoeffShift;
+			if(acc > 32767)
+				acc = 32767;
+			else if(acc < -32768)
+				acc = -32768;
+
+			dst[out * channels + ch] = (s16)acc;
 		}
-		else {
-			dst[i]   = src[n];
-			dst[i+1] = src[n+1];
+		out++;
+
+		phase += ResampleDown;
+		while(phase >= ResampleUp)
+		{
+			phase -= ResampleUp;
+			pos++;
 		}
+	}
 
-		timer += ResampleRatio;
+	//! keep what the filter still needs for the next block
+	ResamplePhase = phase;
+	ResampleFrames = totalFrames - pos;
+	memmove(ResampleBuffer, ResampleBuffer + pos * frameSize, ResampleFrames * frameSize);
 
-		if(timer >= (int)FixedPointScale) {
-			n += 2;
-			timer -= FixedPointScale;
-		}
+	return out * frameSize;
+}
+
+int SoundDecoder::SplitChannels(u8 *buffer, int size)
+{
+	if(!ChannelBuffer)
+	{
+		ChannelBuffer = (u8*)memalign(32, SoundBuffer.GetBufferBlockSize());
+		if(!ChannelBuffer)
+			return MixToMono(buffer, size);
+	}
+
+	int frames = size >> 2;
+	memcpy(ChannelBuffer, buffer, frames << 2);
+
+	//! all left samples first and all right samples behind them, one AX voice plays each half
+	const s16 *src = (const s16*)ChannelBuffer;
+	s16 *left = (s16*)buffer;
+	s16 *right = left + frames;
+
+	for(int i = 0; i < frames; i++)
+	{
+		left[i] = src[i << 1];
+		right[i] = src[(i << 1) + 1];
 	}
+
+	return frames << 2;
 }
 
-void SoundDecoder::Decode()
+int SoundDecoder::MixToMono(u8 *buffer, int size)
 {
-	if(!file_fd || ExitRequested || EndOfFile)
-		return;
+	s16 *monoBuf = (s16*)buffer;
+	int done = size >> 1;
 
-	// check if we are not at the pre-last buffer (last buffer is playing)
-	u16 whichPlaying = SoundBuffer.Which();
-	if(	   ((whichPlaying == 0) && (whichLoad == SoundBuffer.Size()-2))
-		|| ((whichPlaying == 1) && (whichLoad == SoundBuffer.Size()-1))
-        || (whichLoad == (whichPlaying-2)))
+	if(!Is16Bit())
 	{
-		return;
+		for(int i = 0; i < done; i++)
+			monoBuf[i] = monoBuf[i << 1];
+		return done;
 	}
 
-	Decoding = true;
+	int frames = size >> 2;
+	for(int i = 0; i < frames; i++)
+		monoBuf[i] = (monoBuf[i << 1] + monoBuf[(i << 1) + 1]) >> 1;
 
-	int done  = 0;
-	u8 * write_buf = SoundBuffer.GetBuffer(whichLoad);
-	if(!write_buf)
+	return frames << 1;
+}
+
+bool SoundDecoder::DecodePlanarBlock(u8 *write_buf)
+{
+	int frames = SoundBlockSize >> 2;
+	s16 *left = (s16*)write_buf;
+	s16 *right = left + frames;
+	int done = 0;
+
+	while(done < frames)
 	{
-		ExitRequested = true;
-		Decoding = false;
-		return;
+		int ret = ReadPlanar(left + done, right + done, frames - done);
+
+		if(ret <= 0)
+		{
+			if(Loop)
+			{
+				Rewind();
+				continue;
+			}
+			else
+			{
+				EndOfFile = true;
+				break;
+			}
+		}
+
+		done += ret;
 	}
 
-	if(ResampleTo48kHz && !ResampleBuffer)
-		EnableUpsample();
+	if(done <= 0)
+		return false;
+
+	//! the right channel has to follow the left one directly
+	if(done < frames)
+		memmove(left + done, right, done * sizeof(s16));
+
+	DCFlushRange(write_buf, done << 2);
+	SoundBuffer.CommitWriteBuffer(done << 2);
+	return true;
+}
+
+bool SoundDecoder::DecodeBlock(u8 *write_buf)
+{
+	//! decoders with planar output save the split of the interleaved frames
+	if(IsStereoOutput() && !(ResampleBuffer && ResampleUp) && SupportsPlanarRead())
+		return DecodePlanarBlock(write_buf);
+
+	int done  = 0;
 
 	while(done < SoundBlockSize)
 	{
@@ -185,41 +419,40 @@ void SoundDecoder::Decode()
 		done += ret;
 	}
 
-	if(done > 0)
-	{
-		// check if we need to resample
-		if(ResampleBuffer && ResampleRatio)
-		{
-			memcpy(ResampleBuffer, write_buf, done);
+	if(done <= 0)
+		return false;
 
-			int src_samples = done >> 1;
-			int dest_samples = ( src_samples * FixedPointScale ) / ResampleRatio;
-			dest_samples &= ~0x01;
-			Upsample((s16*)ResampleBuffer, (s16*)write_buf, src_samples, dest_samples);
-			done = dest_samples << 1;
-		}
+	// check if we need to resample
+	if(ResampleBuffer && ResampleUp)
+		done = Resample(write_buf, done);
 
-		//! TODO: remove this later and add STEREO support with two voices, for now we convert to MONO
-		if(IsStereo())
-		{
-            s16* monoBuf = (s16*)write_buf;
-			done = done >> 1;
+	if(IsStereoOutput())
+		done = SplitChannels(write_buf, done);
+	else if(IsStereo())
+		done = MixToMono(write_buf, done);
 
-            for(int i = 0; i < done; i++)
-                monoBuf[i] = monoBuf[i << 1];
-		}
+	DCFlushRange(write_buf, done);
+	SoundBuffer.CommitWriteBuffer(done);
+	return true;
+}
 
-        DCFlushRange(write_buf, done);
-		SoundBuffer.SetBufferSize(whichLoad, done);
-		SoundBuffer.SetBufferReady(whichLoad, true);
-		if(++whichLoad >= SoundBuffer.Size())
-			whichLoad = 0;
-	}
+void SoundDecoder::Decode()
+{
+	if(!file_fd || ExitRequested || EndOfFile)
+		return;
 
-	// check if next in queue needs to be filled as well and do so
-	if(!SoundBuffer.IsBufferReady(whichLoad))
-		Decode();
+	Decoding = true;
+
+	if(ResampleTo48kHz && !ResampleBuffer)
+		EnableUpsample();
+
+	//! fill every free block, the ones the voice still plays are never handed out
+	u8 * write_buf;
+	while(!EndOfFile && (write_buf = SoundBuffer.GetWriteBuffer()) != NULL)
+	{
+		if(!DecodeBlock(write_buf))
+			break;
+	}
 
 	Decoding = false;
 }
-
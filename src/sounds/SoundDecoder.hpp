@@ -40,6 +40,10 @@ public:
 	virtual void Lock() { mutex.lock(); }
 	virtual void Unlock() { mutex.unlock(); }
 	virtual int Read(u8 * buffer, int buffer_size, int pos);
+	//!Decoders that can write the channels of stereo sources into separate buffers
+	virtual bool SupportsPlanarRead() { return false; }
+	//!\return number of frames written to left and right or <= 0 at the end
+	virtual int ReadPlanar(s16 * left, s16 * right, int frames) { return -1; }
 	virtual int Tell() { return CurPos; }
 	virtual int Seek(int pos) { CurPos = pos; return file_fd->seek(CurPos, SEEK_SET); }
 	virtual int Rewind();
@@ -53,10 +57,18 @@ public:
 	virtual bool IsEOF() { return EndOfFile; }
 	virtual void SetLoop(bool l) { Loop = l; EndOfFile = false; }
 	virtual u8 GetSoundType() { return SoundType; }
-	virtual void ClearBuffer() { SoundBuffer.ClearBuffer(); whichLoad = 0; }
+	virtual void ClearBuffer() { SoundBuffer.ClearBuffer(); ResetResampler(); }
 	virtual bool IsStereo() { return (GetFormat() & CHANNELS_STEREO) != 0; }
 	virtual bool Is16Bit() { return ((GetFormat() & 0xFF) == FORMAT_PCM_16_BIT); }
 	virtual bool IsDecoding() { return Decoding; }
+	//!Stereo sources are played on two voices, otherwise they are mixed down to mono
+	virtual void SetStereoOutput(bool s) { StereoOutput = s; }
+	//!\return true if the buffers hold planar left and right channels
+	virtual bool IsStereoOutput() { return StereoOutput && IsStereo() && Is16Bit(); }
+	//!\return true if the queued blocks dropped to the low-water mark
+	virtual bool NeedsRefill() { return !EndOfFile && SoundBuffer.GetQueuedBlocks() <= LowWaterBlocks; }
+	//!\return play time of the queued blocks in microseconds
+	u32 GetQueuedTime();
 
 	void EnableUpsample(void);
 
@@ -80,13 +92,20 @@ public:
     };
 protected:
 	void Init();
-	void Upsample(s16 *src, s16 *dst, u32 nr_src_samples, u32 nr_dst_samples);
+	//!Set the number of decoded blocks and their size, an enabled resampler is set up again for the new size
+	bool SetBufferBlocks(u16 blocks, int blockSize);
+	bool DecodeBlock(u8 *write_buf);
+	bool DecodePlanarBlock(u8 *write_buf);
+	int Resample(u8 *buffer, int size);
+	int SplitChannels(u8 *buffer, int size);
+	int MixToMono(u8 *buffer, int size);
+	void ResetResampler(void);
 
 	CFile * file_fd;
 	BufferCircle SoundBuffer;
 	u8 SoundType;
-	u16 whichLoad;
 	u16 SoundBlocks;
+	u16 LowWaterBlocks;
 	int SoundBlockSize;
 	int CurPos;
 	bool ResampleTo48kHz;
@@ -94,10 +113,16 @@ protected:
 	bool EndOfFile;
 	bool Decoding;
 	bool ExitRequested;
+	bool StereoOutput;
 	u16 Format;
 	u16 SampleRate;
 	u8 *ResampleBuffer;
-	u32 ResampleRatio;
+	u8 *ChannelBuffer;
+	s16 *ResampleCoeffs;
+	u32 ResampleUp;
+	u32 ResampleDown;
+	u32 ResamplePhase;
+	u32 ResampleFrames;
 	CMutex mutex;
 };
 
@@ -39,25 +39,47 @@ SoundHandler::SoundHandler()
 {
 	Decoding = false;
 	ExitRequested = false;
+	StereoOutput = true;
+	Initialized = false;
 	for(u32 i = 0; i < MAX_DECODERS; ++i)
     {
 		DecoderList[i] = NULL;
         voiceList[i] = NULL;
+        decodePending[i].store(false);
     }
 
+    //! without a queue the thread leaves right away and no voices are created
+    decodeQueue = memalign(4, OS_MESSAGE_QUEUE_SIZE);
+    if(decodeQueue)
+        OSInitMessageQueue(decodeQueue, decodeMessages, MAX_DECODERS + 1);
+
     resumeThread();
 
     //! wait for initialization
-    while(!isThreadSuspended())
+    while(!Initialized)
         usleep(1000);
 }
 
 SoundHandler::~SoundHandler()
 {
 	ExitRequested = true;
-	ThreadSignal();
+
+	if(decodeQueue)
+	{
+		OSMessage message;
+		message.message = NULL;
+		message.args[0] = MAX_DECODERS;
+		message.args[1] = 0;
+		message.args[2] = 0;
+		OSSendMessage(decodeQueue, &message, OS_MESSAGE_BLOCK);
+	}
+
+	//! the thread has to be gone before its queue is freed
+	shutdownThread();
 
 	ClearDecoderList();
+	if(decodeQueue)
+		free(decodeQueue);
 }
 
 void SoundHandler::AddDecoder(int voice, const char * filepath)
@@ -68,7 +90,11 @@ void SoundHandler::AddDecoder(int voice, const char * filepath)
 	if(DecoderList[voice] != NULL)
 		RemoveDecoder(voice);
 
-	DecoderList[voice] = GetSoundDecoder(filepath);
+	SoundDecoder * decoder = GetSoundDecoder(filepath);
+	if(decoder)
+		decoder->SetStereoOutput(StereoOutput);
+
+	DecoderList[voice] = decoder;
 }
 
 void SoundHandler::AddDecoder(int voice, const u8 * snd, int len)
@@ -79,7 +105,11 @@ void SoundHandler::AddDecoder(int voice, const u8 * snd, int len)
 	if(DecoderList[voice] != NULL)
 		RemoveDecoder(voice);
 
-	DecoderList[voice] = GetSoundDecoder(snd, len);
+	SoundDecoder * decoder = GetSoundDecoder(snd, len);
+	if(decoder)
+		decoder->SetStereoOutput(StereoOutput);
+
+	DecoderList[voice] = decoder;
 }
 
 void SoundHandler::RemoveDecoder(int voice)
@@ -215,6 +245,12 @@ SoundDecoder * SoundHandler::GetSoundDecoder(const u8 * sound, int length)
 
 void SoundHandler::executeThread()
 {
+    if(!decodeQueue)
+    {
+        Initialized = true;
+        return;
+    }
+
     //! initialize 48 kHz renderer
     u32 params[3] = { 1, 0, 0 };
     AXInitWithParams(params);
@@ -229,13 +265,40 @@ void SoundHandler::executeThread()
     AXRegisterFrameCallback((void*)&axFrameCallback);
 
 
-	u16 i = 0;
+	Initialized = true;
+
 	while (!ExitRequested)
 	{
-		suspendThread();
+		OSMessage message;
+		OSReceiveMessage(decodeQueue, &message, OS_MESSAGE_BLOCK);
 
-		for(i = 0; i < MAX_DECODERS; ++i)
+		//! take everything that arrived meanwhile, the closest deadline is served first
+		OSMessage requests[MAX_DECODERS + 1];
+		u32 count = 0;
+		do
 		{
+			s64 deadline = ((s64)message.args[1] << 32) | message.args[2];
+			u32 n = count++;
+			while(n > 0 && (((s64)requests[n-1].args[1] << 32) | requests[n-1].args[2]) > deadline)
+			{
+				requests[n] = requests[n-1];
+				n--;
+			}
+			requests[n] = message;
+		}
+		while(count < (MAX_DECODERS + 1) && OSReceiveMessage(decodeQueue, &message, OS_MESSAGE_NOBLOCK));
+
+		for(u32 n = 0; n < count; ++n)
+		{
+			u32 i = requests[n].args[0];
+			if(i >= MAX_DECODERS)
+			{
+				ExitRequested = true;
+				break;
+			}
+
+			decodePending[i].store(false);
+
 			if(DecoderList[i] == NULL)
 				continue;
 
@@ -263,6 +326,32 @@ void SoundHandler::executeThread()
     }
 }
 
+void SoundHandler::PostDecodeRequest(int voice, s64 deadline)
+{
+	if(voice < 0 || voice >= MAX_DECODERS || !decodeQueue)
+		return;
+
+	//! only one request per voice can be queued
+	if(decodePending[voice].exchange(true))
+		return;
+
+	OSMessage message;
+	message.message = NULL;
+	message.args[0] = voice;
+	message.args[1] = (u32)(deadline >> 32);
+	message.args[2] = (u32)deadline;
+
+	if(!OSSendMessage(decodeQueue, &message, OS_MESSAGE_NOBLOCK))
+		decodePending[voice].store(false);
+}
+
+void SoundHandler::RequestRefill(int voice, SoundDecoder * decoder)
+{
+	//! the voice runs dry once the queued blocks are played
+	if(decoder->NeedsRefill())
+		PostDecodeRequest(voice, OSGetTime() + MICROSECS_TO_TICKS(decoder->GetQueuedTime()));
+}
+
 void SoundHandler::axFrameCallback(void)
 {
     for (u32 i = 0; i < MAX_DECODERS; i++)
@@ -294,9 +383,9 @@ void SoundHandler::axFrameCallback(void)
                         decoder->LoadNext();
                     }
 
-                    voice->play(buffer, bufferSize, nextBuffer, nextBufferSize, decoder->GetFormat() & 0xff, decoder->GetSampleRate());
+                    voice->play(buffer, bufferSize, nextBuffer, nextBufferSize, decoder->GetFormat() & 0xff, decoder->GetSampleRate(), decoder->IsStereoOutput());
 
-                    handlerInstance->ThreadSignal();
+                    handlerInstance->RequestRefill(i, decoder);
 
                     voice->setState(Voice::STATE_PLAYING);
                 }
@@ -314,12 +403,17 @@ void SoundHandler::axFrameCallback(void)
                         {
                             voice->setNextBuffer(decoder->GetBuffer(), decoder->GetBufferSize());
                             decoder->LoadNext();
-                            handlerInstance->ThreadSignal();
+                            handlerInstance->RequestRefill(i, decoder);
                         }
                         else if(decoder->IsEOF())
                         {
                             voice->setState(Voice::STATE_STOP);
                         }
+                        else
+                        {
+                            //! nothing queued yet, the request is still pending or got lost
+                            handlerInstance->RequestRefill(i, decoder);
+                        }
                         decoder->Unlock();
                     }
                 }
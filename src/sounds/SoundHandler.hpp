@@ -26,8 +26,10 @@
 #ifndef SOUNDHANDLER_H_
 #define SOUNDHANDLER_H_
 
+#include <atomic>
 #include <vector>
 #include <gctypes.h>
+#include "dynamic_libs/os_functions.h"
 #include "system/CThread.h"
 #include "SoundDecoder.hpp"
 #include "Voice.h"
@@ -52,7 +54,11 @@ public:
 	SoundDecoder * getDecoder(int i) { return ((i < 0 || i >= MAX_DECODERS) ? NULL : DecoderList[i]); };
 	Voice * getVoice(int i) { return ((i < 0 || i >= MAX_DECODERS) ? NULL : voiceList[i]); };
 
-	void ThreadSignal() { resumeThread(); };
+	//!Play stereo sources on two voices, takes effect for decoders added afterwards
+	void SetStereoOutput(bool s) { StereoOutput = s; };
+
+	//!Ask the decode thread to fill the buffers of a voice right away
+	void RequestDecode(int voice) { PostDecodeRequest(voice, 0); };
 	bool IsDecoding() { return Decoding; };
 protected:
 	SoundHandler();
@@ -60,6 +66,9 @@ protected:
 
     static void axFrameCallback(void);
 
+	void PostDecodeRequest(int voice, s64 deadline);
+	void RequestRefill(int voice, SoundDecoder * decoder);
+
     void executeThread(void);
 	void ClearDecoderList();
 
@@ -70,6 +79,14 @@ protected:
 
 	bool Decoding;
 	bool ExitRequested;
+	bool StereoOutput;
+	volatile bool Initialized;
+
+	//! one request per voice at most plus the exit request
+	void *decodeQueue;
+	OSMessage decodeMessages[MAX_DECODERS + 1];
+	//! set by whoever posts the request first, the AX callback and the GUI thread both post
+	std::atomic<bool> decodePending[MAX_DECODERS];
 
 	Voice * voiceList[MAX_DECODERS];
 	SoundDecoder * DecoderList[MAX_DECODERS];
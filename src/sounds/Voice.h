@@ -43,24 +43,16 @@ public:
     {
         lastLoopCounter = 0;
         nextBufferSize = 0;
+        stereo = false;
 
         voice = AXAcquireVoice(prio, 0, 0);
         if(voice)
-        {
-            AXVoiceBegin(voice);
-            AXSetVoiceType(voice, 0);
-            setVolume(0x80000000);
-
-            u32 mix[24];
-            memset(mix, 0, sizeof(mix));
-            mix[0] = 0x80000000;
-            mix[4] = 0x80000000;
+            setupVoice(voice);
 
-            AXSetVoiceDeviceMix(voice, 0, 0, mix);
-            AXSetVoiceDeviceMix(voice, 1, 0, mix);
-
-            AXVoiceEnd(voice);
-        }
+        //! second voice for the right channel of stereo sources
+        voiceRight = AXAcquireVoice(prio, 0, 0);
+        if(voiceRight)
+            setupVoice(voiceRight);
     }
 
     ~Voice()
@@ -69,49 +61,88 @@ public:
         {
             AXFreeVoice(voice);
         }
+        if(voiceRight)
+        {
+            AXFreeVoice(voiceRight);
+        }
     }
 
-    void play(const u8 *buffer, u32 bufferSize, const u8 *nextBuffer, u32 nextBufSize, u16 format, u32 sampleRate)
+    //!Start playback, stereo buffers hold all left samples followed by all right samples
+    void play(const u8 *buffer, u32 bufferSize, const u8 *nextBuffer, u32 nextBufSize, u16 format, u32 sampleRate, bool bStereo = false)
     {
         if(!voice)
             return;
 
-        memset(&voiceBuffer, 0, sizeof(voiceBuffer));
-
-        voiceBuffer.samples = buffer;
-        voiceBuffer.format = format;
-        voiceBuffer.loop = (nextBuffer == NULL) ? 0 : 1;
-        voiceBuffer.cur_pos = 0;
-        voiceBuffer.end_pos = bufferSize >> 1;
-        voiceBuffer.loop_offset = ((nextBuffer - buffer) >> 1);
-        nextBufferSize = nextBufSize;
+        stereo = bStereo && (voiceRight != NULL);
 
         ratioBits[0] = (u32)(0x00010000 * ((f32)sampleRate / (f32)AXGetInputSamplesPerSec()));
         ratioBits[1] = 0;
         ratioBits[2] = 0;
         ratioBits[3] = 0;
 
-        AXSetVoiceOffsets(voice, &voiceBuffer);
-        AXSetVoiceSrc(voice, ratioBits);
-        AXSetVoiceSrcType(voice, 1);
-        AXSetVoiceState(voice, 1);
+        if(stereo)
+        {
+            u32 half = bufferSize >> 1;
+            u32 nextHalf = nextBufSize >> 1;
+            nextBufferSize = nextHalf;
+
+            //! both voices have to start in the same audio frame to stay in sync
+            AXVoiceBegin(voice);
+            AXVoiceBegin(voiceRight);
+            setMix(voice, 0x80000000, 0);
+            setMix(voiceRight, 0, 0x80000000);
+            startVoice(voice, voiceBuffer, buffer, half, nextBuffer, format);
+            startVoice(voiceRight, voiceBufferRight, buffer + half, half, nextBuffer ? (nextBuffer + nextHalf) : NULL, format);
+            AXVoiceEnd(voiceRight);
+            AXVoiceEnd(voice);
+        }
+        else
+        {
+            nextBufferSize = nextBufSize;
+
+            AXVoiceBegin(voice);
+            setMix(voice, 0x80000000, 0x80000000);
+            startVoice(voice, voiceBuffer, buffer, bufferSize, nextBuffer, format);
+            AXVoiceEnd(voice);
+        }
     }
 
     void stop()
     {
         if(voice)
             AXSetVoiceState(voice, 0);
+        if(voiceRight)
+            AXSetVoiceState(voiceRight, 0);
     }
 
     void setVolume(u32 vol)
     {
         if(voice)
             AXSetVoiceVe(voice, &vol);
+        if(voiceRight)
+            AXSetVoiceVe(voiceRight, &vol);
     }
 
 
     void setNextBuffer(const u8 *buffer, u32 bufferSize)
     {
+        if(stereo)
+        {
+            u32 half = bufferSize >> 1;
+            nextBufferSize = half;
+
+            voiceBuffer.loop_offset = ((buffer - voiceBuffer.samples) >> 1);
+            voiceBufferRight.loop_offset = ((buffer + half - voiceBufferRight.samples) >> 1);
+
+            AXVoiceBegin(voice);
+            AXVoiceBegin(voiceRight);
+            AXSetVoiceLoopOffset(voice, voiceBuffer.loop_offset);
+            AXSetVoiceLoopOffset(voiceRight, voiceBufferRight.loop_offset);
+            AXVoiceEnd(voiceRight);
+            AXVoiceEnd(voice);
+            return;
+        }
+
         voiceBuffer.loop_offset = ((buffer - voiceBuffer.samples) >> 1);
         nextBufferSize = bufferSize;
 
@@ -125,6 +156,8 @@ public:
         {
             lastLoopCounter = loopCounter;
             AXSetVoiceEndOffset(voice, voiceBuffer.loop_offset  + (nextBufferSize >> 1));
+            if(stereo)
+                AXSetVoiceEndOffset(voiceRight, voiceBufferRight.loop_offset  + (nextBufferSize >> 1));
             return true;
         }
         return false;
@@ -147,9 +180,6 @@ public:
     }
 
 private:
-    void *voice;
-    u32 ratioBits[4];
-
     typedef struct _ax_buffer_t {
         u16 format;
         u16 loop;
@@ -159,7 +189,52 @@ private:
         const unsigned char *samples;
     } ax_buffer_t;
 
+    static void setupVoice(void *v)
+    {
+        AXVoiceBegin(v);
+        AXSetVoiceType(v, 0);
+        u32 vol = 0x80000000;
+        AXSetVoiceVe(v, &vol);
+        setMix(v, 0x80000000, 0x80000000);
+        AXVoiceEnd(v);
+    }
+
+    //!Set the volume on the left and right main bus of TV and DRC
+    static void setMix(void *v, u32 left, u32 right)
+    {
+        u32 mix[24];
+        memset(mix, 0, sizeof(mix));
+        mix[0] = left;
+        mix[4] = right;
+
+        AXSetVoiceDeviceMix(v, 0, 0, mix);
+        AXSetVoiceDeviceMix(v, 1, 0, mix);
+    }
+
+    void startVoice(void *v, ax_buffer_t & axBuffer, const u8 *buffer, u32 bufferSize, const u8 *nextBuffer, u16 format)
+    {
+        memset(&axBuffer, 0, sizeof(axBuffer));
+
+        axBuffer.samples = buffer;
+        axBuffer.format = format;
+        axBuffer.loop = (nextBuffer == NULL) ? 0 : 1;
+        axBuffer.cur_pos = 0;
+        axBuffer.end_pos = bufferSize >> 1;
+        axBuffer.loop_offset = ((nextBuffer - buffer) >> 1);
+
+        AXSetVoiceOffsets(v, &axBuffer);
+        AXSetVoiceSrc(v, ratioBits);
+        AXSetVoiceSrcType(v, 1);
+        AXSetVoiceState(v, 1);
+    }
+
+    void *voice;
+    void *voiceRight;
+    u32 ratioBits[4];
+
     ax_buffer_t voiceBuffer;
+    ax_buffer_t voiceBufferRight;
+    bool stereo;
     u32 state;
     u32 nextBufferSize;
     u32 lastLoopCounter;
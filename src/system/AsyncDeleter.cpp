@@ -27,6 +27,14 @@ AsyncDeleter::AsyncDeleter()
 AsyncDeleter::~AsyncDeleter()
 {
     exitApplication = true;
+
+    //! the thread can be between the exit check and suspending itself, the single
+    //! resume of shutdownThread() would then come too early and the join never return
+    while(!isThreadTerminated())
+    {
+        resumeThread();
+        usleep(1000);
+    }
 }
 
 void AsyncDeleter::triggerDeleteProcess(void)
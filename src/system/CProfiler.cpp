@@ -0,0 +1,237 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "CProfiler.h"
+#include "utils/logger.h"
+
+#ifdef __powerpc__
+#include "dynamic_libs/os_functions.h"
+#else
+//! host builds have no coreinit, count microseconds instead of bus ticks
+#include <time.h>
+#endif
+
+CProfiler *CProfiler::profilerInstance = NULL;
+
+static const char *phaseNames[CProfiler::PHASE_COUNT] =
+{
+    "input",
+    "drc",
+    "tv",
+    "gx2",
+    "fxaa",
+    "effects",
+    "vsync",
+    "deleter"
+};
+
+static const char *counterNames[CProfiler::COUNTER_COUNT] =
+{
+    "draws",
+    "shaders",
+    "attribs",
+    "textures",
+    "uniforms",
+    "invalidates",
+    "skipped",
+    "idle",
+    "glyphs dropped"
+};
+
+CProfiler::CProfiler()
+    : enabled(false)
+    , frameIndex(0)
+    , frameCount(0)
+    , frameStart(0)
+{
+    memset(frames, 0, sizeof(frames));
+    memset(phaseStart, 0, sizeof(phaseStart));
+    memset(phaseTicks, 0, sizeof(phaseTicks));
+    memset(counterValues, 0, sizeof(counterValues));
+}
+
+u64 CProfiler::getTime(void)
+{
+#ifdef __powerpc__
+    return OSGetTime();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+#endif
+}
+
+u32 CProfiler::ticksToMicroseconds(u64 ticks)
+{
+#ifdef __powerpc__
+    return (u32)((ticks * 1000ULL) / (BUS_SPEED / 4000));
+#else
+    return (u32)ticks;
+#endif
+}
+
+const char * CProfiler::getPhaseName(int phase)
+{
+    if(phase < 0 || phase >= PHASE_COUNT)
+        return "";
+
+    return phaseNames[phase];
+}
+
+const char * CProfiler::getCounterName(int counter)
+{
+    if(counter < 0 || counter >= COUNTER_COUNT)
+        return "";
+
+    return counterNames[counter];
+}
+
+void CProfiler::setEnabled(bool bEnable)
+{
+    if(enabled == bEnable)
+        return;
+
+    enabled = bEnable;
+    frameIndex = 0;
+    frameCount = 0;
+    frameStart = 0;
+    memset(phaseTicks, 0, sizeof(phaseTicks));
+    memset(counterValues, 0, sizeof(counterValues));
+}
+
+void CProfiler::beginFrame(void)
+{
+    if(!enabled)
+        return;
+
+    u64 now = getTime();
+
+    //! the first call only starts the measurement
+    if(frameStart != 0)
+    {
+        FrameSample & sample = frames[frameIndex];
+        sample.frameTime = ticksToMicroseconds(now - frameStart);
+
+        for(int i = 0; i < PHASE_COUNT; i++)
+            sample.phaseTime[i] = ticksToMicroseconds(phaseTicks[i]);
+
+        memcpy(sample.counters, counterValues, sizeof(sample.counters));
+
+        frameIndex = (frameIndex + 1) % PROFILER_FRAMES;
+        if(frameCount < PROFILER_FRAMES)
+            frameCount++;
+
+        //! stream one summary per filled ring buffer
+        if(frameIndex == 0)
+        {
+            char text[512];
+            getSummary(text, sizeof(text));
+            log_printf("Profiler: %s\n", text);
+        }
+    }
+
+    frameStart = now;
+    memset(phaseTicks, 0, sizeof(phaseTicks));
+    memset(counterValues, 0, sizeof(counterValues));
+}
+
+u32 CProfiler::getAverage(int phase) const
+{
+    if(frameCount == 0)
+        return 0;
+
+    u32 sum = 0;
+    for(u32 i = 0; i < frameCount; i++)
+        sum += frames[i].phaseTime[phase];
+
+    return sum / frameCount;
+}
+
+u32 CProfiler::getMaximum(int phase) const
+{
+    u32 max = 0;
+    for(u32 i = 0; i < frameCount; i++)
+    {
+        if(frames[i].phaseTime[phase] > max)
+            max = frames[i].phaseTime[phase];
+    }
+    return max;
+}
+
+u32 CProfiler::getFrameAverage(void) const
+{
+    if(frameCount == 0)
+        return 0;
+
+    u32 sum = 0;
+    for(u32 i = 0; i < frameCount; i++)
+        sum += frames[i].frameTime;
+
+    return sum / frameCount;
+}
+
+u32 CProfiler::getFrameMaximum(void) const
+{
+    u32 max = 0;
+    for(u32 i = 0; i < frameCount; i++)
+    {
+        if(frames[i].frameTime > max)
+            max = frames[i].frameTime;
+    }
+    return max;
+}
+
+u32 CProfiler::getCounterAverage(int counter) const
+{
+    if(frameCount == 0)
+        return 0;
+
+    u32 sum = 0;
+    for(u32 i = 0; i < frameCount; i++)
+        sum += frames[i].counters[counter];
+
+    return sum / frameCount;
+}
+
+u32 CProfiler::getCounterTotal(int counter) const
+{
+    u32 sum = 0;
+    for(u32 i = 0; i < frameCount; i++)
+        sum += frames[i].counters[counter];
+
+    return sum;
+}
+
+void CProfiler::getSummary(char *buffer, int size) const
+{
+    int len = snprintf(buffer, size, "frame %u/%u us", getFrameAverage(), getFrameMaximum());
+
+    for(int i = 0; i < PHASE_COUNT && len > 0 && len < size; i++)
+        len += snprintf(buffer + len, size - len, ", %s %u/%u", phaseNames[i], getAverage(i), getMaximum(i));
+
+    //! a frame is idle or not, show how many of the recorded frames were skipped
+    for(int i = 0; i < COUNTER_IDLE_FRAMES && len > 0 && len < size; i++)
+        len += snprintf(buffer + len, size - len, ", %s %u", counterNames[i], getCounterAverage(i));
+
+    if(len > 0 && len < size)
+        len += snprintf(buffer + len, size - len, ", %s %u/%u", counterNames[COUNTER_IDLE_FRAMES], getCounterTotal(COUNTER_IDLE_FRAMES), frameCount);
+
+    //! glyphs that did not fit into the vertex ring of the fonts
+    if(len > 0 && len < size)
+        snprintf(buffer + len, size - len, ", %s %u", counterNames[COUNTER_GLYPHS_DROPPED], getCounterTotal(COUNTER_GLYPHS_DROPPED));
+}
@@ -0,0 +1,150 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _CPROFILER_H_
+#define _CPROFILER_H_
+
+#include <gctypes.h>
+
+//! number of frames kept in the ring buffer, one second at 60 Hz
+#define PROFILER_FRAMES         60
+
+//!Measures the CPU time of the phases of the main loop and counts the GX2
+//!commands issued by the shader wrappers. Times and counts are summed up per
+//!frame and the last PROFILER_FRAMES frames are kept in a ring buffer for the
+//!overlay and the logger.
+class CProfiler
+{
+public:
+    enum ePhase
+    {
+        PHASE_INPUT = 0,
+        PHASE_DRAW_DRC,
+        PHASE_DRAW_TV,
+        PHASE_GX2_SUBMIT,
+        PHASE_FXAA,
+        PHASE_EFFECTS,
+        PHASE_VSYNC,
+        PHASE_DELETER,
+        PHASE_COUNT
+    };
+
+    enum eCounter
+    {
+        COUNTER_DRAWS = 0,
+        COUNTER_SHADERS,
+        COUNTER_ATTRIBUTES,
+        COUNTER_TEXTURES,
+        COUNTER_UNIFORMS,
+        COUNTER_INVALIDATES,
+        COUNTER_SKIPPED,
+        COUNTER_IDLE_FRAMES,
+        COUNTER_GLYPHS_DROPPED,
+        COUNTER_COUNT
+    };
+
+    static CProfiler *instance() {
+        if(!profilerInstance)
+            profilerInstance = new CProfiler();
+
+        return profilerInstance;
+    }
+
+    static void destroyInstance() {
+        delete profilerInstance;
+        profilerInstance = NULL;
+    }
+
+    void setEnabled(bool bEnable);
+    bool isEnabled(void) const {
+        return enabled;
+    }
+
+    //!Start a new frame, stores the phase times of the last one
+    void beginFrame(void);
+
+    void beginPhase(int phase) {
+        if(enabled)
+            phaseStart[phase] = getTime();
+    }
+    void endPhase(int phase) {
+        if(enabled)
+            phaseTicks[phase] += getTime() - phaseStart[phase];
+    }
+    void count(int counter, u32 n = 1) {
+        if(enabled)
+            counterValues[counter] += n;
+    }
+
+    //!\return average time of a phase over the ring buffer in microseconds
+    u32 getAverage(int phase) const;
+    //!\return longest time of a phase in the ring buffer in microseconds
+    u32 getMaximum(int phase) const;
+    //!\return average time of a whole frame in microseconds
+    u32 getFrameAverage(void) const;
+    //!\return longest frame in the ring buffer in microseconds
+    u32 getFrameMaximum(void) const;
+    //!\return average count per frame over the ring buffer
+    u32 getCounterAverage(int counter) const;
+    //!\return sum of a counter over the ring buffer
+    u32 getCounterTotal(int counter) const;
+
+    //!Writes the averages and maximums of all phases as text
+    void getSummary(char *buffer, int size) const;
+
+    static const char * getPhaseName(int phase);
+    static const char * getCounterName(int counter);
+    //!\return current time in timer ticks
+    static u64 getTime(void);
+    static u32 ticksToMicroseconds(u64 ticks);
+private:
+    CProfiler();
+    ~CProfiler() {}
+
+    static CProfiler *profilerInstance;
+
+    typedef struct
+    {
+        u32 frameTime;
+        u32 phaseTime[PHASE_COUNT];
+        u32 counters[COUNTER_COUNT];
+    } FrameSample;
+
+    bool enabled;
+    FrameSample frames[PROFILER_FRAMES];
+    u32 frameIndex;
+    u32 frameCount;
+    u64 frameStart;
+    u64 phaseStart[PHASE_COUNT];
+    u64 phaseTicks[PHASE_COUNT];
+    u32 counterValues[COUNTER_COUNT];
+};
+
+//!Measures the time until the end of the scope
+class CProfilerScope
+{
+public:
+    CProfilerScope(int p) : phase(p) {
+        CProfiler::instance()->beginPhase(phase);
+    }
+    ~CProfilerScope() {
+        CProfiler::instance()->endPhase(phase);
+    }
+private:
+    int phase;
+};
+
+#endif // _CPROFILER_H_
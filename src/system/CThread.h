@@ -42,7 +42,7 @@ public:
 		pThreadStack = (u8 *) memalign(0x20, iStackSize);
         //! create the thread
 		if(pThread && pThreadStack)
-            OSCreateThread(pThread, &CThread::threadCallback, 1, this, (u32)pThreadStack+iStackSize, iStackSize, iPriority, iAttributes);
+            OSCreateThread(pThread, &CThread::threadCallback, 1, this, (u32)(uintptr_t)(pThreadStack + iStackSize), iStackSize, iPriority, iAttributes);
 	}
 
 	//! destructor
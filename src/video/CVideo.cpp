@@ -29,6 +29,8 @@ CVideo::CVideo(s32 forceTvScanMode, s32 forceDrcScanMode)
 {
     tvEnabled = false;
     drcEnabled = false;
+    fxaaMode = AA_MODE_ALWAYS;
+    stillFrame = false;
 
     //! allocate MEM2 command buffer memory
     gx2CommandBuffer = MEM2_alloc(GX2_COMMAND_BUFFER_SIZE, 0x40);
@@ -251,14 +253,18 @@ CVideo::~CVideo()
     Shader3D::destroyInstance();
     ShaderFractalColor::destroyInstance();
     Texture2DShader::destroyInstance();
+    SpriteBatch::destroy();
 }
 
 void CVideo::renderFXAA(const GX2Texture * texture, const GX2Sampler *sampler)
 {
+    CProfilerScope profile(CProfiler::PHASE_FXAA);
+
     resolution[0] = texture->surface.width;
     resolution[1] = texture->surface.height;
 
     GX2Invalidate(GX2_INVALIDATE_COLOR_BUFFER | GX2_INVALIDATE_TEXTURE, texture->surface.image_data, texture->surface.image_size);
+    CProfiler::instance()->count(CProfiler::COUNTER_INVALIDATES);
 
     GX2SetDepthOnlyControl(GX2_ENABLE, GX2_ENABLE, GX2_COMPARE_ALWAYS);
     FXAAShader::instance()->setShaders();
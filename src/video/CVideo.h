@@ -19,6 +19,9 @@
 
 #include "dynamic_libs/gx2_functions.h"
 #include "shaders/Shader.h"
+#include "SpriteBatch.h"
+#include "settings/SettingsEnums.h"
+#include "system/CProfiler.h"
 
 class CVideo
 {
@@ -45,6 +48,8 @@ public:
         GX2ClearDepthStencilEx(currDepthBuffer, currDepthBuffer->clear_depth, currDepthBuffer->clear_stencil, GX2_CLEAR_BOTH);
 
         GX2SetContextState(currContextState);
+        //! the context state brings its own shaders and buffers
+        RenderState::invalidate();
         GX2SetViewport(0.0f, 0.0f, currColorBuffer->surface.width, currColorBuffer->surface.height, 0.0f, 1.0f);
         GX2SetScissor(0, 0, currColorBuffer->surface.width, currColorBuffer->surface.height);
 
@@ -56,6 +61,8 @@ public:
 
     void setStencilRender(bool bEnable)
     {
+        SpriteBatch::flush();
+
         if(bEnable)
         {
             GX2SetStencilMask(0xff, 0xff, 0x01, 0xff, 0xff, 0x01);
@@ -71,20 +78,37 @@ public:
     }
 
     void drcDrawDone(void) {
+        CProfilerScope profile(CProfiler::PHASE_GX2_SUBMIT);
+        SpriteBatch::flush();
         //! on DRC we do a hardware AA because FXAA does not look good
         //renderFXAA(&drcAaTexture, &aaSampler);
         GX2CopyColorBufferToScanBuffer(&drcColorBuffer, GX2_SCAN_TARGET_DRC_FIRST);
     }
 
     void tvDrawDone(void) {
-        renderFXAA(&tvAaTexture, &aaSampler);
+        CProfilerScope profile(CProfiler::PHASE_GX2_SUBMIT);
+        SpriteBatch::flush();
+        //! moving frames are only on screen for a moment, still mode saves the pass there
+        if(fxaaMode == AA_MODE_ALWAYS || (fxaaMode == AA_MODE_STILL && stillFrame))
+            renderFXAA(&tvAaTexture, &aaSampler);
         GX2CopyColorBufferToScanBuffer(&tvColorBuffer, GX2_SCAN_TARGET_TV);
         GX2SwapScanBuffers();
         GX2Flush();
     }
 
+    //!Set the FXAA mode of the TV (eAntiAliasingModes)
+    void setFXAAMode(int mode) {
+        fxaaMode = mode;
+    }
+
+    //!Mark the next frame as one that stays on screen because nothing moves anymore
+    void setStillFrame(bool bStill) {
+        stillFrame = bStill;
+    }
+
     void waitForVSync(void) {
         GX2WaitForVsync();
+        SpriteBatch::nextFrame();
         frameCount++;
     }
 
@@ -178,6 +202,8 @@ private:
 
     bool tvEnabled;
     bool drcEnabled;
+    int fxaaMode;
+    bool stillFrame;
 
     GX2ColorBuffer tvColorBuffer;
     GX2DepthBuffer tvDepthBuffer;
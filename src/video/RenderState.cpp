@@ -0,0 +1,152 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <string.h>
+#include "RenderState.h"
+#include "SpriteBatch.h"
+#include "system/CProfiler.h"
+
+GX2FetchShader *RenderState::fetchShader = NULL;
+GX2VertexShader *RenderState::vertexShader = NULL;
+GX2PixelShader *RenderState::pixelShader = NULL;
+RenderState::AttribState RenderState::attributes[RENDER_STATE_ATTRIBUTES];
+RenderState::TextureState RenderState::textures[RENDER_STATE_SAMPLERS];
+GX2Sampler RenderState::samplers[RENDER_STATE_SAMPLERS];
+bool RenderState::samplerValid[RENDER_STATE_SAMPLERS];
+
+void RenderState::invalidate(void)
+{
+    fetchShader = NULL;
+    vertexShader = NULL;
+    pixelShader = NULL;
+    memset(attributes, 0, sizeof(attributes));
+    memset(textures, 0, sizeof(textures));
+    memset(samplerValid, 0, sizeof(samplerValid));
+}
+
+void RenderState::setFetchShader(GX2FetchShader *shader)
+{
+    SpriteBatch::flush();
+
+    if(shader == fetchShader)
+    {
+        CProfiler::instance()->count(CProfiler::COUNTER_SKIPPED);
+        return;
+    }
+
+    CProfiler::instance()->count(CProfiler::COUNTER_SHADERS);
+    GX2SetFetchShader(shader);
+    fetchShader = shader;
+}
+
+void RenderState::setVertexShader(GX2VertexShader *shader)
+{
+    SpriteBatch::flush();
+
+    if(shader == vertexShader)
+    {
+        CProfiler::instance()->count(CProfiler::COUNTER_SKIPPED);
+        return;
+    }
+
+    CProfiler::instance()->count(CProfiler::COUNTER_SHADERS);
+    GX2SetVertexShader(shader);
+    vertexShader = shader;
+}
+
+void RenderState::setPixelShader(GX2PixelShader *shader)
+{
+    SpriteBatch::flush();
+
+    if(shader == pixelShader)
+    {
+        CProfiler::instance()->count(CProfiler::COUNTER_SKIPPED);
+        return;
+    }
+
+    CProfiler::instance()->count(CProfiler::COUNTER_SHADERS);
+    GX2SetPixelShader(shader);
+    pixelShader = shader;
+}
+
+void RenderState::setAttribBuffer(u32 bufferIdx, u32 bufferSize, u32 stride, const void *buffer)
+{
+    SpriteBatch::flush();
+
+    if(bufferIdx < RENDER_STATE_ATTRIBUTES)
+    {
+        AttribState & state = attributes[bufferIdx];
+
+        //! the GPU reads the buffer at draw time, only its location matters
+        if(state.buffer == buffer && state.size == bufferSize && state.stride == stride)
+        {
+            CProfiler::instance()->count(CProfiler::COUNTER_SKIPPED);
+            return;
+        }
+
+        state.buffer = buffer;
+        state.size = bufferSize;
+        state.stride = stride;
+    }
+
+    CProfiler::instance()->count(CProfiler::COUNTER_ATTRIBUTES);
+    GX2SetAttribBuffer(bufferIdx, bufferSize, stride, buffer);
+}
+
+void RenderState::setPixelTexture(const GX2Texture *texture, u32 location)
+{
+    SpriteBatch::flush();
+
+    if(location < RENDER_STATE_SAMPLERS)
+    {
+        TextureState & state = textures[location];
+
+        //! texture structures get reused for other surfaces, compare what is loaded into the registers
+        if(state.texture == texture && state.imageData == texture->surface.image_data
+           && memcmp(state.regs, texture->regs, sizeof(state.regs)) == 0)
+        {
+            CProfiler::instance()->count(CProfiler::COUNTER_SKIPPED);
+            return;
+        }
+
+        state.texture = texture;
+        state.imageData = texture->surface.image_data;
+        memcpy(state.regs, texture->regs, sizeof(state.regs));
+    }
+
+    CProfiler::instance()->count(CProfiler::COUNTER_TEXTURES);
+    GX2SetPixelTexture(texture, location);
+}
+
+void RenderState::setPixelSampler(const GX2Sampler *sampler, u32 location)
+{
+    SpriteBatch::flush();
+
+    if(location < RENDER_STATE_SAMPLERS)
+    {
+        if(samplerValid[location] && memcmp(&samplers[location], sampler, sizeof(GX2Sampler)) == 0)
+        {
+            CProfiler::instance()->count(CProfiler::COUNTER_SKIPPED);
+            return;
+        }
+
+        samplers[location] = *sampler;
+        samplerValid[location] = true;
+    }
+
+    CProfiler::instance()->count(CProfiler::COUNTER_TEXTURES);
+    GX2SetPixelSampler(sampler, location);
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef __RENDER_STATE_H_
+#define __RENDER_STATE_H_
+
+#include "dynamic_libs/gx2_functions.h"
+
+//! number of pixel sampler slots that are tracked
+#define RENDER_STATE_SAMPLERS       4
+//! number of attribute buffers that are tracked
+#define RENDER_STATE_ATTRIBUTES     4
+
+//!Remembers the shaders, attribute buffers, textures and samplers bound on
+//!the GPU so that binding the same state again is skipped. All shader wrappers
+//!bind through here. The cache has to be invalidated whenever a context state
+//!is loaded as that overwrites the bound state.
+class RenderState
+{
+public:
+    static void invalidate(void);
+
+    static void setFetchShader(GX2FetchShader *shader);
+    static void setVertexShader(GX2VertexShader *shader);
+    static void setPixelShader(GX2PixelShader *shader);
+    static void setAttribBuffer(u32 bufferIdx, u32 bufferSize, u32 stride, const void *buffer);
+    static void setPixelTexture(const GX2Texture *texture, u32 location);
+    static void setPixelSampler(const GX2Sampler *sampler, u32 location);
+private:
+    typedef struct
+    {
+        const void *buffer;
+        u32 size;
+        u32 stride;
+    } AttribState;
+
+    typedef struct
+    {
+        const GX2Texture *texture;
+        void *imageData;
+        u32 regs[5];
+    } TextureState;
+
+    static GX2FetchShader *fetchShader;
+    static GX2VertexShader *vertexShader;
+    static GX2PixelShader *pixelShader;
+    static AttribState attributes[RENDER_STATE_ATTRIBUTES];
+    static TextureState textures[RENDER_STATE_SAMPLERS];
+    static GX2Sampler samplers[RENDER_STATE_SAMPLERS];
+    static bool samplerValid[RENDER_STATE_SAMPLERS];
+};
+
+#endif // __RENDER_STATE_H_
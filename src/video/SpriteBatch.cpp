@@ -0,0 +1,139 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <malloc.h>
+#include "SpriteBatch.h"
+#include "shaders/Texture2DShader.h"
+
+//! one quad of the vertex ring
+#define QUAD_POS_FLOATS     (4 * 3)
+#define QUAD_TEX_FLOATS     (4 * 2)
+
+f32 *SpriteBatch::posVtxs = NULL;
+f32 *SpriteBatch::texCoords = NULL;
+u32 SpriteBatch::frameIdx = 0;
+u32 SpriteBatch::usedQuads = 0;
+u32 SpriteBatch::batchStart = 0;
+u32 SpriteBatch::quadCount = 0;
+const GX2Texture *SpriteBatch::texture = NULL;
+const GX2Sampler *SpriteBatch::sampler = NULL;
+glm::vec4 SpriteBatch::colorIntensity;
+glm::vec3 SpriteBatch::blurDirection;
+
+bool SpriteBatch::addQuad(const GX2Texture *tex, const GX2Sampler *samp, const glm::vec3 & offset, const glm::vec3 & scale,
+                          const glm::vec4 & color, const glm::vec3 & blur)
+{
+    if(!posVtxs)
+    {
+        //! two frames worth of quads, one for the CPU and one that the GPU may still read
+        posVtxs = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, 2 * SPRITE_BATCH_QUADS * QUAD_POS_FLOATS * sizeof(f32));
+        texCoords = (f32*)memalign(GX2_VERTEX_BUFFER_ALIGNMENT, 2 * SPRITE_BATCH_QUADS * QUAD_TEX_FLOATS * sizeof(f32));
+        if(!posVtxs || !texCoords)
+        {
+            destroy();
+            return false;
+        }
+    }
+
+    if(quadCount && (tex != texture || samp != sampler || color != colorIntensity || blur != blurDirection))
+        flushQuads();
+
+    //! ring is full for this frame, draw the rest directly
+    if(usedQuads >= SPRITE_BATCH_QUADS)
+        return false;
+
+    if(quadCount == 0)
+    {
+        texture = tex;
+        sampler = samp;
+        colorIntensity = color;
+        blurDirection = blur;
+        batchStart = usedQuads;
+    }
+
+    u32 quadIdx = frameIdx * SPRITE_BATCH_QUADS + usedQuads;
+    f32 *pos = posVtxs + quadIdx * QUAD_POS_FLOATS;
+    f32 *tc = texCoords + quadIdx * QUAD_TEX_FLOATS;
+
+    //! same as the default quad of the Texture2DShader with offset and scale applied
+    f32 left = offset[0] - scale[0];
+    f32 right = offset[0] + scale[0];
+    f32 bottom = offset[1] - scale[1];
+    f32 top = offset[1] + scale[1];
+
+    pos[0] = left;  pos[1] = bottom; pos[2] = offset[2];
+    pos[3] = right; pos[4] = bottom; pos[5] = offset[2];
+    pos[6] = right; pos[7] = top;    pos[8] = offset[2];
+    pos[9] = left;  pos[10] = top;   pos[11] = offset[2];
+
+    tc[0] = 0.0f; tc[1] = 1.0f;
+    tc[2] = 1.0f; tc[3] = 1.0f;
+    tc[4] = 1.0f; tc[5] = 0.0f;
+    tc[6] = 0.0f; tc[7] = 0.0f;
+
+    usedQuads++;
+    quadCount++;
+    return true;
+}
+
+void SpriteBatch::flushQuads(void)
+{
+    u32 count = quadCount;
+    //! reset first, the binds below would flush again otherwise
+    quadCount = 0;
+
+    u32 quadIdx = frameIdx * SPRITE_BATCH_QUADS + batchStart;
+    GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, posVtxs + quadIdx * QUAD_POS_FLOATS, count * QUAD_POS_FLOATS * sizeof(f32));
+    GX2Invalidate(GX2_INVALIDATE_CPU_ATTRIB_BUFFER, texCoords + quadIdx * QUAD_TEX_FLOATS, count * QUAD_TEX_FLOATS * sizeof(f32));
+    CProfiler::instance()->count(CProfiler::COUNTER_INVALIDATES, 2);
+
+    //! the vertices are already transformed
+    Texture2DShader *shader = Texture2DShader::instance();
+    shader->setShaders();
+    shader->setAttributeBuffer(texCoords + frameIdx * SPRITE_BATCH_QUADS * QUAD_TEX_FLOATS,
+                               posVtxs + frameIdx * SPRITE_BATCH_QUADS * QUAD_POS_FLOATS,
+                               SPRITE_BATCH_QUADS * 4);
+    shader->setAngle(0.0f);
+    shader->setOffset(glm::vec3(0.0f));
+    shader->setScale(glm::vec3(1.0f));
+    shader->setColorIntensity(colorIntensity);
+    shader->setBlurring(blurDirection);
+    shader->setTextureAndSampler(texture, sampler);
+
+    CProfiler::instance()->count(CProfiler::COUNTER_DRAWS);
+    GX2DrawEx(GX2_PRIMITIVE_QUADS, count * 4, batchStart * 4, 1);
+}
+
+void SpriteBatch::nextFrame(void)
+{
+    flush();
+    frameIdx ^= 1;
+    usedQuads = 0;
+}
+
+void SpriteBatch::destroy(void)
+{
+    quadCount = 0;
+    usedQuads = 0;
+
+    if(posVtxs)
+        free(posVtxs);
+    if(texCoords)
+        free(texCoords);
+
+    posVtxs = NULL;
+    texCoords = NULL;
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef __SPRITE_BATCH_H_
+#define __SPRITE_BATCH_H_
+
+#include "glm/glm.hpp"
+#include "dynamic_libs/gx2_functions.h"
+
+//! maximum number of quads that can be queued per frame
+#define SPRITE_BATCH_QUADS          1024
+
+//!Collects consecutive textured quads that use the same texture, sampler,
+//!color intensity and blurring and draws them with a single GX2DrawEx.
+//!The quads are transformed on the CPU into a vertex ring that is double
+//!buffered over the frames so the GPU can still read the previous frame.
+//!Everything that touches GPU state has to flush the batch first, the shader
+//!wrappers and RenderState do that on their own.
+class SpriteBatch
+{
+public:
+    //!Queue a default quad
+    //!\return false if the quad can not be batched and has to be drawn directly
+    static bool addQuad(const GX2Texture *texture, const GX2Sampler *sampler, const glm::vec3 & offset, const glm::vec3 & scale,
+                        const glm::vec4 & colorIntensity, const glm::vec3 & blurDirection);
+
+    //!Draw the queued quads
+    static inline void flush(void) {
+        if(quadCount)
+            flushQuads();
+    }
+
+    //!Switch to the other half of the vertex ring, called once per frame
+    static void nextFrame(void);
+    //!Free the vertex ring
+    static void destroy(void);
+private:
+    static void flushQuads(void);
+
+    static f32 *posVtxs;
+    static f32 *texCoords;
+    static u32 frameIdx;
+    static u32 usedQuads;
+    static u32 batchStart;
+    static u32 quadCount;
+
+    static const GX2Texture *texture;
+    static const GX2Sampler *sampler;
+    static glm::vec4 colorIntensity;
+    static glm::vec3 blurDirection;
+};
+
+#endif // __SPRITE_BATCH_H_
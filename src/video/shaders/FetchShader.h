@@ -47,7 +47,7 @@ public:
     }
 
     void setShader(void) const {
-        GX2SetFetchShader(fetchShader);
+        RenderState::setFetchShader(fetchShader);
     }
 
 protected:
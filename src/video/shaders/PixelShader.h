@@ -137,10 +137,12 @@ public:
     }
 
     void setShader(void) const {
-        GX2SetPixelShader(pixelShader);
+        RenderState::setPixelShader(pixelShader);
     }
 
     static inline void setUniformReg(u32 location, u32 size, const void * reg) {
+        SpriteBatch::flush();
+        CProfiler::instance()->count(CProfiler::COUNTER_UNIFORMS);
         GX2SetPixelUniformReg(location, size, reg);
     }
 protected:
@@ -20,6 +20,9 @@
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "dynamic_libs/gx2_functions.h"
+#include "system/CProfiler.h"
+#include "video/RenderState.h"
+#include "video/SpriteBatch.h"
 #include "utils/utils.h"
 
 class Shader
@@ -38,6 +41,9 @@ public:
 
     static void draw(s32 primitive = GX2_PRIMITIVE_QUADS, u32 vtxCount = 4)
     {
+        SpriteBatch::flush();
+        CProfiler::instance()->count(CProfiler::COUNTER_DRAWS);
+
         switch(primitive)
         {
             default:
@@ -111,8 +111,8 @@ public:
     }
 
     void setTextureAndSampler(const GX2Texture *texture, const GX2Sampler *sampler) const {
-        GX2SetPixelTexture(texture, samplerLocation);
-        GX2SetPixelSampler(sampler, samplerLocation);
+        RenderState::setPixelTexture(texture, samplerLocation);
+        RenderState::setPixelSampler(sampler, samplerLocation);
     }
 };
 
@@ -104,8 +104,11 @@ public:
     }
 
     void setTextureAndSampler(const GX2Texture *texture, const GX2Sampler *sampler) const {
-        GX2SetPixelTexture(texture, samplerLocation);
-        GX2SetPixelSampler(sampler, samplerLocation);
+        RenderState::setPixelTexture(texture, samplerLocation);
+        RenderState::setPixelSampler(sampler, samplerLocation);
+    }
+    void setTexture(const GX2Texture *texture) const {
+        RenderState::setPixelTexture(texture, samplerLocation);
     }
 };
 
@@ -145,7 +145,7 @@ public:
     }
 
     static inline void setAttributeBuffer(u32 bufferIdx, u32 bufferSize, u32 stride, const void * buffer) {
-        GX2SetAttribBuffer(bufferIdx, bufferSize, stride, buffer);
+        RenderState::setAttribBuffer(bufferIdx, bufferSize, stride, buffer);
     }
 
     GX2VertexShader *getVertexShader() const {
@@ -153,7 +153,7 @@ public:
     }
 
     void setShader(void) const {
-        GX2SetVertexShader(vertexShader);
+        RenderState::setVertexShader(vertexShader);
     }
 
     GX2AttribStream * getAttributeBuffer(u32 idx = 0) const {
@@ -167,6 +167,8 @@ public:
     }
 
     static void setUniformReg(u32 location, u32 size, const void * reg) {
+        SpriteBatch::flush();
+        CProfiler::instance()->count(CProfiler::COUNTER_UNIFORMS);
         GX2SetVertexUniformReg(location, size, reg);
     }
 protected:
@@ -0,0 +1,40 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include "Application.h"
+
+//! Application without settings, resources, music and main loop. The GUI
+//! elements only ask it for the video, which is the host CVideo here.
+
+Application *Application::applicationInstance = NULL;
+bool Application::exitApplication = false;
+
+Application::Application()
+	: CThread(CThread::eAttributeAffCore0 | CThread::eAttributePinnedAff, 0, 0x20000)
+	, bgMusic(NULL)
+	, video(new CVideo(0, 0))
+    , mainWindow(NULL)
+{
+}
+
+Application::~Application()
+{
+    delete video;
+}
+
+void Application::executeThread(void)
+{
+}
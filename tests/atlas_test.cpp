@@ -0,0 +1,290 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+#include "gui/FreeTypeGX.h"
+#include "video/CVideo.h"
+
+//! Fills the FreeTypeGX atlas pages through layoutText() and prints how well the
+//! shelves are used. The shipped font only has latin glyphs, so the CJK sets come
+//! from a generated 8 bit BDF font with 3000 full width glyphs from U+4E00 on.
+//! A game list is scrolled through them with the frames advancing, which has to
+//! recycle pages without ever touching the glyphs of strings drawn in the frame.
+
+//! same as in FreeTypeGX.cpp
+static const u32 ATLAS_PAGE_DIM = 256;
+static const u32 ATLAS_MAX_PAGES = 8;
+
+static const u32 CJK_FIRST = 0x4E00;
+static const u32 CJK_GLYPHS = 3000;
+static const u32 CJK_PIXEL_SIZE = 24;
+//! 24x24 texture rectangles and the padding fit 81 times into a page
+static const u32 CJK_FILL_GLYPHS = 600;
+
+static bool loadFile(const char *path, std::vector<u8> &data)
+{
+    FILE *f = fopen(path, "rb");
+    if(!f)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    data.resize(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(&data[0], 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+//! full width glyphs of slightly varying size, like the ideographs of a CJK font
+static std::string createCjkFont(void)
+{
+    char line[128];
+    std::string bdf = "STARTFONT 2.3\n"
+                      "FONT -host-cjk-medium-r-normal--24-240-72-72-c-240-iso10646-1\n"
+                      "SIZE 24 72 72 8\n"
+                      "FONTBOUNDINGBOX 24 24 0 -3\n"
+                      "STARTPROPERTIES 2\n"
+                      "FONT_ASCENT 21\n"
+                      "FONT_DESCENT 3\n"
+                      "ENDPROPERTIES\n";
+    snprintf(line, sizeof(line), "CHARS %u\n", CJK_GLYPHS);
+    bdf += line;
+
+    u32 seed = 12345;
+    for(u32 i = 0; i < CJK_GLYPHS; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        u32 width = 19 + ((seed >> 16) % 5);
+        u32 height = 19 + ((seed >> 20) % 5);
+
+        snprintf(line, sizeof(line), "STARTCHAR u%04X\nENCODING %u\nSWIDTH 1000 0\nDWIDTH 24 0\nBBX %u %u %u -2\nBITMAP\n",
+                 CJK_FIRST + i, CJK_FIRST + i, width, height, (24 - width) / 2);
+        bdf += line;
+
+        for(u32 y = 0; y < height; y++)
+        {
+            for(u32 x = 0; x < width; x++)
+                bdf += ((x + y + i) % 3) ? "FF" : "40";
+            bdf += "\n";
+        }
+        bdf += "ENDCHAR\n";
+    }
+    bdf += "ENDFONT\n";
+    return bdf;
+}
+
+struct AtlasUsage
+{
+    u32 pages;
+    u32 glyphs;
+    u64 glyphTexels;
+};
+
+//! pages and texels of the distinct glyph rectangles of the quads
+static AtlasUsage getUsage(const std::vector<ftgxGlyphQuad> &quads)
+{
+    std::set<u32> pages;
+    std::set<u64> rects;
+    AtlasUsage usage = { 0, 0, 0 };
+
+    for(u32 i = 0; i < quads.size(); i++)
+    {
+        const ftgxGlyphQuad &quad = quads[i];
+        pages.insert(quad.atlasPage);
+        if(rects.insert(((u64)quad.atlasPage << 32) | (quad.atlasY << 16) | quad.atlasX).second)
+            usage.glyphTexels += quad.width * quad.height;
+    }
+    usage.pages = pages.size();
+    usage.glyphs = rects.size();
+    return usage;
+}
+
+static void printUsage(const char *name, int pixelSize, const AtlasUsage &usage)
+{
+    printf("%-10s %3d px: %4u glyphs on %u pages, %.1f glyphs per page, %.1f%% of the page texels",
+           name, pixelSize, usage.glyphs, usage.pages, (f32)usage.glyphs / usage.pages,
+           100.0f * usage.glyphTexels / ((u64)usage.pages * ATLAS_PAGE_DIM * ATLAS_PAGE_DIM));
+}
+
+static bool sameQuads(const std::vector<ftgxGlyphQuad> &a, const std::vector<ftgxGlyphQuad> &b)
+{
+    return a.size() == b.size() && (a.empty() || memcmp(&a[0], &b[0], a.size() * sizeof(ftgxGlyphQuad)) == 0);
+}
+
+//! occupancy of the latin glyphs of the shipped font at the sizes the menus use
+static int runLatin(const std::vector<u8> &font)
+{
+    static const int sizes[] = { 20, 28, 48 };
+    int failed = 0;
+
+    for(u32 s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        FreeTypeGX ftgx(&font[0], font.size());
+
+        std::wstring text;
+        for(wchar_t c = 0x21; c < 0x100; c++)
+            if(c < 0x7F || c > 0xA0)
+                text += c;
+
+        std::vector<ftgxGlyphQuad> quads;
+        ftgx.layoutText(quads, 0, 0, text.c_str(), sizes[s], 0, 0);
+
+        AtlasUsage usage = getUsage(quads);
+        printUsage("latin", sizes[s], usage);
+        printf("\n");
+        if(usage.glyphs == 0 || usage.pages > ATLAS_MAX_PAGES)
+            failed = 1;
+    }
+    return failed;
+}
+
+//! the atlas of one size filled with CJK glyphs, then refilled with other glyphs
+//! once the frames moved on, which has to recycle the pages instead of adding more
+static int runCjkFill(const std::string &bdf)
+{
+    CVideo video;
+    FreeTypeGX ftgx((const u8*)bdf.data(), bdf.size());
+    int failed = 0;
+
+    for(u32 pass = 0; pass < 2; pass++)
+    {
+        //! a little less than the pages of one size hold, shelves of mixed heights waste some rows
+        std::wstring text;
+        for(u32 i = 0; i < CJK_FILL_GLYPHS; i++)
+            text += (wchar_t)(CJK_FIRST + pass * CJK_FILL_GLYPHS + i);
+
+        u32 generation = ftgx.getAtlasGeneration();
+        std::vector<ftgxGlyphQuad> quads;
+        ftgx.setFrameCount(video.getFrameCount());
+        ftgx.layoutText(quads, 0, 0, text.c_str(), CJK_PIXEL_SIZE, 0, 0);
+        ftgx.drawGlyphQuads(&video, 0, 0, 0, quads, CJK_PIXEL_SIZE, glm::vec4(1.0f), 0.0f, 0.0f, glm::vec4(0.0f));
+
+        AtlasUsage usage = getUsage(quads);
+        printUsage(pass ? "cjk refill" : "cjk fill", CJK_PIXEL_SIZE, usage);
+        printf(", %u pages recycled\n", ftgx.getAtlasGeneration() - generation);
+
+        if(usage.glyphs != text.size() || usage.pages > ATLAS_MAX_PAGES || (pass == 1 && ftgx.getAtlasGeneration() == generation))
+            failed = 1;
+
+        for(int i = 0; i < 4; i++)
+            video.waitForVSync();
+    }
+    return failed;
+}
+
+//! one screen of a game list with CJK titles, scrolled by one title every few frames
+static int runCjkScroll(const std::string &bdf, u32 framesPerTitle)
+{
+    static const u32 TITLES = 400;
+    static const u32 TITLE_CHARS = 12;
+    static const u32 VISIBLE_TITLES = 10;
+
+    CVideo video;
+    FreeTypeGX ftgx((const u8*)bdf.data(), bdf.size());
+    std::vector<std::wstring> titles(TITLES);
+
+    //! character use in CJK text roughly follows Zipf's law
+    std::vector<double> cumulative(CJK_GLYPHS);
+    double sum = 0.0;
+    for(u32 i = 0; i < CJK_GLYPHS; i++)
+    {
+        sum += 1.0 / (i + 1);
+        cumulative[i] = sum;
+    }
+
+    u32 seed = 98765;
+    for(u32 t = 0; t < TITLES; t++)
+    {
+        for(u32 c = 0; c < TITLE_CHARS; c++)
+        {
+            seed = seed * 1103515245 + 12345;
+            double r = sum * ((seed >> 8) & 0xFFFFFF) / (double)0x1000000;
+            u32 rank = std::lower_bound(cumulative.begin(), cumulative.end(), r) - cumulative.begin();
+            titles[t] += (wchar_t)(CJK_FIRST + rank);
+        }
+    }
+
+    std::vector<std::vector<ftgxGlyphQuad> > screen(VISIBLE_TITLES);
+    u32 frames = (TITLES - VISIBLE_TITLES) * framesPerTitle;
+    u32 evictions = 0;
+    u32 maxPages = 0;
+    u32 unstable = 0;
+
+    for(u32 frame = 0; frame < frames; frame++)
+    {
+        u32 first = frame / framesPerTitle;
+        u32 generation = ftgx.getAtlasGeneration();
+
+        //! like GuiText::draw()
+        ftgx.setFrameCount(video.getFrameCount());
+
+        for(u32 i = 0; i < VISIBLE_TITLES; i++)
+        {
+            screen[i].clear();
+            ftgx.layoutText(screen[i], 0, 0, titles[first + i].c_str(), CJK_PIXEL_SIZE, 0, 0);
+            ftgx.drawGlyphQuads(&video, 0, i * 30, 0, screen[i], CJK_PIXEL_SIZE, glm::vec4(1.0f), 0.0f, 0.0f, glm::vec4(0.0f));
+
+            for(u32 n = 0; n < screen[i].size(); n++)
+                if(screen[i][n].atlasPage + 1u > maxPages)
+                    maxPages = screen[i][n].atlasPage + 1;
+        }
+
+        evictions += ftgx.getAtlasGeneration() - generation;
+
+        //! nothing drawn in this frame may have been moved or recycled by a later string
+        for(u32 i = 0; i < VISIBLE_TITLES; i++)
+        {
+            std::vector<ftgxGlyphQuad> again;
+            ftgx.layoutText(again, 0, 0, titles[first + i].c_str(), CJK_PIXEL_SIZE, 0, 0);
+            if(!sameQuads(again, screen[i]))
+                unstable++;
+        }
+
+        video.waitForVSync();
+    }
+
+    printf("cjk scroll, a title every %u frames: %u frames, %u pages recycled, %u pages used, %u strings changed within a frame\n",
+           framesPerTitle, frames, evictions, maxPages, unstable);
+
+    //! pages are only added beyond the limit while every page was drawn from in the last frames
+    return (unstable || evictions == 0) ? 1 : 0;
+}
+
+int main(void)
+{
+    std::vector<u8> font;
+    if(!loadFile("../data/fonts/font.ttf", font))
+    {
+        printf("font.ttf could not be read\n");
+        return 1;
+    }
+
+    int failed = 0;
+    failed |= runLatin(font);
+    std::string cjkFont = createCjkFont();
+    failed |= runCjkFill(cjkFont);
+    failed |= runCjkScroll(cjkFont, 8);
+    failed |= runCjkScroll(cjkFont, 1);
+
+    printf("atlas: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
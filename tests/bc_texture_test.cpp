@@ -0,0 +1,220 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include "gui/GuiImageData.h"
+
+//! Loads shipped PNGs through GuiImageData as RGBA8, BC1 and BC3, decodes the
+//! blocks again and prints the PSNR against the RGBA8 texture together with
+//! the surface sizes.
+
+//! the floors only catch broken block layouts or endpoint selection, the
+//! measured values are printed to compare changes of the encoders
+static const double MIN_COLOR_PSNR_DB = 30.0;
+static const double MIN_ALPHA_PSNR_DB = 35.0;
+
+static bool loadFile(const char *path, std::vector<u8> &data)
+{
+    FILE *f = fopen(path, "rb");
+    if(!f)
+        return false;
+
+    fseek(f, 0, SEEK_END);
+    data.resize(ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(&data[0], 1, data.size(), f) == data.size();
+    fclose(f);
+    return ok;
+}
+
+static void rgb565ToRgb(u16 color, int *rgb)
+{
+    int r = (color >> 11) & 0x1F;
+    int g = (color >> 5) & 0x3F;
+    int b = color & 0x1F;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+//! reference decoder of a BC1 color block into 16 rgba pixels
+static void decodeColorBlock(const u8 *src, u8 out[16][4])
+{
+    u16 color0 = src[0] | (src[1] << 8);
+    u16 color1 = src[2] | (src[3] << 8);
+    u32 indices = src[4] | (src[5] << 8) | (src[6] << 16) | ((u32)src[7] << 24);
+
+    int palette[4][4];
+    rgb565ToRgb(color0, palette[0]);
+    rgb565ToRgb(color1, palette[1]);
+    palette[0][3] = palette[1][3] = palette[2][3] = 255;
+    palette[3][3] = 255;
+
+    for(int c = 0; c < 3; ++c)
+    {
+        if(color0 > color1) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    if(color0 <= color1)
+        palette[3][3] = 0;
+
+    for(int i = 0; i < 16; ++i)
+    {
+        const int *p = palette[(indices >> (i * 2)) & 3];
+        for(int c = 0; c < 4; ++c)
+            out[i][c] = p[c];
+    }
+}
+
+//! reference decoder of a BC3 alpha block
+static void decodeAlphaBlock(const u8 *src, u8 out[16][4])
+{
+    int alpha[8];
+    alpha[0] = src[0];
+    alpha[1] = src[1];
+
+    if(alpha[0] > alpha[1]) {
+        for(int i = 2; i < 8; ++i)
+            alpha[i] = ((8 - i) * alpha[0] + (i - 1) * alpha[1]) / 7;
+    }
+    else {
+        for(int i = 2; i < 6; ++i)
+            alpha[i] = ((6 - i) * alpha[0] + (i - 1) * alpha[1]) / 5;
+        alpha[6] = 0;
+        alpha[7] = 255;
+    }
+
+    u64 indices = 0;
+    for(int i = 0; i < 6; ++i)
+        indices |= (u64)src[2 + i] << (i * 8);
+
+    for(int i = 0; i < 16; ++i)
+        out[i][3] = alpha[(indices >> (i * 3)) & 7];
+}
+
+static double psnr(double squaredError, u32 count)
+{
+    if(squaredError <= 0.0)
+        return 99.0;
+    return 10.0 * log10(255.0 * 255.0 * count / squaredError);
+}
+
+struct BlockError
+{
+    double color;
+    double alpha;
+    u32 pixels;
+};
+
+//! compares a block compressed texture with the RGBA8 texture of the same image
+static BlockError compareTexture(const GX2Texture *reference, const GX2Texture *compressed)
+{
+    BlockError error = { 0.0, 0.0, 0 };
+    const GX2Surface &ref = reference->surface;
+    const GX2Surface &bc = compressed->surface;
+    u32 blockBytes = (bc.format == GX2_SURFACE_FORMAT_T_BC3_UNORM) ? 16 : 8;
+    u8 block[16][4];
+
+    for(u32 y = 0; y < ref.height; ++y)
+    {
+        for(u32 x = 0; x < ref.width; ++x)
+        {
+            const u8 *src = (const u8*)bc.image_data + ((y / 4) * bc.pitch + (x / 4)) * blockBytes;
+            if(blockBytes == 16) {
+                decodeColorBlock(src + 8, block);
+                decodeAlphaBlock(src, block);
+            }
+            else {
+                decodeColorBlock(src, block);
+            }
+
+            u32 pixel = ((const u32*)ref.image_data)[y * ref.pitch + x];
+            const u8 *decoded = block[(y & 3) * 4 + (x & 3)];
+            for(int c = 0; c < 3; ++c)
+            {
+                double d = (double)((pixel >> (24 - c * 8)) & 0xFF) - decoded[c];
+                error.color += d * d;
+            }
+            double d = (double)(pixel & 0xFF) - decoded[3];
+            error.alpha += d * d;
+            error.pixels++;
+        }
+    }
+    return error;
+}
+
+static int runImage(const char *name)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "../data/images/%s", name);
+
+    std::vector<u8> file;
+    if(!loadFile(path, file))
+    {
+        printf("%-24s could not be read\n", name);
+        return 1;
+    }
+
+    GuiImageData rgba(&file[0], file.size(), GX2_TEX_CLAMP_CLAMP, GX2_SURFACE_FORMAT_TCS_R8_G8_B8_A8_UNORM);
+    GuiImageData bc1(&file[0], file.size(), GX2_TEX_CLAMP_CLAMP, GX2_SURFACE_FORMAT_T_BC1_UNORM);
+    GuiImageData bc3(&file[0], file.size(), GX2_TEX_CLAMP_CLAMP, GX2_SURFACE_FORMAT_T_BC3_UNORM);
+
+    if(!rgba.getTexture() || !bc1.getTexture() || !bc3.getTexture())
+    {
+        printf("%-24s could not be loaded\n", name);
+        return 1;
+    }
+
+    const GX2Texture *reference = rgba.getTexture();
+    BlockError e1 = compareTexture(reference, bc1.getTexture());
+    BlockError e3 = compareTexture(reference, bc3.getTexture());
+    bool bc3Alpha = bc3.getTexture()->surface.format == GX2_SURFACE_FORMAT_T_BC3_UNORM;
+
+    double color1 = psnr(e1.color, e1.pixels * 3);
+    double color3 = psnr(e3.color, e3.pixels * 3);
+    double alpha3 = psnr(e3.alpha, e3.pixels);
+
+    printf("%-24s %4ux%-4u rgba8 %7u bytes, bc1 %6u bytes %5.1f dB, bc3 %6u bytes %5.1f dB alpha %5.1f dB%s\n",
+           name, rgba.getWidth(), rgba.getHeight(), reference->surface.image_size,
+           bc1.getTexture()->surface.image_size, color1,
+           bc3.getTexture()->surface.image_size, color3, alpha3,
+           bc3Alpha ? "" : " (opaque, stored as bc1)");
+
+    return (color1 < MIN_COLOR_PSNR_DB || color3 < MIN_COLOR_PSNR_DB || alpha3 < MIN_ALPHA_PSNR_DB);
+}
+
+int main(void)
+{
+    static const char *images[] = {
+        "noCover.png", "noGameIcon.png", "settingsTitle.png", "bgGridTile.png", "progressWindow.png", "keyPadBg.png"
+    };
+    int failed = 0;
+
+    for(u32 i = 0; i < sizeof(images) / sizeof(images[0]); ++i)
+        failed |= runImage(images[i]);
+
+    printf("bc_texture: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,122 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include "sounds/BufferCircle.hpp"
+
+//! One producer and one consumer thread pass numbered blocks through the ring,
+//! like the decoder thread and the AX frame callback. Every block carries its
+//! sequence number in the first word and its size in the block size entry, the
+//! consumer checks that none are lost, duplicated or torn.
+
+static const u32 BLOCK_COUNT = 8;
+static const u32 BLOCK_SIZE = 256;
+static const u32 TOTAL_BLOCKS = 1000000;
+
+static u32 blockSize(u32 seq)
+{
+    return 8 + (seq % (BLOCK_SIZE / 8 - 1)) * 8;
+}
+
+static void producer(BufferCircle *circle)
+{
+    for(u32 seq = 0; seq < TOTAL_BLOCKS; seq++)
+    {
+        u8 *block;
+        while((block = circle->GetWriteBuffer()) == NULL)
+            std::this_thread::yield();
+
+        u32 size = blockSize(seq);
+        for(u32 i = 0; i < size; i += 4)
+            memcpy(block + i, &seq, 4);
+
+        circle->CommitWriteBuffer(size);
+    }
+}
+
+static void consumer(BufferCircle *circle, u32 *errorCount)
+{
+    u32 errors = 0;
+
+    for(u32 seq = 0; seq < TOTAL_BLOCKS; seq++)
+    {
+        while(!circle->IsBufferReady())
+            std::this_thread::yield();
+
+        const u8 *block = circle->GetBuffer();
+        u32 size = circle->GetBufferSize();
+        if(size != blockSize(seq))
+            errors++;
+
+        for(u32 i = 0; i < size && i < BLOCK_SIZE; i += 4)
+        {
+            u32 value;
+            memcpy(&value, block + i, 4);
+            if(value != seq)
+            {
+                errors++;
+                break;
+            }
+        }
+
+        circle->LoadNext();
+    }
+
+    if(circle->IsBufferReady())
+        errors++;
+
+    *errorCount = errors;
+}
+
+int main(void)
+{
+    BufferCircle circle;
+    int failed = 0;
+
+    if(!circle.Allocate(BLOCK_COUNT, BLOCK_SIZE))
+    {
+        printf("buffer circle: allocation failed\n");
+        return 1;
+    }
+
+    //! the producer never gets the blocks the voice still plays
+    u32 writable = 0;
+    while(circle.GetWriteBuffer() != NULL)
+    {
+        circle.CommitWriteBuffer(0);
+        writable++;
+    }
+    if(writable != BLOCK_COUNT - BufferCircle::PlayingBlocks)
+        failed = 1;
+    printf("buffer circle: %u of %u blocks writable\n", writable, BLOCK_COUNT);
+    circle.ClearBuffer();
+
+    u32 errors = 0;
+    std::thread producerThread(producer, &circle);
+    std::thread consumerThread(consumer, &circle, &errors);
+    producerThread.join();
+    consumerThread.join();
+
+    printf("buffer circle: %u blocks passed, %u errors\n", TOTAL_BLOCKS, errors);
+    if(errors)
+        failed = 1;
+
+    printf("buffer circle: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,158 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+#include "Application.h"
+#include "game/GameList.h"
+#include "gui/GuiIconCarousel.h"
+#include "gui/FreeTypeGX.h"
+#include "resources/Resources.h"
+#include "system/AsyncDeleter.h"
+#include "video/CVideo.h"
+#include "gx2_record.h"
+
+//! Turns the icon carousel half way around for 100 and 1000 titles and counts
+//! the draws of every frame. Only the icons near the front may exist and only
+//! the ones close to it get reflection and stroke, so the draws per frame must
+//! not grow with the title count. The draws of the old carousel, every title
+//! drawn with reflection and stroke, are printed next to them.
+
+static const u32 MAX_FRAMES = 2000;
+
+static void fillGameList(int count)
+{
+    GameList *list = GameList::instance();
+    list->getfilteredList().clear();
+    list->getFullGameList().resize(count);
+
+    for(int i = 0; i < count; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "GAME%04i", i);
+        list->getFullGameList()[i].id = name;
+        list->getFullGameList()[i].name = name;
+        list->getFullGameList()[i].gamepath = std::string("/no/such/folder/") + name;
+    }
+    for(int i = 0; i < count; i++)
+        list->getfilteredList().push_back(&list->getFullGameList()[i]);
+}
+
+static u32 countIcons(GuiFrame *frame)
+{
+    u32 icons = 0;
+    for(u32 i = 0; i < frame->getSize(); i++)
+    {
+        if(dynamic_cast<GameIcon *>(frame->getGuiElementAt(i)))
+            icons++;
+    }
+    return icons;
+}
+
+//! draws of one icon with and without reflection and stroke
+static u32 iconDraws(CVideo *video, GuiImageData *noIcon, bool bFullDetail)
+{
+    GameIcon icon("", noIcon);
+    icon.setRenderReflection(bFullDetail);
+    icon.setStrokeRender(bFullDetail);
+
+    GX2Record::reset();
+    icon.draw(video, video->getProjectionMtx(), video->getViewMtx(), glm::mat4(1.0f));
+    return GX2Record::get(GX2Record::CALL_DRAW);
+}
+
+static int runCarousel(int titles, u32 &peakDraws)
+{
+    fillGameList(titles);
+
+    CVideo *video = Application::instance()->getVideo();
+    GuiImageData noIcon(Resources::GetFile("noGameIcon.png"), Resources::GetFileSize("noGameIcon.png"));
+    u32 fullIconDraws = iconDraws(video, &noIcon, true);
+
+    GuiIconCarousel *carousel = new GuiIconCarousel(video->getTvWidth(), video->getTvHeight());
+
+    GX2Record::reset();
+    carousel->draw(video);
+    u32 restDraws = GX2Record::get(GX2Record::CALL_DRAW);
+    u32 restIcons = countIcons(carousel);
+
+    u32 oldIconDraws = titles * fullIconDraws;
+
+    carousel->setSelectedGame(titles / 2);
+
+    u32 frames = 0, totalDraws = 0, peakIcons = 0;
+    peakDraws = 0;
+    while(frames < MAX_FRAMES)
+    {
+        carousel->updateEffects();
+
+        GX2Record::reset();
+        carousel->draw(video);
+        u32 draws = GX2Record::get(GX2Record::CALL_DRAW);
+
+        totalDraws += draws;
+        if(draws > peakDraws)
+            peakDraws = draws;
+        if(countIcons(carousel) > peakIcons)
+            peakIcons = countIcons(carousel);
+
+        //! the dropped icons are deleted after the frame as in the main loop
+        AsyncDeleter::triggerDeleteProcess();
+        frames++;
+
+        if(!carousel->isEffectUpdateRequired())
+            break;
+    }
+
+    printf("%4i titles: %u icons and %u draws at rest, %u frames to turn half around with %.1f draws on average, %u peak and %u icons peak\n",
+           titles, restIcons, restDraws, frames, totalDraws / (double)frames, peakDraws, peakIcons);
+    printf("            %u draws for the icons alone when every title was drawn with reflection and stroke\n", oldIconDraws);
+
+    delete carousel;
+
+    int failed = 0;
+    //! the window around the front holds 25 icons and only 9 are drawn with full detail
+    if(restIcons > 25 || peakIcons > 25 || peakDraws > oldIconDraws || frames >= MAX_FRAMES)
+        failed = 1;
+    return failed;
+}
+
+int main(void)
+{
+    //! the game icons scale by the video of the application
+    Application::instance();
+
+    //! the game title is drawn with the preset font
+    FreeTypeGX *font = new FreeTypeGX(Resources::GetFile("font.ttf"), Resources::GetFileSize("font.ttf"));
+    GuiText::setPresetFont(font);
+
+    int failed = 0;
+    u32 peakDraws[2];
+    failed |= runCarousel(100, peakDraws[0]);
+    failed |= runCarousel(1000, peakDraws[1]);
+
+    //! ten times the titles but no more draws
+    if(peakDraws[1] > peakDraws[0])
+        failed = 1;
+
+    AsyncDeleter::destroyInstance();
+    GameList::destroyInstance();
+    delete font;
+
+    printf("icon carousel: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
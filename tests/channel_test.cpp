@@ -0,0 +1,201 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include "sounds/SoundDecoder.hpp"
+#include "system/CProfiler.h"
+
+//! Decodes a stereo source with a sine on one channel and silence on the other
+//! and plays the blocks into a sink that splits them like the two AX voices of
+//! Voice::play(). The voice of the silent channel must stay silent, at 48 kHz
+//! the samples must be the ones of the source. The mono mix down is run as
+//! reference and the decode time per second of audio is printed for every mode.
+
+static const double TONE_FREQ = 1000.0;
+static const u32 SECONDS = 4;
+//! the resampler of a silent channel gives exact zeros, any leak is a bug
+static const double MIN_SEPARATION_DB = 90.0;
+
+//! raw PCM decoder on an interleaved 16 bit stereo buffer
+class ToneDecoder : public SoundDecoder
+{
+public:
+    ToneDecoder(const u8 *buffer, int size, u16 rate, bool planar)
+        : SoundDecoder(buffer, size), planarRead(planar)
+    {
+        Format = FORMAT_PCM_16_BIT | CHANNELS_STEREO;
+        SampleRate = rate;
+        if(rate != 48000)
+            EnableUpsample();
+    }
+
+    //! like the mp3 decoder that writes its synth output straight into the halves
+    bool SupportsPlanarRead() { return planarRead; }
+    int ReadPlanar(s16 *left, s16 *right, int frames)
+    {
+        std::vector<s16> frame(frames * 2);
+        int ret = file_fd->read((u8*)&frame[0], frames * 2 * sizeof(s16));
+        if(ret <= 0)
+            return ret;
+
+        int done = ret >> 2;
+        for(int i = 0; i < done; i++)
+        {
+            left[i] = frame[i * 2];
+            right[i] = frame[i * 2 + 1];
+        }
+        CurPos += done << 2;
+        return done;
+    }
+private:
+    bool planarRead;
+};
+
+//! takes the queued blocks as the AX frame callback does, a stereo block holds
+//! all left samples followed by all right samples and each half goes to a voice
+struct VoiceSink
+{
+    std::vector<s16> left;
+    std::vector<s16> right;
+
+    void consume(SoundDecoder *decoder)
+    {
+        while(decoder->IsBufferReady())
+        {
+            const s16 *samples = (const s16*)decoder->GetBuffer();
+            u32 count = decoder->GetBufferSize() >> 1;
+
+            if(decoder->IsStereoOutput())
+            {
+                u32 half = count >> 1;
+                left.insert(left.end(), samples, samples + half);
+                right.insert(right.end(), samples + half, samples + count);
+            }
+            else
+            {
+                //! one voice on both sides of the mix
+                left.insert(left.end(), samples, samples + count);
+                right.insert(right.end(), samples, samples + count);
+            }
+            decoder->LoadNext();
+        }
+    }
+};
+
+//! the tone on channel ch, the other channel is silent
+static std::vector<s16> makeSource(u32 rate, u32 ch)
+{
+    u32 frames = rate * SECONDS;
+    std::vector<s16> pcm(frames * 2, 0);
+    for(u32 i = 0; i < frames; i++)
+        pcm[i * 2 + ch] = (s16)lrint(16000.0 * sin(2.0 * M_PI * TONE_FREQ * i / rate));
+    return pcm;
+}
+
+static double rms(const std::vector<s16> &samples)
+{
+    double sum = 0.0;
+    for(u32 i = 0; i < samples.size(); i++)
+        sum += (double)samples[i] * samples[i];
+    return samples.empty() ? 0.0 : sqrt(sum / samples.size());
+}
+
+static double separationDb(double own, double other)
+{
+    //! capped, an exact split has no leak at all
+    if(other < own * 1e-6)
+        return 120.0;
+    return 20.0 * log10(own / other);
+}
+
+//! decodes the source into the sink and returns the decode time
+static u64 decodeAll(const std::vector<s16> &source, u16 rate, bool stereo, bool planar, VoiceSink &sink)
+{
+    ToneDecoder decoder((const u8*)&source[0], source.size() * sizeof(s16), rate, planar);
+    decoder.SetStereoOutput(stereo);
+
+    u64 ticks = 0;
+    while(!decoder.IsEOF())
+    {
+        u64 start = CProfiler::getTime();
+        decoder.Decode();
+        ticks += CProfiler::getTime() - start;
+        sink.consume(&decoder);
+    }
+    return ticks;
+}
+
+//! counts the samples of the voices that differ from the source channels
+static u32 countMismatches(const std::vector<s16> &source, const VoiceSink &sink)
+{
+    u32 frames = source.size() / 2;
+    if(sink.left.size() != frames || sink.right.size() != frames)
+        return frames;
+
+    u32 mismatches = 0;
+    for(u32 i = 0; i < frames; i++)
+    {
+        if(sink.left[i] != source[i * 2] || sink.right[i] != source[i * 2 + 1])
+            mismatches++;
+    }
+    return mismatches;
+}
+
+static int runMode(const char *name, u16 rate, bool stereo, bool planar)
+{
+    std::vector<s16> leftSource = makeSource(rate, 0);
+    std::vector<s16> rightSource = makeSource(rate, 1);
+
+    VoiceSink leftTone, rightTone;
+    u64 ticks = decodeAll(leftSource, rate, stereo, planar, leftTone);
+    ticks += decodeAll(rightSource, rate, stereo, planar, rightTone);
+
+    double separation = std::min(separationDb(rms(leftTone.left), rms(leftTone.right)),
+                                 separationDb(rms(rightTone.right), rms(rightTone.left)));
+
+    //! without resampling the split has to give back the source samples
+    u32 mismatches = 0;
+    if(stereo && rate == 48000)
+        mismatches = countMismatches(leftSource, leftTone) + countMismatches(rightSource, rightTone);
+
+    double usPerSecond = CProfiler::ticksToMicroseconds(ticks) / (2.0 * SECONDS);
+    printf("%-22s %5u Hz: separation %6.1f dB, %u mismatched samples, %7.1f us decode per second of audio\n",
+           name, rate, separation, mismatches, usPerSecond);
+
+    if(!stereo)
+        return 0;
+    return (separation < MIN_SEPARATION_DB || mismatches) ? 1 : 0;
+}
+
+int main(void)
+{
+    int failed = 0;
+    failed |= runMode("mono mix down", 48000, false, false);
+    failed |= runMode("stereo split", 48000, true, false);
+    failed |= runMode("stereo planar read", 48000, true, true);
+    failed |= runMode("mono mix down", 32000, false, false);
+    failed |= runMode("stereo split", 32000, true, false);
+    //! the resampler works on interleaved frames, planar reads are not used then
+    failed |= runMode("stereo planar read", 32000, true, true);
+
+    printf("channel separation: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,329 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "sounds/SoundHandler.hpp"
+
+//! Runs the decode thread of SoundHandler against emulated AX voices that play
+//! their blocks in real time, one AX frame every 3 ms. The decode thread sleeps
+//! on its queue until a voice drops to its low-water mark. Its wakeups are
+//! counted against the AX frames, each of which woke it before, and a voice
+//! that reaches the end of its block without a next one counts as underrun.
+
+static const u32 AX_FRAME_US = 3000;
+static const u32 AX_FRAME_SAMPLES = 48000 * AX_FRAME_US / 1000000;
+static const u32 RUN_FRAMES = 1000;
+//! the old thread woke up on every AX frame, a tenth of it is still plenty
+static const u32 MAX_WAKEUP_DIVISOR = 10;
+
+//! AX voice as far as Voice touches it, the state has to be the second word
+typedef struct
+{
+    u32 id;
+    u32 state;
+    const u8 *samples;
+    u32 loop;
+    s32 loopOffset;
+    s32 endOffset;
+    s64 curPos;
+    u32 ratio;
+    u32 loopCount;
+    //! the end of the new block is set by the frame callback after a switch
+    bool endValid;
+    bool nextQueued;
+    u32 underruns;
+} HostVoice;
+
+//! same layout as the buffer of Voice
+typedef struct
+{
+    u16 format;
+    u16 loop;
+    u32 loop_offset;
+    u32 end_pos;
+    u32 cur_pos;
+    const unsigned char *samples;
+} HostAxBuffer;
+
+static std::vector<HostVoice *> hostVoices;
+static void (*frameCallback)(void) = NULL;
+
+static void hostAXInitWithParams(u32 *params) {}
+static void hostAXQuit(void) {}
+static u32 hostAXGetInputSamplesPerSec(void) { return 48000; }
+static s32 hostAXVoiceBegin(void *v) { return 0; }
+static s32 hostAXVoiceEnd(void *v) { return 0; }
+static void hostAXSetVoiceType(void *v, u16 type) {}
+static void hostAXSetVoiceVe(void *v, const void *vol) {}
+static s32 hostAXSetVoiceDeviceMix(void *v, s32 device, u32 id, void *mix) { return 0; }
+static void hostAXSetVoiceSrcType(void *v, u32 type) {}
+static s32 hostAXSetVoiceSrcRatio(void *v, f32 ratio) { return 0; }
+
+static void hostAXSetVoiceOffsets(void *v, const void *buf)
+{
+    HostVoice *voice = (HostVoice *)v;
+    const HostAxBuffer *axBuffer = (const HostAxBuffer *)buf;
+    voice->samples = axBuffer->samples;
+    voice->loop = axBuffer->loop;
+    voice->loopOffset = (s32)axBuffer->loop_offset;
+    voice->endOffset = (s32)axBuffer->end_pos;
+    voice->curPos = axBuffer->cur_pos;
+    voice->endValid = true;
+    voice->nextQueued = (axBuffer->loop != 0);
+}
+
+static void hostAXSetVoiceState(void *v, u16 state)
+{
+    ((HostVoice *)v)->state = state;
+}
+
+static void hostAXSetVoiceSrc(void *v, const void *src)
+{
+    ((HostVoice *)v)->ratio = ((const u32 *)src)[0];
+}
+
+static void * hostAXAcquireVoice(u32 prio, void *callback, u32 arg)
+{
+    HostVoice *voice = new HostVoice();
+    voice->id = hostVoices.size();
+    hostVoices.push_back(voice);
+    return voice;
+}
+
+static void hostAXFreeVoice(void *v)
+{
+    HostVoice *voice = (HostVoice *)v;
+    hostVoices[voice->id] = NULL;
+    delete voice;
+}
+
+static void hostAXRegisterFrameCallback(void *callback)
+{
+    frameCallback = (void (*)(void))callback;
+}
+
+static u32 hostAXGetVoiceLoopCount(void *v)
+{
+    return ((HostVoice *)v)->loopCount;
+}
+
+static void hostAXSetVoiceEndOffset(void *v, u32 offset)
+{
+    HostVoice *voice = (HostVoice *)v;
+    voice->endOffset = (s32)offset;
+    voice->endValid = true;
+}
+
+static void hostAXSetVoiceLoopOffset(void *v, u32 offset)
+{
+    HostVoice *voice = (HostVoice *)v;
+    voice->loopOffset = (s32)offset;
+    voice->nextQueued = true;
+}
+
+void (* AXInitWithParams)(u32 * params) = hostAXInitWithParams;
+void (* AXQuit)(void) = hostAXQuit;
+u32 (* AXGetInputSamplesPerSec)(void) = hostAXGetInputSamplesPerSec;
+s32 (* AXVoiceBegin)(void *v) = hostAXVoiceBegin;
+s32 (* AXVoiceEnd)(void *v) = hostAXVoiceEnd;
+void (* AXSetVoiceType)(void *v, u16 type) = hostAXSetVoiceType;
+void (* AXSetVoiceOffsets)(void *v, const void *buf) = hostAXSetVoiceOffsets;
+void (* AXSetVoiceSrcType)(void *v, u32 type) = hostAXSetVoiceSrcType;
+void (* AXSetVoiceVe)(void *v, const void *vol) = hostAXSetVoiceVe;
+s32 (* AXSetVoiceDeviceMix)(void *v, s32 device, u32 id, void *mix) = hostAXSetVoiceDeviceMix;
+void (* AXSetVoiceState)(void *v, u16 state) = hostAXSetVoiceState;
+void (* AXSetVoiceSrc)(void *v, const void *src) = hostAXSetVoiceSrc;
+s32 (* AXSetVoiceSrcRatio)(void *v, f32 ratio) = hostAXSetVoiceSrcRatio;
+void * (* AXAcquireVoice)(u32 prio, void * callback, u32 arg) = hostAXAcquireVoice;
+void (* AXFreeVoice)(void *v) = hostAXFreeVoice;
+void (* AXRegisterFrameCallback)(void * callback) = hostAXRegisterFrameCallback;
+u32 (* AXGetVoiceLoopCount)(void * v) = hostAXGetVoiceLoopCount;
+void (* AXSetVoiceEndOffset)(void * v, u32 offset) = hostAXSetVoiceEndOffset;
+void (* AXSetVoiceLoopOffset)(void * v, u32 offset) = hostAXSetVoiceLoopOffset;
+
+//! plays one AX frame, at the end of a block the voice goes on at the loop offset
+static void playFrame(HostVoice *voice)
+{
+    if(voice->state != 1)
+        return;
+
+    voice->curPos += ((u64)AX_FRAME_SAMPLES * voice->ratio) >> 16;
+    if(!voice->endValid || voice->curPos < voice->endOffset)
+        return;
+
+    if(!voice->loop)
+    {
+        //! a decoder that loops never ends, stopping is running dry as well
+        voice->state = 0;
+        voice->underruns++;
+        return;
+    }
+
+    //! no new block since the last switch, the old one is played again
+    if(!voice->nextQueued)
+        voice->underruns++;
+
+    voice->curPos = voice->loopOffset + (voice->curPos - voice->endOffset);
+    voice->loopCount++;
+    voice->endValid = false;
+    voice->nextQueued = false;
+}
+
+static std::atomic<u32> wakeups(0);
+static std::atomic<u32> requests(0);
+static int (* queueReceive)(void *queue, OSMessage *message, s32 flags) = NULL;
+
+//! a blocking receive that returns is a wakeup of the decode thread
+static int countingReceive(void *queue, OSMessage *message, s32 flags)
+{
+    int result = queueReceive(queue, message, flags);
+    if(result)
+    {
+        requests++;
+        if(flags & OS_MESSAGE_BLOCK)
+            wakeups++;
+    }
+    return result;
+}
+
+//! raw PCM that loops forever
+class ToneDecoder : public SoundDecoder
+{
+public:
+    ToneDecoder(const std::vector<s16> &pcm, u16 rate, bool stereo)
+        : SoundDecoder((const u8*)&pcm[0], pcm.size() * sizeof(s16))
+    {
+        Format = FORMAT_PCM_16_BIT | (stereo ? CHANNELS_STEREO : CHANNELS_MONO);
+        SampleRate = rate;
+        if(rate != 48000)
+            EnableUpsample();
+        SetLoop(true);
+    }
+};
+
+class HandlerProbe : public SoundHandler
+{
+public:
+    HandlerProbe() {
+        handlerInstance = this;
+    }
+    void setDecoder(int voice, SoundDecoder *decoder) {
+        decoder->SetStereoOutput(StereoOutput);
+        DecoderList[voice] = decoder;
+    }
+};
+
+struct Source
+{
+    u16 rate;
+    bool stereo;
+    std::vector<s16> pcm;
+};
+
+static void makeSource(Source &source, u16 rate, bool stereo)
+{
+    u32 channels = stereo ? 2 : 1;
+    source.rate = rate;
+    source.stereo = stereo;
+    //! a second long, the decoders rewind during the run
+    source.pcm.resize(rate * channels);
+    for(u32 i = 0; i < rate; i++)
+    {
+        for(u32 ch = 0; ch < channels; ch++)
+            source.pcm[i * channels + ch] = (s16)lrint(8000.0 * sin(2.0 * M_PI * (440.0 * (ch + 1)) * i / rate));
+    }
+}
+
+static int runVoices(const char *name, const std::vector<Source> &sources)
+{
+    HandlerProbe *handler = new HandlerProbe();
+
+    for(u32 i = 0; i < sources.size(); i++)
+    {
+        handler->setDecoder(i, new ToneDecoder(sources[i].pcm, sources[i].rate, sources[i].stereo));
+        handler->RequestDecode(i);
+    }
+
+    //! the buffers are filled before playback starts like after GuiSound::Load()
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    for(u32 i = 0; i < sources.size(); i++)
+        handler->getVoice(i)->setState(Voice::STATE_START);
+
+    wakeups = 0;
+    requests = 0;
+
+    std::chrono::steady_clock::time_point next = std::chrono::steady_clock::now();
+    for(u32 frame = 0; frame < RUN_FRAMES; frame++)
+    {
+        next += std::chrono::microseconds(AX_FRAME_US);
+        std::this_thread::sleep_until(next);
+
+        for(u32 v = 0; v < hostVoices.size(); v++)
+        {
+            if(hostVoices[v])
+                playFrame(hostVoices[v]);
+        }
+        if(frameCallback)
+            frameCallback();
+    }
+
+    u32 underruns = 0;
+    for(u32 v = 0; v < hostVoices.size(); v++)
+    {
+        if(hostVoices[v])
+            underruns += hostVoices[v]->underruns;
+    }
+    u32 runWakeups = wakeups;
+    u32 runRequests = requests;
+
+    printf("%-16s %2u voices: %4u AX frames, %3u wakeups, %3u refill requests, %u underruns\n",
+           name, (u32)sources.size(), RUN_FRAMES, runWakeups, runRequests, underruns);
+    printf("                 the frame callback woke the thread %u times and it polled %u slots\n",
+           RUN_FRAMES, RUN_FRAMES * MAX_DECODERS);
+
+    SoundHandler::DestroyInstance();
+
+    return (underruns || runWakeups == 0 || runWakeups > RUN_FRAMES / MAX_WAKEUP_DIVISOR) ? 1 : 0;
+}
+
+int main(void)
+{
+    queueReceive = OSReceiveMessage;
+    OSReceiveMessage = countingReceive;
+
+    std::vector<Source> mixed(4);
+    makeSource(mixed[0], 48000, true);
+    makeSource(mixed[1], 32000, true);
+    makeSource(mixed[2], 48000, false);
+    makeSource(mixed[3], 22050, false);
+
+    std::vector<Source> full(MAX_DECODERS);
+    for(u32 i = 0; i < full.size(); i++)
+        makeSource(full[i], (i & 1) ? 32000 : 48000, true);
+
+    int failed = 0;
+    failed |= runVoices("music and sounds", mixed);
+    failed |= runVoices("every voice", full);
+
+    printf("decode wakeups: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <map>
+#include <new>
+#include <vector>
+#include "gui/GuiGameBrowser.h"
+#include "system/CProfiler.h"
+
+//! Turns 1,000 items once around a carousel circle and sorts them by depth in
+//! every frame, once with the insertion sort of the carousels and once through
+//! a std::multimap as the carousels did before. Both orders have to match and
+//! the sort must not allocate.
+
+static const int ITEMS = 1000;
+static const int FRAMES = 720;
+
+static u32 allocations = 0;
+
+void * operator new(size_t size)
+{
+    allocations++;
+    void *ptr = malloc(size ? size : 1);
+    if(!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+//! opens up the sort of the browsers
+class DrawOrder : public GuiGameBrowser
+{
+public:
+    using GuiGameBrowser::sortDrawOrder;
+};
+
+static void updateDepth(std::vector<f32> & drawDepth, f32 circlePosition)
+{
+    for(int i = 0; i < ITEMS; i++)
+        drawDepth[i] = sinf((360.0f / ITEMS * i + circlePosition + 90.0f) * M_PI / 180.0f);
+}
+
+int main(void)
+{
+    std::vector<f32> drawDepth(ITEMS);
+    std::vector<int> drawOrder(ITEMS);
+    std::vector<int> mapOrder(ITEMS);
+    for(int i = 0; i < ITEMS; i++)
+        drawOrder[i] = i;
+
+    u64 sortTicks = 0, mapTicks = 0;
+    u32 sortAllocations = 0, mapAllocations = 0;
+    int mismatches = 0;
+
+    for(int frame = 0; frame < FRAMES; frame++)
+    {
+        updateDepth(drawDepth, frame * 0.5f);
+
+        u32 allocationsBefore = allocations;
+        u64 start = CProfiler::getTime();
+        DrawOrder::sortDrawOrder(drawOrder, drawDepth);
+        sortTicks += CProfiler::getTime() - start;
+        sortAllocations += allocations - allocationsBefore;
+
+        allocationsBefore = allocations;
+        start = CProfiler::getTime();
+        {
+            std::multimap<f32, int> drawMap;
+            for(int i = 0; i < ITEMS; i++)
+                drawMap.insert(std::pair<f32, int>(drawDepth[i], i));
+
+            int n = 0;
+            for(std::multimap<f32, int>::iterator itr = drawMap.begin(); itr != drawMap.end(); itr++)
+                mapOrder[n++] = itr->second;
+        }
+        mapTicks += CProfiler::getTime() - start;
+        mapAllocations += allocations - allocationsBefore;
+
+        if(drawOrder != mapOrder)
+            mismatches++;
+    }
+
+    printf("draw order of %i items: insertion sort %.1f us and %.1f allocations per frame, multimap %.1f us and %.1f allocations per frame\n",
+           ITEMS, CProfiler::ticksToMicroseconds(sortTicks) / (double)FRAMES, sortAllocations / (double)FRAMES,
+           CProfiler::ticksToMicroseconds(mapTicks) / (double)FRAMES, mapAllocations / (double)FRAMES);
+    printf("draw order: %i of %i frames differ from the multimap order\n", mismatches, FRAMES);
+
+    int failed = (mismatches != 0 || sortAllocations != 0);
+    printf("draw order: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,239 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include "gui/FreeTypeGX.h"
+#include "system/CProfiler.h"
+
+//! Measures the widths of a 1,000 title game list with FreeTypeGX::getWidth()
+//! against a reference that looks every glyph up in a map and asks FreeType
+//! for the kerning of every pair, like getWidth() did before the metrics and
+//! kerning tables. The bundled font has no kerning table, so DejaVu Sans is
+//! measured as well when it is installed.
+
+static const u32 TITLES = 1000;
+static const u32 REPEATS = 20;
+static const int16_t SIZES[] = { 20, 28, 48 };
+static const char *KERNING_FONT = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+
+static bool loadFile(const char *path, std::vector<u8> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if(!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    data.resize(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    bool ok = fread(&data[0], 1, data.size(), file) == data.size();
+    fclose(file);
+    return ok;
+}
+
+//! game titles made of common words, a few of them greek or cyrillic
+static std::vector<std::wstring> makeTitles(void)
+{
+    static const wchar_t *words[] =
+    {
+        L"Super", L"Mario", L"Kart", L"Legend", L"of", L"the", L"Wild", L"Breath", L"Xenoblade",
+        L"Chronicles", L"Pokémon", L"Donkey", L"Kong", L"Country", L"Tropical", L"Freeze", L"Smash",
+        L"Bros.", L"Splatoon", L"Pikmin", L"Yoshi's", L"Woolly", L"World", L"Captain", L"Toad",
+        L"Treasure", L"Tracker", L"Hyrule", L"Warriors", L"Bayonetta", L"Fatal", L"Frame", L"Zoë",
+        L"Façade", L"Édition", L"Straße", L"Año", L"AVATAR", L"WAVE", L"Tetris", L"VVVVVV", L"Lost"
+    };
+    static const wchar_t *foreignWords[] =
+    {
+        L"Ελληνικά", L"Παιχνίδι", L"Οδύσσεια", L"Русский", L"Игра", L"Приключение"
+    };
+    static const u32 wordCount = sizeof(words) / sizeof(words[0]);
+    static const u32 foreignCount = sizeof(foreignWords) / sizeof(foreignWords[0]);
+
+    std::vector<std::wstring> titles(TITLES);
+    u32 seed = 12345;
+
+    for(u32 t = 0; t < TITLES; t++)
+    {
+        seed = seed * 1103515245 + 12345;
+        u32 count = 2 + ((seed >> 16) % 5);
+
+        for(u32 w = 0; w < count; w++)
+        {
+            seed = seed * 1103515245 + 12345;
+            if(w > 0)
+                titles[t] += L' ';
+
+            if((t % 10) == 9 && w == count - 1)
+                titles[t] += foreignWords[(seed >> 16) % foreignCount];
+            else
+                titles[t] += words[(seed >> 16) % wordCount];
+        }
+    }
+    return titles;
+}
+
+//! the per call lookups of getWidth() without the tables
+class ReferenceWidth
+{
+public:
+    ReferenceWidth(const std::vector<u8> &font)
+        : pixelSize(0)
+    {
+        FT_Init_FreeType(&library);
+        FT_New_Memory_Face(library, &font[0], font.size(), 0, &face);
+        kerning = FT_HAS_KERNING(face);
+    }
+    ~ReferenceWidth()
+    {
+        FT_Done_Face(face);
+        FT_Done_FreeType(library);
+    }
+
+    u32 getWidth(const wchar_t *text, int16_t size)
+    {
+        std::map<wchar_t, Glyph> & glyphs = sizes[size];
+        u32 width = 0;
+        u32 prevIndex = 0;
+
+        for(int i = 0; text[i]; i++)
+        {
+            std::map<wchar_t, Glyph>::iterator itr = glyphs.find(text[i]);
+            if(itr == glyphs.end())
+            {
+                setSize(size);
+                Glyph glyph;
+                glyph.index = FT_Get_Char_Index(face, text[i]);
+                glyph.advance = 0;
+                if(glyph.index != 0 && FT_Load_Glyph(face, glyph.index, FT_LOAD_DEFAULT) == 0)
+                    glyph.advance = face->glyph->advance.x >> 6;
+                else
+                    glyph.index = 0;
+                itr = glyphs.insert(std::make_pair(text[i], glyph)).first;
+            }
+
+            if(itr->second.index != 0)
+            {
+                if(kerning && i > 0 && prevIndex != 0)
+                {
+                    setSize(size);
+                    FT_Vector pairDelta;
+                    FT_Get_Kerning(face, prevIndex, itr->second.index, FT_KERNING_DEFAULT, &pairDelta);
+                    width += pairDelta.x >> 6;
+                }
+                width += itr->second.advance;
+            }
+            prevIndex = itr->second.index;
+        }
+        return (uint16_t)width;
+    }
+
+    bool hasKerning(void) const {
+        return kerning;
+    }
+private:
+    typedef struct
+    {
+        u32 index;
+        u32 advance;
+    } Glyph;
+
+    void setSize(int16_t size)
+    {
+        if(pixelSize != size)
+        {
+            pixelSize = size;
+            FT_Set_Pixel_Sizes(face, 0, size);
+        }
+    }
+
+    FT_Library library;
+    FT_Face face;
+    bool kerning;
+    int16_t pixelSize;
+    std::map<int16_t, std::map<wchar_t, Glyph> > sizes;
+};
+
+static int runFont(const char *name, const std::vector<u8> &font, const std::vector<std::wstring> &titles)
+{
+    FreeTypeGX ftgx(&font[0], font.size());
+    ReferenceWidth reference(font);
+    u32 mismatches = 0;
+    u32 checksum = 0;
+
+    //! the first pass caches the glyphs of both
+    u64 start = CProfiler::getTime();
+    for(u32 s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); s++)
+        for(u32 t = 0; t < TITLES; t++)
+            checksum += ftgx.getWidth(titles[t].c_str(), SIZES[s]);
+    u32 firstTime = CProfiler::ticksToMicroseconds(CProfiler::getTime() - start);
+
+    for(u32 s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); s++)
+        for(u32 t = 0; t < TITLES; t++)
+            if(reference.getWidth(titles[t].c_str(), SIZES[s]) != ftgx.getWidth(titles[t].c_str(), SIZES[s]))
+                mismatches++;
+
+    start = CProfiler::getTime();
+    for(u32 r = 0; r < REPEATS; r++)
+        for(u32 s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); s++)
+            for(u32 t = 0; t < TITLES; t++)
+                checksum += ftgx.getWidth(titles[t].c_str(), SIZES[s]);
+    u32 tableTime = CProfiler::ticksToMicroseconds(CProfiler::getTime() - start);
+
+    start = CProfiler::getTime();
+    for(u32 r = 0; r < REPEATS; r++)
+        for(u32 s = 0; s < sizeof(SIZES) / sizeof(SIZES[0]); s++)
+            for(u32 t = 0; t < TITLES; t++)
+                checksum += reference.getWidth(titles[t].c_str(), SIZES[s]);
+    u32 referenceTime = CProfiler::ticksToMicroseconds(CProfiler::getTime() - start);
+
+    u32 sizes = sizeof(SIZES) / sizeof(SIZES[0]);
+    u32 lists = REPEATS * sizes;
+    printf("%-12s kerning %s: first list %u us, then %u us per list with the tables, %u us with map and FreeType lookups (%.1fx), %u widths differ (checksum %u)\n",
+           name, reference.hasKerning() ? "yes" : "no", firstTime / sizes, tableTime / lists, referenceTime / lists,
+           tableTime ? (double)referenceTime / tableTime : 0.0, mismatches, checksum);
+
+    return mismatches ? 1 : 0;
+}
+
+int main(void)
+{
+    std::vector<u8> font;
+    if(!loadFile("../data/fonts/font.ttf", font))
+    {
+        printf("font.ttf could not be read\n");
+        return 1;
+    }
+
+    std::vector<std::wstring> titles = makeTitles();
+
+    int failed = 0;
+    failed |= runFont("font.ttf", font, titles);
+
+    std::vector<u8> kerningFont;
+    if(loadFile(KERNING_FONT, kerningFont))
+        failed |= runFont("DejaVuSans", kerningFont, titles);
+    else
+        printf("%s not found, kerning not measured\n", KERNING_FONT);
+
+    printf("font width: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
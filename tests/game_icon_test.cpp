@@ -0,0 +1,101 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <malloc.h>
+#include <unistd.h>
+#include <vector>
+#include "Application.h"
+#include "gui/GameIcon.h"
+#include "gui/GameIconModel.h"
+#include "video/shaders/Shader.h"
+#include "gx2_record.h"
+
+//! Creates the icons of a 300 game carousel and checks that they all draw from
+//! the same model buffers, which are copied and invalidated only once. The heap
+//! grown per icon is printed next to the model bytes every icon used to copy.
+
+static const u32 ICONS = 300;
+
+//! reads the vertex buffers of the GuiImage base
+class IconProbe : public GameIcon
+{
+public:
+    IconProbe(GuiImageData *preload) : GameIcon("", preload) {}
+
+    const f32 *getPosVtxs(void) const {
+        return posVtxs;
+    }
+    const f32 *getTexCoords(void) const {
+        return texCoords;
+    }
+};
+
+int main(void)
+{
+    //! GameIcon::draw() scales by the video of the application
+    Application::instance();
+
+    //! the buffers of the old per icon copy: model, mirror and stroke
+    u32 modelBytes = sizeof(cfGameIconPosVtxs) + 2 * sizeof(cfGameIconTexCoords) + sizeof(cfGameIconStrokeVtxs)
+                   + cuGameIconStrokeVtxCount * (Shader::cuTexCoordAttrSize + Shader::cuColorAttrSize);
+
+    GuiImageData preload;
+    std::vector<IconProbe *> icons(ICONS);
+
+    GX2Record::reset();
+    //! the first icon creates the model and the loader thread
+    icons[0] = new IconProbe(&preload);
+    u32 modelInvalidates = GX2Record::get(GX2Record::CALL_INVALIDATE);
+
+    GX2Record::reset();
+    size_t heapBefore = mallinfo2().uordblks;
+    for(u32 i = 1; i < ICONS; i++)
+        icons[i] = new IconProbe(&preload);
+    size_t heapAfter = mallinfo2().uordblks;
+    u32 iconInvalidates = GX2Record::get(GX2Record::CALL_INVALIDATE);
+
+    u32 shared = 0;
+    for(u32 i = 0; i < ICONS; i++)
+    {
+        if(icons[i]->getPosVtxs() && icons[i]->getPosVtxs() == icons[0]->getPosVtxs() && icons[i]->getTexCoords() == icons[0]->getTexCoords())
+            shared++;
+    }
+
+    //! the model goes away with the last icon and is created again with the next one
+    for(u32 i = 0; i < ICONS; i++)
+        delete icons[i];
+
+    GX2Record::reset();
+    IconProbe *again = new IconProbe(&preload);
+    u32 recreateInvalidates = GX2Record::get(GX2Record::CALL_INVALIDATE);
+    bool recreated = again->getPosVtxs() != NULL;
+    delete again;
+
+    double heapPerIcon = (double)(heapAfter - heapBefore) / (ICONS - 1);
+
+    printf("game icon: %u of %u icons share the model, %u invalidates for the first icon, %u for the other %u\n",
+           shared, ICONS, modelInvalidates, iconInvalidates, ICONS - 1);
+    printf("game icon: heap grows %.0f bytes per icon with sizeof(GameIcon) %u, the model copy was another %u bytes per icon\n",
+           heapPerIcon, (u32)sizeof(GameIcon), modelBytes);
+
+    int failed = (shared != ICONS || modelInvalidates == 0 || iconInvalidates != 0 || recreateInvalidates != modelInvalidates || !recreated) ? 1 : 0;
+
+    Application::destroyInstance();
+
+    printf("game icon: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,102 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <png.h>
+#include <gctypes.h>
+#include <gd.h>
+
+//! host replacement of libgd, see host/gd.h
+extern "C" {
+
+static gdImagePtr gdImageCreateTrueColor(int sx, int sy)
+{
+    gdImagePtr im = (gdImagePtr) calloc(1, sizeof(gdImage));
+    if(!im)
+        return NULL;
+
+    im->sx = sx;
+    im->sy = sy;
+    im->trueColor = 1;
+    im->tpixels = (int **) calloc(sy, sizeof(int *));
+    for(int y = 0; im->tpixels && y < sy; y++)
+        im->tpixels[y] = (int *) calloc(sx, sizeof(int));
+    return im;
+}
+
+gdImagePtr gdImageCreateFromPngPtr(int size, void *data)
+{
+    png_image png;
+    memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+
+    if(!png_image_begin_read_from_memory(&png, data, size))
+        return NULL;
+
+    png.format = PNG_FORMAT_RGBA;
+    png_bytep rgba = (png_bytep) malloc(PNG_IMAGE_SIZE(png));
+    if(!rgba || !png_image_finish_read(&png, NULL, rgba, 0, NULL)) {
+        free(rgba);
+        png_image_free(&png);
+        return NULL;
+    }
+
+    gdImagePtr im = gdImageCreateTrueColor(png.width, png.height);
+    for(u32 y = 0; im && y < png.height; y++)
+    {
+        for(u32 x = 0; x < png.width; x++)
+        {
+            const png_byte *p = rgba + (y * png.width + x) * 4;
+            //! gd stores 7 bit alpha with 0 being opaque
+            im->tpixels[y][x] = gdTrueColorAlpha(p[0], p[1], p[2], gdAlphaMax - (p[3] >> 1));
+        }
+    }
+    free(rgba);
+    return im;
+}
+
+gdImagePtr gdImageCreateFromJpegPtr(int size, void *data)
+{
+    return NULL;
+}
+
+gdImagePtr gdImageCreateFromBmpPtr(int size, void *data)
+{
+    return NULL;
+}
+
+gdImagePtr gdImageCreateFromTgaPtr(int size, void *data)
+{
+    return NULL;
+}
+
+int gdImageGetPixel(gdImagePtr im, int x, int y)
+{
+    if(x < 0 || y < 0 || x >= im->sx || y >= im->sy)
+        return 0;
+    return im->tpixels[y][x];
+}
+
+void gdImageDestroy(gdImagePtr im)
+{
+    for(int y = 0; im->tpixels && y < im->sy; y++)
+        free(im->tpixels[y]);
+    free(im->tpixels);
+    free(im);
+}
+
+}
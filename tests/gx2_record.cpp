@@ -0,0 +1,202 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <string.h>
+#include "gx2_record.h"
+#include "dynamic_libs/gx2_functions.h"
+
+u32 GX2Record::counts[GX2Record::CALL_COUNT];
+
+void GX2Record::reset(void)
+{
+    memset(counts, 0, sizeof(counts));
+}
+
+const char * GX2Record::getName(int call)
+{
+    static const char * names[CALL_COUNT] =
+    {
+        "draws", "vertices", "fetch", "vertex", "pixel", "attrib",
+        "texture", "sampler", "vs uniform", "ps uniform", "invalidate"
+    };
+    return names[call];
+}
+
+static void recDrawEx(s32 primitive_type, u32 count, u32 first_vertex, u32 instances_count)
+{
+    GX2Record::counts[GX2Record::CALL_DRAW]++;
+    GX2Record::counts[GX2Record::CALL_VERTICES] += count * instances_count;
+}
+
+static void recDrawIndexedEx(s32 primitive_type, u32 count, s32 index_format, const void* idx, u32 first_vertex, u32 instances_count)
+{
+    GX2Record::counts[GX2Record::CALL_DRAW]++;
+    GX2Record::counts[GX2Record::CALL_VERTICES] += count * instances_count;
+}
+
+static void recSetFetchShader(const GX2FetchShader* fs)
+{
+    GX2Record::counts[GX2Record::CALL_FETCH_SHADER]++;
+}
+
+static void recSetVertexShader(const GX2VertexShader* vertexShader)
+{
+    GX2Record::counts[GX2Record::CALL_VERTEX_SHADER]++;
+}
+
+static void recSetPixelShader(const GX2PixelShader* pixelShader)
+{
+    GX2Record::counts[GX2Record::CALL_PIXEL_SHADER]++;
+}
+
+static void recSetAttribBuffer(u32 attr_index, u32 attr_size, u32 stride, const void* attr)
+{
+    GX2Record::counts[GX2Record::CALL_ATTRIB_BUFFER]++;
+}
+
+static void recSetPixelTexture(const GX2Texture *texture, u32 texture_hw_location)
+{
+    GX2Record::counts[GX2Record::CALL_TEXTURE]++;
+}
+
+static void recSetPixelSampler(const GX2Sampler *sampler, u32 sampler_hw_location)
+{
+    GX2Record::counts[GX2Record::CALL_SAMPLER]++;
+}
+
+static void recSetVertexUniformReg(u32 offset, u32 count, const void *values)
+{
+    GX2Record::counts[GX2Record::CALL_VERTEX_UNIFORM]++;
+}
+
+static void recSetPixelUniformReg(u32 offset, u32 count, const void *values)
+{
+    GX2Record::counts[GX2Record::CALL_PIXEL_UNIFORM]++;
+}
+
+static void recInvalidate(s32 invalidate_type, void * ptr, u32 buffer_size)
+{
+    GX2Record::counts[GX2Record::CALL_INVALIDATE]++;
+}
+
+static u32 recCalcFetchShaderSizeEx(u32 num_attrib, s32 fetch_shader_type, s32 tessellation_mode)
+{
+    //! real fetch shaders are a few bytes per attribute, the content is never read here
+    return 0x20 + num_attrib * 0x10;
+}
+
+static void recInitFetchShaderEx(GX2FetchShader* fs, void* fs_buffer, u32 count, const GX2AttribStream* attribs, s32 fetch_shader_type, s32 tessellation_mode)
+{
+    memset(fs, 0, sizeof(GX2FetchShader));
+}
+
+//! linear aligned surfaces with the pitch counted in elements, compressed formats use 4x4 blocks
+static void hostCalcSurfaceSizeAndAlignment(GX2Surface *surface)
+{
+    u32 bytesPerElement = 4;
+    u32 blockSize = 1;
+
+    switch(surface->format)
+    {
+    case GX2_SURFACE_FORMAT_TCS_R5_G6_B5_UNORM:
+        bytesPerElement = 2;
+        break;
+    case GX2_SURFACE_FORMAT_T_BC1_UNORM:
+        bytesPerElement = 8;
+        blockSize = 4;
+        break;
+    case GX2_SURFACE_FORMAT_T_BC3_UNORM:
+        bytesPerElement = 16;
+        blockSize = 4;
+        break;
+    default:
+        break;
+    }
+
+    u32 rows = (surface->height + blockSize - 1) / blockSize;
+    surface->pitch = (((surface->width + blockSize - 1) / blockSize) + 31) & ~31;
+    surface->align = 0x100;
+    surface->image_size = surface->pitch * rows * surface->depth * bytesPerElement;
+}
+
+static void hostInitTextureRegs(GX2Texture *texture)
+{
+}
+
+static void hostInitSampler(GX2Sampler *sampler, s32 tex_clamp, s32 min_mag_filter)
+{
+    memset(sampler, 0, sizeof(GX2Sampler));
+}
+
+static void hostWaitForVsync(void)
+{
+}
+
+//! render state the host has nothing to set up for
+static void hostSetDepthOnlyControl(s32 enable_depth, s32 enable_depth_write, s32 depth_comp_function)
+{
+}
+
+static void hostSetCullOnlyControl(s32 front_face_mode, s32 cull_front, s32 cull_back)
+{
+}
+
+static void hostSetLineWidth(f32 width)
+{
+}
+
+static void hostSetDepthStencilControl(s32 enable_depth_test, s32 enable_depth_write, s32 depth_comp_function,  s32 stencil_test_enable, s32 back_stencil_enable,
+                                       s32 font_stencil_func, s32 front_stencil_z_pass, s32 front_stencil_z_fail, s32 front_stencil_fail,
+                                       s32 back_stencil_func, s32 back_stencil_z_pass, s32 back_stencil_z_fail, s32 back_stencil_fail)
+{
+}
+
+static void hostSetStencilMask(u8 mask_front, u8 write_mask_front, u8 ref_front, u8 mask_back, u8 write_mask_back, u8 ref_back)
+{
+}
+
+//! the entry points are function pointers loaded from gx2.rpl on the console
+extern "C" {
+void (* GX2DrawEx)(s32 primitive_type, u32 count, u32 first_vertex, u32 instances_count) = recDrawEx;
+void (* GX2DrawIndexedEx)(s32 primitive_type, u32 count, s32 index_format, const void* idx, u32 first_vertex, u32 instances_count) = recDrawIndexedEx;
+void (* GX2SetFetchShader)(const GX2FetchShader* fs) = recSetFetchShader;
+void (* GX2SetVertexShader)(const GX2VertexShader* vertexShader) = recSetVertexShader;
+void (* GX2SetPixelShader)(const GX2PixelShader* pixelShader) = recSetPixelShader;
+void (* GX2SetAttribBuffer)(u32 attr_index, u32 attr_size, u32 stride, const void* attr) = recSetAttribBuffer;
+void (* GX2SetPixelTexture)(const GX2Texture *texture, u32 texture_hw_location) = recSetPixelTexture;
+void (* GX2SetPixelSampler)(const GX2Sampler *sampler, u32 sampler_hw_location) = recSetPixelSampler;
+void (* GX2SetVertexUniformReg)(u32 offset, u32 count, const void *values) = recSetVertexUniformReg;
+void (* GX2SetPixelUniformReg)(u32 offset, u32 count, const void *values) = recSetPixelUniformReg;
+void (* GX2Invalidate)(s32 invalidate_type, void * ptr, u32 buffer_size) = recInvalidate;
+u32 (* GX2CalcFetchShaderSizeEx)(u32 num_attrib, s32 fetch_shader_type, s32 tessellation_mode) = recCalcFetchShaderSizeEx;
+void (* GX2InitFetchShaderEx)(GX2FetchShader* fs, void* fs_buffer, u32 count, const GX2AttribStream* attribs, s32 fetch_shader_type, s32 tessellation_mode) = recInitFetchShaderEx;
+void (* GX2CalcSurfaceSizeAndAlignment)(GX2Surface *surface) = hostCalcSurfaceSizeAndAlignment;
+void (* GX2InitTextureRegs)(GX2Texture *texture) = hostInitTextureRegs;
+void (* GX2InitSampler)(GX2Sampler *sampler, s32 tex_clamp, s32 min_mag_filter) = hostInitSampler;
+void (* GX2WaitForVsync)(void) = hostWaitForVsync;
+void (* GX2SetDepthOnlyControl)(s32 enable_depth, s32 enable_depth_write, s32 depth_comp_function) = hostSetDepthOnlyControl;
+void (* GX2SetCullOnlyControl)(s32 front_face_mode, s32 cull_front, s32 cull_back) = hostSetCullOnlyControl;
+void (* GX2SetLineWidth)(f32 width) = hostSetLineWidth;
+void (* GX2SetDepthStencilControl)(s32 enable_depth_test, s32 enable_depth_write, s32 depth_comp_function,  s32 stencil_test_enable, s32 back_stencil_enable,
+                                   s32 font_stencil_func, s32 front_stencil_z_pass, s32 front_stencil_z_fail, s32 front_stencil_fail,
+                                   s32 back_stencil_func, s32 back_stencil_z_pass, s32 back_stencil_z_fail, s32 back_stencil_fail) = hostSetDepthStencilControl;
+void (* GX2SetStencilMask)(u8 mask_front, u8 write_mask_front, u8 ref_front, u8 mask_back, u8 write_mask_back, u8 ref_back) = hostSetStencilMask;
+
+//! the profiler summary is written to the UDP logger on the console
+void log_printf(const char *format, ...)
+{
+}
+}
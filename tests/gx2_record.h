@@ -0,0 +1,53 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _GX2_RECORD_H_
+#define _GX2_RECORD_H_
+
+#include <gctypes.h>
+
+//!Host implementation of the GX2 entry points used by the render layer.
+//!Nothing is rendered, every call is only counted so that the number of
+//!draws and state changes of a frame can be checked off-console.
+class GX2Record
+{
+public:
+    enum eCall
+    {
+        CALL_DRAW = 0,
+        CALL_VERTICES,
+        CALL_FETCH_SHADER,
+        CALL_VERTEX_SHADER,
+        CALL_PIXEL_SHADER,
+        CALL_ATTRIB_BUFFER,
+        CALL_TEXTURE,
+        CALL_SAMPLER,
+        CALL_VERTEX_UNIFORM,
+        CALL_PIXEL_UNIFORM,
+        CALL_INVALIDATE,
+        CALL_COUNT
+    };
+
+    static void reset(void);
+    static u32 get(int call) {
+        return counts[call];
+    }
+    static const char * getName(int call);
+
+    static u32 counts[CALL_COUNT];
+};
+
+#endif // _GX2_RECORD_H_
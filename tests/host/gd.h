@@ -0,0 +1,65 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _HOST_GD_H_
+#define _HOST_GD_H_
+
+//! host replacement of the libgd subset GuiImageData uses. Only PNG is
+//! decoded (with libpng, see gd_host.cpp), all images are true color.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct gdImageStruct
+{
+    int sx;
+    int sy;
+    int trueColor;
+    int **tpixels;
+} gdImage;
+
+typedef gdImage * gdImagePtr;
+
+#define gdAlphaMax                  127
+#define gdAlphaOpaque               0
+#define gdAlphaTransparent          127
+
+#define gdTrueColorAlpha(r, g, b, a) (((a) << 24) + ((r) << 16) + ((g) << 8) + (b))
+#define gdTrueColorGetAlpha(c)      (((c) & 0x7F000000) >> 24)
+#define gdTrueColorGetRed(c)        (((c) & 0xFF0000) >> 16)
+#define gdTrueColorGetGreen(c)      (((c) & 0x00FF00) >> 8)
+#define gdTrueColorGetBlue(c)       ((c) & 0x0000FF)
+
+#define gdImageSX(im)               ((im)->sx)
+#define gdImageSY(im)               ((im)->sy)
+#define gdImageRed(im, c)           gdTrueColorGetRed(c)
+#define gdImageGreen(im, c)         gdTrueColorGetGreen(c)
+#define gdImageBlue(im, c)          gdTrueColorGetBlue(c)
+#define gdImageAlpha(im, c)         gdTrueColorGetAlpha(c)
+
+gdImagePtr gdImageCreateFromPngPtr(int size, void *data);
+gdImagePtr gdImageCreateFromJpegPtr(int size, void *data);
+gdImagePtr gdImageCreateFromBmpPtr(int size, void *data);
+gdImagePtr gdImageCreateFromTgaPtr(int size, void *data);
+int gdImageGetPixel(gdImagePtr im, int x, int y);
+void gdImageDestroy(gdImagePtr im);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _HOST_GD_H_
@@ -0,0 +1,119 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _HOST_MAD_H_
+#define _HOST_MAD_H_
+
+//! host replacement of libmad for the checks in tests/, it has the fields and
+//! calls Mp3Decoder uses. Frames are a small header and a payload instead of
+//! MPEG audio, see mad_host.cpp for the layout.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef signed int mad_fixed_t;
+
+#define MAD_F_FRACBITS      28
+#define MAD_F_ONE           ((mad_fixed_t)0x10000000L)
+#define MAD_BUFFER_GUARD    8
+
+enum mad_error
+{
+    MAD_ERROR_NONE          = 0x0000,
+    MAD_ERROR_BUFLEN        = 0x0001,
+    MAD_ERROR_LOSTSYNC      = 0x0101
+};
+
+#define MAD_RECOVERABLE(error)  ((error) & 0xff00)
+
+enum mad_mode
+{
+    MAD_MODE_SINGLE_CHANNEL = 0,
+    MAD_MODE_STEREO         = 3
+};
+
+typedef struct
+{
+    signed long seconds;
+    unsigned long fraction;
+} mad_timer_t;
+
+struct mad_header
+{
+    enum mad_mode mode;
+    unsigned int samplerate;
+    mad_timer_t duration;
+};
+
+#define MAD_NCHANNELS(header)   ((header)->mode ? 2 : 1)
+
+struct mad_stream
+{
+    unsigned char const *buffer;
+    unsigned char const *bufend;
+    unsigned char const *this_frame;
+    unsigned char const *next_frame;
+    enum mad_error error;
+};
+
+struct mad_frame
+{
+    struct mad_header header;
+    //! host frames only carry the sample count and the seed of their samples
+    unsigned short length;
+    unsigned int seed;
+};
+
+struct mad_pcm
+{
+    unsigned int samplerate;
+    unsigned short channels;
+    unsigned short length;
+    mad_fixed_t samples[2][1152];
+};
+
+struct mad_synth
+{
+    struct mad_pcm pcm;
+};
+
+void mad_stream_init(struct mad_stream *stream);
+void mad_stream_finish(struct mad_stream *stream);
+void mad_stream_buffer(struct mad_stream *stream, unsigned char const *buffer, unsigned long length);
+
+void mad_frame_init(struct mad_frame *frame);
+void mad_frame_finish(struct mad_frame *frame);
+int mad_frame_decode(struct mad_frame *frame, struct mad_stream *stream);
+
+void mad_synth_init(struct mad_synth *synth);
+void mad_synth_frame(struct mad_synth *synth, struct mad_frame const *frame);
+#define mad_synth_finish(synth)
+
+void mad_timer_reset(mad_timer_t *timer);
+void mad_timer_add(mad_timer_t *timer, mad_timer_t incr);
+
+//! host frame layout, all values little endian
+#define MAD_HOST_HEADER_SIZE    12
+
+//! sample of a host frame, the checks use it to build their expected output
+mad_fixed_t mad_host_sample(unsigned int seed, unsigned int channel, unsigned int index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
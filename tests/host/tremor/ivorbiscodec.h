@@ -0,0 +1,40 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _HOST_IVORBISCODEC_H_
+#define _HOST_IVORBISCODEC_H_
+
+//! host replacement of the tremor types OggDecoder uses, there is no vorbis
+//! decoder behind it, see ogg_host.cpp
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef long long ogg_int64_t;
+
+typedef struct
+{
+    int version;
+    int channels;
+    long rate;
+} vorbis_info;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
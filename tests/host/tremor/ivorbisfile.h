@@ -0,0 +1,51 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#ifndef _HOST_IVORBISFILE_H_
+#define _HOST_IVORBISFILE_H_
+
+#include <stddef.h>
+#include "ivorbiscodec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    size_t (*read_func)(void *ptr, size_t size, size_t nmemb, void *datasource);
+    int (*seek_func)(void *datasource, ogg_int64_t offset, int whence);
+    int (*close_func)(void *datasource);
+    long (*tell_func)(void *datasource);
+} ov_callbacks;
+
+typedef struct
+{
+    void *datasource;
+    ov_callbacks callbacks;
+} OggVorbis_File;
+
+int ov_open_callbacks(void *datasource, OggVorbis_File *vf, const char *initial, long ibytes, ov_callbacks callbacks);
+int ov_clear(OggVorbis_File *vf);
+vorbis_info *ov_info(OggVorbis_File *vf, int link);
+int ov_time_seek(OggVorbis_File *vf, ogg_int64_t ms);
+long ov_read(OggVorbis_File *vf, char *buffer, int length, int *bitstream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
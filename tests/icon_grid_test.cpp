@@ -0,0 +1,145 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+#include "Application.h"
+#include "game/GameList.h"
+#include "resources/Resources.h"
+#include "gui/GuiIconGrid.h"
+#include "system/AsyncDeleter.h"
+#include "system/CProfiler.h"
+
+//! Builds the icon grid for 50, 500 and 5000 titles and slides it from the
+//! first to the last page. Only the pages around the shown and the target page
+//! may hold game buttons, the construction time and the element count must not
+//! grow with the title count as they did when every title got its button.
+
+static const int GRID_WIDTH = 1280;
+static const int GRID_HEIGHT = 720;
+static const int PAGE_SLOTS = 15;
+//! the five hidden navigation buttons and the arrows
+static const u32 FIXED_ELEMENTS = 7;
+
+static void fillGameList(int count)
+{
+    GameList *list = GameList::instance();
+    list->getfilteredList().clear();
+    list->getFullGameList().resize(count);
+
+    for(int i = 0; i < count; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "GAME%04i", i);
+        list->getFullGameList()[i].id = name;
+        list->getFullGameList()[i].name = name;
+        list->getFullGameList()[i].gamepath = std::string("/no/such/folder/") + name;
+    }
+    for(int i = 0; i < count; i++)
+        list->getfilteredList().push_back(&list->getFullGameList()[i]);
+}
+
+//! what the grid built before, a button and an icon for every slot
+static u64 buildEverySlot(int slots, GuiImageData *noIcon)
+{
+    std::vector<GameIcon *> icons(slots);
+    std::vector<GuiButton *> buttons(slots);
+
+    u64 start = CProfiler::getTime();
+    for(int i = 0; i < slots; i++)
+    {
+        icons[i] = new GameIcon("", noIcon);
+        buttons[i] = new GuiButton(noIcon->getWidth(), noIcon->getHeight());
+        buttons[i]->setImage(icons[i]);
+    }
+    u64 ticks = CProfiler::getTime() - start;
+
+    for(int i = 0; i < slots; i++)
+    {
+        delete buttons[i];
+        delete icons[i];
+    }
+    return ticks;
+}
+
+static int runGrid(int titles)
+{
+    fillGameList(titles);
+
+    GuiImageData noIcon(Resources::GetFile("noGameIcon.png"), Resources::GetFileSize("noGameIcon.png"));
+    int pages = (titles + PAGE_SLOTS - 1) / PAGE_SLOTS;
+    //! the shown page with its margin and the target page with its margin
+    u32 maxButtons = 6 * PAGE_SLOTS;
+
+    u64 start = CProfiler::getTime();
+    GuiIconGrid *grid = new GuiIconGrid(GRID_WIDTH, GRID_HEIGHT);
+    u64 buildTicks = CProfiler::getTime() - start;
+
+    u32 startElements = grid->getSize();
+
+    //! jump to the last title and let the grid slide there
+    grid->setSelectedGame(titles - 1);
+
+    u32 peakElements = grid->getSize();
+    int frames = 0;
+    start = CProfiler::getTime();
+    for(; frames < pages * (GRID_WIDTH / 35 + 1) + 1; frames++)
+    {
+        grid->updateEffects();
+        if(grid->getSize() > peakElements)
+            peakElements = grid->getSize();
+
+        //! the released icons are deleted after the frame as in the main loop
+        AsyncDeleter::triggerDeleteProcess();
+    }
+    u64 slideTicks = CProfiler::getTime() - start;
+
+    u32 endElements = grid->getSize();
+    u64 everySlotTicks = buildEverySlot(pages * PAGE_SLOTS, &noIcon);
+
+    start = CProfiler::getTime();
+    delete grid;
+    u64 deleteTicks = CProfiler::getTime() - start;
+
+    printf("%5i titles: build %.1f ms (%.1f ms with a button per slot), delete %.1f ms, slide over %i pages %.1f us per frame\n",
+           titles, CProfiler::ticksToMicroseconds(buildTicks) / 1000.0, CProfiler::ticksToMicroseconds(everySlotTicks) / 1000.0,
+           CProfiler::ticksToMicroseconds(deleteTicks) / 1000.0, pages, CProfiler::ticksToMicroseconds(slideTicks) / (double)frames);
+    printf("             elements %u at start, %u peak, %u at the end (%u with a button per slot)\n",
+           startElements, peakElements, endElements, pages * PAGE_SLOTS + FIXED_ELEMENTS);
+
+    int failed = 0;
+    if(startElements > 2 * PAGE_SLOTS + FIXED_ELEMENTS || peakElements > maxButtons + FIXED_ELEMENTS || endElements > 2 * PAGE_SLOTS + FIXED_ELEMENTS)
+        failed = 1;
+    return failed;
+}
+
+int main(void)
+{
+    //! the game icons scale by the video of the application
+    Application::instance();
+
+    int failed = 0;
+    failed |= runGrid(50);
+    failed |= runGrid(500);
+    failed |= runGrid(5000);
+
+    AsyncDeleter::destroyInstance();
+    GameList::destroyInstance();
+
+    printf("icon grid: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
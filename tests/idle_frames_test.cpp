@@ -0,0 +1,187 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+#include "Application.h"
+#include "game/GameList.h"
+#include "gui/GuiIconCarousel.h"
+#include "gui/GuiIconGrid.h"
+#include "gui/GuiController.h"
+#include "gui/FreeTypeGX.h"
+#include "resources/Resources.h"
+#include "system/AsyncDeleter.h"
+#include "video/CVideo.h"
+#include "gx2_record.h"
+
+//! Replays the frame loop of the application on a browser and counts the frames
+//! that are skipped because nothing changed. The carousel is run once on the DRC,
+//! where update() is called, and once on the TV, where only updateEffects() is
+//! called. Both must turn to a new selection without input and go idle after it.
+//! The icon grid has the moving particles behind it and is never idle.
+
+//! same as in Application.cpp
+static const u32 IDLE_REFRESH_FRAMES = 60;
+static const u32 MAX_FRAMES = 2000;
+
+struct FrameStats
+{
+    u32 frames;
+    u32 skipped;
+    //! last frame drawn for a change, not for the periodic refresh
+    u32 lastChanged;
+};
+
+static void fillGameList(int count)
+{
+    GameList *list = GameList::instance();
+    list->getfilteredList().clear();
+    list->getFullGameList().resize(count);
+
+    for(int i = 0; i < count; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "GAME%04i", i);
+        list->getFullGameList()[i].id = name;
+        list->getFullGameList()[i].name = name;
+        list->getFullGameList()[i].gamepath = std::string("/no/such/folder/") + name;
+    }
+    for(int i = 0; i < count; i++)
+        list->getfilteredList().push_back(&list->getFullGameList()[i]);
+}
+
+//! one pass of the main loop: input, idle check, draw, effects and deleter
+static void runFrames(GuiElement *browser, bool bDrc, u32 count, FrameStats &stats)
+{
+    CVideo *video = Application::instance()->getVideo();
+    //! no button, stick or touch input
+    GuiController controller;
+    u32 idleFrames = 0;
+
+    stats.frames = 0;
+    stats.skipped = 0;
+    stats.lastChanged = 0;
+
+    for(u32 i = 0; i < count; i++)
+    {
+        if(bDrc)
+            browser->update(&controller);
+
+        if(controller.isActive() || GuiElement::checkRedrawRequest())
+            idleFrames = 0;
+        else
+            idleFrames++;
+
+        bool drawFrame = (idleFrames < 2) || ((idleFrames % IDLE_REFRESH_FRAMES) == 0);
+        if(drawFrame)
+            browser->draw(video);
+        else
+            stats.skipped++;
+
+        if(idleFrames < 2)
+            stats.lastChanged = i;
+
+
+        browser->updateEffects();
+        AsyncDeleter::triggerDeleteProcess();
+        stats.frames++;
+
+        //! the background of the new selection is loaded by a thread in the meantime
+        usleep(100);
+    }
+}
+
+static int runCarousel(int titles, bool bDrc)
+{
+    fillGameList(titles);
+
+    CVideo *video = Application::instance()->getVideo();
+    GuiIconCarousel *carousel = new GuiIconCarousel(video->getTvWidth(), video->getTvHeight());
+    const char *screen = bDrc ? "DRC" : "TV ";
+
+    FrameStats stats;
+    //! let the start up settle
+    runFrames(carousel, bDrc, MAX_FRAMES / 4, stats);
+
+    FrameStats rest;
+    runFrames(carousel, bDrc, 2 * IDLE_REFRESH_FRAMES, rest);
+
+    //! a selection made by the other screen, no input reaches this one
+    carousel->setSelectedGame(titles / 2);
+
+    FrameStats turn;
+    runFrames(carousel, bDrc, MAX_FRAMES / 2, turn);
+
+    u32 turnFrames = turn.frames - turn.skipped;
+    printf("carousel %s %4i titles: %3u of %3u frames skipped at rest, %3u frames drawn to turn, last change at %u, %4u of %4u skipped after it, visited %s\n",
+           screen, titles, rest.skipped, rest.frames, turnFrames, turn.lastChanged,
+           turn.skipped, turn.frames, carousel->isEffectUpdateRequired() ? "yes" : "no");
+
+    int failed = 0;
+    //! at rest only the first frame and the periodic refresh are drawn
+    if(rest.frames - rest.skipped > 1 + rest.frames / IDLE_REFRESH_FRAMES)
+        failed = 1;
+    //! the turn has to be drawn, then the carousel must go idle and stop being visited
+    if(turnFrames < 10 || turn.lastChanged >= turn.frames / 2 || carousel->isEffectUpdateRequired())
+        failed = 1;
+
+    delete carousel;
+    AsyncDeleter::triggerDeleteProcess();
+    return failed;
+}
+
+static int runGrid(int titles)
+{
+    fillGameList(titles);
+
+    CVideo *video = Application::instance()->getVideo();
+    GuiIconGrid *grid = new GuiIconGrid(video->getTvWidth(), video->getTvHeight());
+
+    FrameStats stats;
+    runFrames(grid, true, 2 * IDLE_REFRESH_FRAMES, stats);
+
+    printf("icon grid     %4i titles: %3u of %3u frames skipped with the particles moving\n",
+           titles, stats.skipped, stats.frames);
+
+    delete grid;
+    AsyncDeleter::triggerDeleteProcess();
+
+    //! the particles move on every frame, the screen is never idle
+    return (stats.skipped != 0) ? 1 : 0;
+}
+
+int main(void)
+{
+    //! the game icons scale by the video of the application
+    Application::instance();
+
+    //! the game title is drawn with the preset font
+    FreeTypeGX *font = new FreeTypeGX(Resources::GetFile("font.ttf"), Resources::GetFileSize("font.ttf"));
+    GuiText::setPresetFont(font);
+
+    int failed = 0;
+    failed |= runCarousel(100, true);
+    failed |= runCarousel(100, false);
+    failed |= runGrid(100);
+
+    AsyncDeleter::destroyInstance();
+    GameList::destroyInstance();
+    delete font;
+
+    printf("idle frames: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
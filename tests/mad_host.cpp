@@ -0,0 +1,141 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <string.h>
+#include <mad.h>
+
+//! A host frame starts with
+//!   0xFF 0xFB         sync word of an MPEG layer III frame
+//!   u8  channels      1 or 2
+//!   u8  reserved
+//!   u16 length        samples per channel, at most 1152
+//!   u16 payload       bytes that follow the header
+//!   u32 seed          of the samples returned by mad_synth_frame()
+//! The payload is skipped, it only gives frames a size like compressed audio.
+
+static unsigned int readLE(unsigned char const *ptr, int bytes)
+{
+    unsigned int value = 0;
+    for(int i = bytes - 1; i >= 0; i--)
+        value = (value << 8) | ptr[i];
+    return value;
+}
+
+mad_fixed_t mad_host_sample(unsigned int seed, unsigned int channel, unsigned int index)
+{
+    //! the clipping limits and the values right next to them
+    static const mad_fixed_t edges[] =
+    {
+        MAD_F_ONE, MAD_F_ONE - 1, -MAD_F_ONE, -MAD_F_ONE + 1, 0, -1,
+        (mad_fixed_t)0x7FFFFFFF, (mad_fixed_t)0x80000000
+    };
+
+    unsigned int x = seed * 2654435761u ^ (channel * 1152 + index + 1) * 2246822519u;
+    x ^= x >> 15;
+    x *= 2654435761u;
+    x ^= x >> 13;
+
+    if((x & 0xFF) < sizeof(edges) / sizeof(edges[0]))
+        return edges[x & 0xFF];
+
+    //! up to twice full scale so that clipping is hit often
+    return ((mad_fixed_t)x) >> 2;
+}
+
+void mad_stream_init(struct mad_stream *stream)
+{
+    memset(stream, 0, sizeof(struct mad_stream));
+}
+
+void mad_stream_finish(struct mad_stream *stream)
+{
+}
+
+void mad_stream_buffer(struct mad_stream *stream, unsigned char const *buffer, unsigned long length)
+{
+    stream->buffer = buffer;
+    stream->bufend = buffer + length;
+    stream->this_frame = buffer;
+    stream->next_frame = buffer;
+    stream->error = MAD_ERROR_NONE;
+}
+
+void mad_frame_init(struct mad_frame *frame)
+{
+    memset(frame, 0, sizeof(struct mad_frame));
+}
+
+void mad_frame_finish(struct mad_frame *frame)
+{
+}
+
+int mad_frame_decode(struct mad_frame *frame, struct mad_stream *stream)
+{
+    unsigned char const *ptr = stream->next_frame;
+    unsigned long remaining = stream->bufend - ptr;
+
+    //! like libmad, a frame that does not fit completely asks for more data
+    if(remaining < MAD_HOST_HEADER_SIZE || ptr[0] != 0xFF || ptr[1] != 0xFB ||
+       remaining < MAD_HOST_HEADER_SIZE + readLE(ptr + 6, 2))
+    {
+        stream->error = MAD_ERROR_BUFLEN;
+        return -1;
+    }
+
+    frame->header.mode = (ptr[2] == 2) ? MAD_MODE_STEREO : MAD_MODE_SINGLE_CHANNEL;
+    frame->header.samplerate = 48000;
+    frame->header.duration.seconds = 0;
+    frame->header.duration.fraction = 0;
+    frame->length = readLE(ptr + 4, 2);
+    frame->seed = readLE(ptr + 8, 4);
+
+    stream->this_frame = ptr;
+    stream->next_frame = ptr + MAD_HOST_HEADER_SIZE + readLE(ptr + 6, 2);
+    stream->error = MAD_ERROR_NONE;
+    return 0;
+}
+
+void mad_synth_init(struct mad_synth *synth)
+{
+    memset(synth, 0, sizeof(struct mad_synth));
+}
+
+void mad_synth_frame(struct mad_synth *synth, struct mad_frame const *frame)
+{
+    unsigned int channels = MAD_NCHANNELS(&frame->header);
+
+    synth->pcm.samplerate = frame->header.samplerate;
+    synth->pcm.channels = channels;
+    synth->pcm.length = frame->length;
+
+    for(unsigned int ch = 0; ch < channels; ch++)
+    {
+        for(unsigned int i = 0; i < frame->length; i++)
+            synth->pcm.samples[ch][i] = mad_host_sample(frame->seed, ch, i);
+    }
+}
+
+void mad_timer_reset(mad_timer_t *timer)
+{
+    timer->seconds = 0;
+    timer->fraction = 0;
+}
+
+void mad_timer_add(mad_timer_t *timer, mad_timer_t incr)
+{
+    timer->seconds += incr.seconds;
+    timer->fraction += incr.fraction;
+}
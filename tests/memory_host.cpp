@@ -0,0 +1,53 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <malloc.h>
+#include "system/memory.h"
+
+//! the console heaps are all backed by the host heap
+extern "C" {
+
+void * MEM2_alloc(unsigned int size, unsigned int align)
+{
+    return memalign(align, size);
+}
+
+void MEM2_free(void *ptr)
+{
+    free(ptr);
+}
+
+void * MEM1_alloc(unsigned int size, unsigned int align)
+{
+    return memalign(align, size);
+}
+
+void MEM1_free(void *ptr)
+{
+    free(ptr);
+}
+
+void * MEMBucket_alloc(unsigned int size, unsigned int align)
+{
+    return memalign(align, size);
+}
+
+void MEMBucket_free(void *ptr)
+{
+    free(ptr);
+}
+
+}
@@ -0,0 +1,203 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <limits.h>
+#include <vector>
+#include <mad.h>
+#include "sounds/Mp3Decoder.hpp"
+
+//! Decodes host frames (see mad_host.cpp) with Mp3Decoder::Read() and ReadPlanar()
+//! and compares every sample with the per sample conversion the decoder used
+//! before the block conversion. The stream is longer than the read buffer, so
+//! frames are split at the refill, and a stereo stream has mono frames in it.
+
+struct HostFrame
+{
+    u8 channels;
+    u16 length;
+    u16 payload;
+    u32 seed;
+};
+
+//! the conversion before the block conversion, one sample per call
+static s16 OldFixedToShort(mad_fixed_t Fixed)
+{
+    if(Fixed>=MAD_F_ONE)
+        return(SHRT_MAX);
+    if(Fixed<=-MAD_F_ONE)
+        return(-SHRT_MAX);
+
+    Fixed=Fixed>>(MAD_F_FRACBITS-15);
+    return((s16)Fixed);
+}
+
+//! the block conversion clamps symmetric, the old one gave -32768 just above -MAD_F_ONE
+static s16 Expected(mad_fixed_t Fixed)
+{
+    s16 sample = OldFixedToShort(Fixed);
+    return (sample == SHRT_MIN) ? -SHRT_MAX : sample;
+}
+
+static std::vector<HostFrame> makeFrames(u32 count, bool stereo)
+{
+    std::vector<HostFrame> frames(count);
+
+    for(u32 i = 0; i < count; i++)
+    {
+        frames[i].channels = (stereo && (i == 0 || i % 7 != 0)) ? 2 : 1;
+        frames[i].length = (i % 11 == 5) ? 576 : ((i % 13 == 3) ? 97 : 1152);
+        frames[i].payload = 900 + (i * 37) % 256;
+        frames[i].seed = i + 1;
+    }
+    return frames;
+}
+
+static std::vector<u8> makeStream(const std::vector<HostFrame> &frames)
+{
+    std::vector<u8> stream;
+
+    for(u32 i = 0; i < frames.size(); i++)
+    {
+        const HostFrame &f = frames[i];
+        u8 header[MAD_HOST_HEADER_SIZE] =
+        {
+            0xFF, 0xFB, f.channels, 0,
+            (u8)f.length, (u8)(f.length >> 8),
+            (u8)f.payload, (u8)(f.payload >> 8),
+            (u8)f.seed, (u8)(f.seed >> 8), (u8)(f.seed >> 16), (u8)(f.seed >> 24)
+        };
+        stream.insert(stream.end(), header, header + MAD_HOST_HEADER_SIZE);
+        stream.insert(stream.end(), f.payload, (u8)i);
+    }
+    return stream;
+}
+
+//! left and right of every frame, mono frames on both channels
+static void makeExpected(const std::vector<HostFrame> &frames, std::vector<s16> &left, std::vector<s16> &right)
+{
+    for(u32 i = 0; i < frames.size(); i++)
+    {
+        for(u32 n = 0; n < frames[i].length; n++)
+        {
+            left.push_back(Expected(mad_host_sample(frames[i].seed, 0, n)));
+            right.push_back(Expected(mad_host_sample(frames[i].seed, frames[i].channels - 1, n)));
+        }
+    }
+}
+
+static u32 compare(const char *name, const std::vector<s16> &result, const std::vector<s16> &expected)
+{
+    u32 errors = (result.size() != expected.size()) ? 1 : 0;
+
+    for(u32 i = 0; i < result.size() && i < expected.size(); i++)
+    {
+        if(result[i] != expected[i])
+            errors++;
+    }
+
+    printf("%s: %u of %u samples, %u errors\n", name, (u32)result.size(), (u32)expected.size(), errors);
+    return errors;
+}
+
+//! output sizes that end runs inside a frame and at odd places
+static const int readSizes[] = { 4096, 37, 1, 2304, 4608, 1000, 9000 };
+static const u32 readSizeCount = sizeof(readSizes) / sizeof(readSizes[0]);
+
+static u32 checkStereo(void)
+{
+    std::vector<HostFrame> frames = makeFrames(300, true);
+    std::vector<u8> stream = makeStream(frames);
+    std::vector<s16> left, right;
+    makeExpected(frames, left, right);
+
+    Mp3Decoder decoder(&stream[0], stream.size());
+    if(!decoder.IsStereo() || !decoder.Is16Bit())
+    {
+        printf("stereo stream: wrong format %04X\n", decoder.GetFormat());
+        return 1;
+    }
+
+    std::vector<s16> interleaved, expected;
+    std::vector<s16> buffer(2 * 9000);
+    for(u32 i = 0; i < left.size(); i++)
+    {
+        expected.push_back(left[i]);
+        expected.push_back(right[i]);
+    }
+
+    for(u32 n = 0; ; n++)
+    {
+        int ret = decoder.Read((u8*)&buffer[0], readSizes[n % readSizeCount] * 4, 0);
+        if(ret <= 0)
+            break;
+        interleaved.insert(interleaved.end(), &buffer[0], &buffer[0] + ret / 2);
+    }
+    u32 errors = compare("stereo Read", interleaved, expected);
+
+    std::vector<s16> planarLeft, planarRight;
+    std::vector<s16> bufferRight(9000);
+    decoder.Rewind();
+
+    for(u32 n = 0; ; n++)
+    {
+        int ret = decoder.ReadPlanar(&buffer[0], &bufferRight[0], readSizes[n % readSizeCount]);
+        if(ret <= 0)
+            break;
+        planarLeft.insert(planarLeft.end(), &buffer[0], &buffer[0] + ret);
+        planarRight.insert(planarRight.end(), &bufferRight[0], &bufferRight[0] + ret);
+    }
+    errors += compare("stereo ReadPlanar left", planarLeft, left);
+    errors += compare("stereo ReadPlanar right", planarRight, right);
+
+    return errors;
+}
+
+static u32 checkMono(void)
+{
+    std::vector<HostFrame> frames = makeFrames(300, false);
+    std::vector<u8> stream = makeStream(frames);
+    std::vector<s16> left, right;
+    makeExpected(frames, left, right);
+
+    Mp3Decoder decoder(&stream[0], stream.size());
+    if(decoder.IsStereo() || !decoder.Is16Bit())
+    {
+        printf("mono stream: wrong format %04X\n", decoder.GetFormat());
+        return 1;
+    }
+
+    std::vector<s16> mono;
+    std::vector<s16> buffer(9000);
+
+    for(u32 n = 0; ; n++)
+    {
+        int ret = decoder.Read((u8*)&buffer[0], readSizes[n % readSizeCount] * 2, 0);
+        if(ret <= 0)
+            break;
+        mono.insert(mono.end(), &buffer[0], &buffer[0] + ret / 2);
+    }
+
+    return compare("mono Read", mono, left);
+}
+
+int main(void)
+{
+    u32 errors = checkStereo() + checkMono();
+
+    printf("mp3 fixed: %s\n", errors ? "FAILED" : "ok");
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,47 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <string.h>
+#include <tremor/ivorbisfile.h>
+
+//! The host has no vorbis decoder. Opening fails, so an OggDecoder ends up
+//! without a file like one of a broken stream and SoundHandler can be linked.
+
+int ov_open_callbacks(void *datasource, OggVorbis_File *vf, const char *initial, long ibytes, ov_callbacks callbacks)
+{
+    memset(vf, 0, sizeof(OggVorbis_File));
+    return -1;
+}
+
+int ov_clear(OggVorbis_File *vf)
+{
+    return 0;
+}
+
+vorbis_info *ov_info(OggVorbis_File *vf, int link)
+{
+    return NULL;
+}
+
+int ov_time_seek(OggVorbis_File *vf, ogg_int64_t ms)
+{
+    return -1;
+}
+
+long ov_read(OggVorbis_File *vf, char *buffer, int length, int *bitstream)
+{
+    return -1;
+}
@@ -0,0 +1,131 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <new>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include "dynamic_libs/os_functions.h"
+
+//! coreinit calls used by CMutex, the sound decoders and SoundHandler, backed by the host
+
+static_assert(sizeof(std::mutex) <= OS_MUTEX_SIZE, "CMutex allocates OS_MUTEX_SIZE bytes");
+
+static void hostInitMutex(void* mutex)
+{
+    new (mutex) std::mutex();
+}
+
+static void hostLockMutex(void* mutex)
+{
+    ((std::mutex*)mutex)->lock();
+}
+
+static void hostUnlockMutex(void* mutex)
+{
+    ((std::mutex*)mutex)->unlock();
+}
+
+static int hostTryLockMutex(void* mutex)
+{
+    return ((std::mutex*)mutex)->try_lock() ? 1 : 0;
+}
+
+static void hostSleepTicks(u64 ticks)
+{
+    std::this_thread::yield();
+}
+
+static void hostFlushRange(const void *addr, u32 length)
+{
+}
+
+//! the queue does not fit into OS_MESSAGE_QUEUE_SIZE bytes, only a pointer to
+//! it is kept there. coreinit has no call to destroy a queue, so it is leaked.
+typedef struct
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<OSMessage> messages;
+    u32 count;
+} HostMessageQueue;
+
+static HostMessageQueue * getQueue(void *queue)
+{
+    return *(HostMessageQueue **)queue;
+}
+
+static void hostInitMessageQueue(void *queue, OSMessage *messages, s32 count)
+{
+    HostMessageQueue *q = new HostMessageQueue();
+    q->count = count;
+    *(HostMessageQueue **)queue = q;
+}
+
+static int hostSendMessage(void *queue, OSMessage *message, s32 flags)
+{
+    HostMessageQueue *q = getQueue(queue);
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if(q->messages.size() >= q->count)
+    {
+        if(!(flags & OS_MESSAGE_BLOCK))
+            return 0;
+        q->changed.wait(lock, [q] { return q->messages.size() < q->count; });
+    }
+
+    q->messages.push_back(*message);
+    q->changed.notify_all();
+    return 1;
+}
+
+static int hostReceiveMessage(void *queue, OSMessage *message, s32 flags)
+{
+    HostMessageQueue *q = getQueue(queue);
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if(q->messages.empty())
+    {
+        if(!(flags & OS_MESSAGE_BLOCK))
+            return 0;
+        q->changed.wait(lock, [q] { return !q->messages.empty(); });
+    }
+
+    *message = q->messages.front();
+    q->messages.pop_front();
+    q->changed.notify_all();
+    return 1;
+}
+
+//! timer ticks at the bus speed of the console, counted from the first call
+//! so that the conversion does not overflow
+static s64 hostGetTime(void)
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    u64 us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    return (s64)MICROSECS_TO_TICKS(us);
+}
+
+void (* OSInitMutex)(void* mutex) = hostInitMutex;
+void (* OSLockMutex)(void* mutex) = hostLockMutex;
+void (* OSUnlockMutex)(void* mutex) = hostUnlockMutex;
+int (* OSTryLockMutex)(void* mutex) = hostTryLockMutex;
+void (* OSSleepTicks)(u64 ticks) = hostSleepTicks;
+void (* DCFlushRange)(const void *addr, u32 length) = hostFlushRange;
+void (* OSInitMessageQueue)(void *queue, OSMessage *messages, s32 count) = hostInitMessageQueue;
+int (* OSSendMessage)(void *queue, OSMessage *message, s32 flags) = hostSendMessage;
+int (* OSReceiveMessage)(void *queue, OSMessage *message, s32 flags) = hostReceiveMessage;
+s64 (* OSGetTime)(void) = hostGetTime;
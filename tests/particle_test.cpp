@@ -0,0 +1,76 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "gui/GuiParticleImage.h"
+#include "video/CVideo.h"
+#include "system/CProfiler.h"
+#include "gx2_record.h"
+
+//! Moves and draws the background particles through the stubbed GX2 layer.
+//! All particles have to go out with one draw, however many there are, and the
+//! update and the vertex fill of 10k particles are timed per frame.
+
+static const u32 FRAMES = 100;
+
+static int runParticles(u32 count)
+{
+    CVideo video;
+    GuiParticleImage particles(video.getTvWidth(), video.getTvHeight(), count);
+
+    //! the first draw fills the vertex buffer
+    particles.draw(&video);
+
+    u64 updateTicks = 0, drawTicks = 0;
+    u32 draws = 0, vertices = 0;
+
+    for(u32 frame = 0; frame < FRAMES; frame++)
+    {
+        u64 start = CProfiler::getTime();
+        particles.updateEffects();
+        updateTicks += CProfiler::getTime() - start;
+
+        GX2Record::reset();
+        start = CProfiler::getTime();
+        particles.draw(&video);
+        drawTicks += CProfiler::getTime() - start;
+
+        draws += GX2Record::get(GX2Record::CALL_DRAW);
+        vertices += GX2Record::get(GX2Record::CALL_VERTICES);
+        video.waitForVSync();
+    }
+
+    printf("%5u particles: %.1f draws and %u vertices per frame, update %.1f us, vertex fill and draw %.1f us\n",
+           count, draws / (double)FRAMES, vertices / FRAMES,
+           CProfiler::ticksToMicroseconds(updateTicks) / (double)FRAMES, CProfiler::ticksToMicroseconds(drawTicks) / (double)FRAMES);
+
+    return (draws != FRAMES) ? 1 : 0;
+}
+
+int main(void)
+{
+    srand(1);
+
+    int failed = 0;
+    //! the icon grid uses 50 and the carousel 100
+    failed |= runParticles(50);
+    failed |= runParticles(100);
+    failed |= runParticles(10000);
+
+    printf("particles: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
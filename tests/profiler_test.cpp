@@ -0,0 +1,120 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include "system/CProfiler.h"
+
+//! Replays a synthetic main loop with a fixed amount of work in every phase,
+//! alternating blocks of frames with the profiler disabled and enabled. The
+//! difference is the overhead of the timing markers, the counters and the ring
+//! buffer. It is below the noise of the host, so the phase markers alone are
+//! timed in a tight loop as well.
+
+static const int BLOCK_FRAMES = 100;
+static const int BLOCKS = 20;
+static const int DRAWS_PER_FRAME = 40;
+static const int MARKER_PAIRS = 1000000;
+
+static volatile f32 sink = 0.0f;
+
+static void work(int amount)
+{
+    f32 value = sink;
+    for(int i = 0; i < amount * 5000; i++)
+        value = value * 0.999f + 1.0f;
+    sink = value;
+}
+
+static void runFrame(CProfiler *profiler)
+{
+    profiler->beginFrame();
+
+    for(int phase = 0; phase < CProfiler::PHASE_COUNT; phase++)
+    {
+        CProfilerScope scope(phase);
+        work(phase + 1);
+
+        if(phase == CProfiler::PHASE_DRAW_DRC || phase == CProfiler::PHASE_DRAW_TV)
+            profiler->count(CProfiler::COUNTER_DRAWS, DRAWS_PER_FRAME / 2);
+    }
+}
+
+static u64 runBlock(CProfiler *profiler, bool bEnabled)
+{
+    profiler->setEnabled(bEnabled);
+
+    u64 start = CProfiler::getTime();
+    for(int frame = 0; frame < BLOCK_FRAMES; frame++)
+        runFrame(profiler);
+    return CProfiler::getTime() - start;
+}
+
+int main(void)
+{
+    CProfiler *profiler = CProfiler::instance();
+
+    u64 disabledTicks = 0, enabledTicks = 0;
+    for(int block = 0; block < BLOCKS; block++)
+    {
+        disabledTicks += runBlock(profiler, false);
+        enabledTicks += runBlock(profiler, true);
+    }
+
+    int frames = BLOCKS * BLOCK_FRAMES;
+    double disabledUs = CProfiler::ticksToMicroseconds(disabledTicks) / (double)frames;
+    double enabledUs = CProfiler::ticksToMicroseconds(enabledTicks) / (double)frames;
+
+    printf("profiler replay of %i frames: %.1f us per frame disabled, %.1f us enabled, overhead %.2f us (%.2f%%)\n",
+           frames, disabledUs, enabledUs, enabledUs - disabledUs, 100.0 * (enabledUs - disabledUs) / disabledUs);
+
+    //! the ring buffer holds the last block
+    char summary[512];
+    profiler->getSummary(summary, sizeof(summary));
+    printf("profiler summary: %s\n", summary);
+
+    int failed = 0;
+    if(profiler->getCounterAverage(CProfiler::COUNTER_DRAWS) != DRAWS_PER_FRAME || profiler->getFrameAverage() == 0)
+        failed = 1;
+
+    //! the last phase does eight times the work of the first, the phases in
+    //! between are too close to each other to order them on a busy host
+    u32 phaseSum = 0;
+    for(int phase = 0; phase < CProfiler::PHASE_COUNT; phase++)
+        phaseSum += profiler->getAverage(phase);
+
+    if(profiler->getAverage(CProfiler::PHASE_DELETER) <= profiler->getAverage(CProfiler::PHASE_INPUT)
+       || phaseSum > profiler->getFrameAverage() + CProfiler::PHASE_COUNT)
+        failed = 1;
+
+    u64 start = CProfiler::getTime();
+    for(int i = 0; i < MARKER_PAIRS; i++)
+    {
+        profiler->beginPhase(CProfiler::PHASE_EFFECTS);
+        profiler->endPhase(CProfiler::PHASE_EFFECTS);
+    }
+    double pairNs = CProfiler::ticksToMicroseconds(CProfiler::getTime() - start) * 1000.0 / MARKER_PAIRS;
+    printf("profiler markers: %.1f ns per begin and end pair, %.2f us for the %i phases of a frame\n",
+           pairNs, pairNs * CProfiler::PHASE_COUNT / 1000.0, CProfiler::PHASE_COUNT);
+
+    //! a marker pair has to stay far below a microsecond
+    if(pairNs > 1000.0)
+        failed = 1;
+
+    CProfiler::destroyInstance();
+
+    printf("profiler: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
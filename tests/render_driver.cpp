@@ -0,0 +1,275 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gx2_record.h"
+#include "video/RenderState.h"
+#include "video/SpriteBatch.h"
+#include "video/shaders/Texture2DShader.h"
+#include "video/shaders/ColorShader.h"
+#include "system/CProfiler.h"
+
+//! Runs the render layer headless for a number of frames and prints the GX2 calls
+//! per frame. The scenes follow GuiImage::draw() for two screens. The game list
+//! is a background, one page of icons with a shared texture, a color rectangle
+//! per row that breaks the batch and a rotated cursor that has to be drawn
+//! directly. The settings screen has one button per category with a shared
+//! background and button texture but its own icon and glow.
+//!
+//! Both screens are then drawn once without the state tracker, once with it and
+//! once with batching on top, and the draws, binds and skipped binds are printed.
+
+static const int ICON_COLS = 5;
+static const int ICON_ROWS = 3;
+static const int SETTINGS_CATEGORIES = 4;
+
+enum eTexture
+{
+    TEXTURE_BG = 0,
+    TEXTURE_ICON,
+    TEXTURE_CURSOR,
+    TEXTURE_QUIT,
+    TEXTURE_CATEGORY_BG,
+    TEXTURE_CATEGORY_BUTTON,
+    TEXTURE_ARROW_LEFT,
+    TEXTURE_ARROW_RIGHT,
+    TEXTURE_CATEGORY_ICON,
+    TEXTURE_CATEGORY_GLOW = TEXTURE_CATEGORY_ICON + SETTINGS_CATEGORIES,
+    TEXTURE_COUNT = TEXTURE_CATEGORY_GLOW + SETTINGS_CATEGORIES
+};
+
+enum eMode
+{
+    //! every element binds its whole state, as before the state tracker
+    MODE_UNTRACKED = 0,
+    //! identical binds are skipped by RenderState
+    MODE_TRACKED,
+    //! quads of the same texture are drawn together by SpriteBatch
+    MODE_BATCHED,
+    MODE_COUNT
+};
+
+static const char *modeNames[MODE_COUNT] =
+{
+    "untracked",
+    "tracked",
+    "batched"
+};
+
+static GX2Texture textures[TEXTURE_COUNT];
+static GX2Sampler sampler;
+static u8 textureData[TEXTURE_COUNT][16];
+static u8 colorVtxs[ColorShader::cuColorVtxsSize];
+static int renderMode = MODE_BATCHED;
+
+static void initTexture(GX2Texture *texture, void *data)
+{
+    memset(texture, 0, sizeof(GX2Texture));
+    texture->surface.image_data = data;
+}
+
+//! same calls as GuiImage::draw() for a quad that can not be batched
+static void drawDirect(const GX2Texture *texture, f32 angle)
+{
+    if(renderMode == MODE_UNTRACKED)
+        RenderState::invalidate();
+
+    Texture2DShader::instance()->setShaders();
+    Texture2DShader::instance()->setAttributeBuffer();
+    Texture2DShader::instance()->setAngle(angle);
+    Texture2DShader::instance()->setOffset(glm::vec3(0.0f));
+    Texture2DShader::instance()->setScale(glm::vec3(0.1f));
+    Texture2DShader::instance()->setColorIntensity(glm::vec4(1.0f));
+    Texture2DShader::instance()->setBlurring(glm::vec3(0.0f));
+    Texture2DShader::instance()->setTextureAndSampler(texture, &sampler);
+    Texture2DShader::instance()->draw();
+}
+
+static void drawColor(void)
+{
+    if(renderMode == MODE_UNTRACKED)
+        RenderState::invalidate();
+
+    ColorShader::instance()->setShaders();
+    ColorShader::instance()->setAttributeBuffer(colorVtxs);
+    ColorShader::instance()->setAngle(0.0f);
+    ColorShader::instance()->setOffset(glm::vec3(0.0f));
+    ColorShader::instance()->setScale(glm::vec3(1.0f, 0.01f, 1.0f));
+    ColorShader::instance()->setColorIntensity(glm::vec4(1.0f));
+    ColorShader::instance()->draw();
+}
+
+static void drawQuad(int texture, f32 x, f32 y)
+{
+    if(renderMode == MODE_BATCHED && SpriteBatch::addQuad(&textures[texture], &sampler, glm::vec3(x, y, 0.0f), glm::vec3(0.1f), glm::vec4(1.0f), glm::vec3(0.0f)))
+        return;
+
+    drawDirect(&textures[texture], 0.0f);
+}
+
+static void drawGameList(void)
+{
+    drawQuad(TEXTURE_BG, 0.0f, 0.0f);
+
+    for(int row = 0; row < ICON_ROWS; row++)
+    {
+        for(int col = 0; col < ICON_COLS; col++)
+            drawQuad(TEXTURE_ICON, -0.8f + col * 0.4f, 0.6f - row * 0.6f);
+
+        drawColor();
+    }
+
+    drawDirect(&textures[TEXTURE_CURSOR], 45.0f);
+}
+
+//! element order of the category frame of SettingsMenu
+static void drawSettings(void)
+{
+    drawQuad(TEXTURE_QUIT, -0.9f, 0.9f);
+
+    for(int i = 0; i < SETTINGS_CATEGORIES; i++)
+    {
+        f32 x = -0.6f + i * 0.4f;
+        drawQuad(TEXTURE_CATEGORY_BG, x, 0.0f);
+        drawQuad(TEXTURE_CATEGORY_BUTTON, x, 0.0f);
+        drawQuad(TEXTURE_CATEGORY_ICON + i, x, 0.1f);
+        drawQuad(TEXTURE_CATEGORY_GLOW + i, x, 0.1f);
+    }
+
+    //! the small icons of the page selection below
+    for(int i = 0; i < SETTINGS_CATEGORIES; i++)
+        drawQuad(TEXTURE_CATEGORY_ICON + i, -0.3f + i * 0.2f, -0.8f);
+
+    drawQuad(TEXTURE_ARROW_LEFT, -0.9f, 0.0f);
+    drawQuad(TEXTURE_ARROW_RIGHT, 0.9f, 0.0f);
+}
+
+static void drawFrame(void (*drawScene)(void))
+{
+    //! a loaded context state overwrites everything that was bound
+    RenderState::invalidate();
+
+    drawScene();
+
+    SpriteBatch::nextFrame();
+}
+
+static u32 getBinds(void)
+{
+    u32 binds = 0;
+    for(int i = GX2Record::CALL_FETCH_SHADER; i <= GX2Record::CALL_SAMPLER; i++)
+        binds += GX2Record::get(i);
+    return binds;
+}
+
+//! draws one frame of a scene in every mode
+//!\return 0 if the tracker and the batching did not make it worse
+static int compareModes(const char *name, void (*drawScene)(void))
+{
+    u32 draws[MODE_COUNT];
+    u32 binds[MODE_COUNT];
+
+    for(int mode = 0; mode < MODE_COUNT; mode++)
+    {
+        renderMode = mode;
+
+        //! restart the ring so it holds just this frame
+        CProfiler::instance()->setEnabled(false);
+        CProfiler::instance()->setEnabled(true);
+        CProfiler::instance()->beginFrame();
+
+        GX2Record::reset();
+        drawFrame(drawScene);
+        CProfiler::instance()->beginFrame();
+
+        draws[mode] = GX2Record::get(GX2Record::CALL_DRAW);
+        binds[mode] = getBinds();
+
+        printf("%-9s | %-9s | %5u | %5u | %7u\n", name, modeNames[mode], draws[mode], binds[mode],
+               CProfiler::instance()->getCounterTotal(CProfiler::COUNTER_SKIPPED));
+    }
+
+    renderMode = MODE_BATCHED;
+
+    if(binds[MODE_TRACKED] > binds[MODE_UNTRACKED] || draws[MODE_BATCHED] > draws[MODE_TRACKED])
+        return 1;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int frames = (argc > 1) ? atoi(argv[1]) : 3;
+
+    for(int i = 0; i < TEXTURE_COUNT; i++)
+        initTexture(&textures[i], textureData[i]);
+    memset(&sampler, 0, sizeof(sampler));
+    memset(colorVtxs, 0xff, sizeof(colorVtxs));
+
+    CProfiler::instance()->setEnabled(true);
+
+    //! shader creation is not part of a frame
+    Texture2DShader::instance();
+    ColorShader::instance();
+
+    printf("frame");
+    for(int i = 0; i < GX2Record::CALL_COUNT; i++)
+        printf(" | %s", GX2Record::getName(i));
+    printf("\n");
+
+    u32 draws = 0;
+    CProfiler::instance()->beginFrame();
+
+    for(int frame = 0; frame < frames; frame++)
+    {
+        GX2Record::reset();
+
+        drawFrame(drawGameList);
+
+        //! the profiler stores the counts of a frame when the next one begins
+        CProfiler::instance()->beginFrame();
+
+        printf("%5d", frame);
+        for(int i = 0; i < GX2Record::CALL_COUNT; i++)
+            printf(" | %u", GX2Record::get(i));
+        printf("\n");
+
+        draws = GX2Record::get(GX2Record::CALL_DRAW);
+    }
+
+    //! every frame is the same, the draws counted by the wrappers have to match the issued ones
+    u32 profilerDraws = CProfiler::instance()->getCounterAverage(CProfiler::COUNTER_DRAWS);
+    printf("profiler draws per frame: %u\n", profilerDraws);
+
+    int failed = 0;
+    if(frames > 0 && profilerDraws != draws)
+    {
+        printf("profiler counted %u draws, %u were issued\n", profilerDraws, draws);
+        failed = 1;
+    }
+
+    printf("screen    | mode      | draws | binds | skipped\n");
+    failed |= compareModes("game list", drawGameList);
+    failed |= compareModes("settings", drawSettings);
+
+    SpriteBatch::destroy();
+    Texture2DShader::destroyInstance();
+    ColorShader::destroyInstance();
+    CProfiler::destroyInstance();
+
+    return failed;
+}
@@ -0,0 +1,163 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include "sounds/SoundDecoder.hpp"
+
+//! Feeds sines through SoundDecoder::Resample() in decoder sized blocks and
+//! measures the signal to noise ratio of the 48 kHz output. The sine of each
+//! channel is fitted by least squares at its known frequency, so the delay of
+//! the filter does not matter, everything that remains counts as noise.
+
+//! the floor only catches a broken filter or lost blocks, the measured values
+//! are printed to compare changes of the filter
+static const double MIN_SNR_DB = 60.0;
+
+class ResampleProbe : public SoundDecoder
+{
+public:
+    ResampleProbe(u16 rate, bool stereo, int resize) {
+        Format = FORMAT_PCM_16_BIT | (stereo ? CHANNELS_STEREO : CHANNELS_MONO);
+        SampleRate = rate;
+        EnableUpsample();
+        //! like the music decoders, but after the resampler was set up
+        if(resize)
+            SetBufferBlocks(SoundBlocks, resize);
+        blockSize = SoundBuffer.GetBufferBlockSize();
+    }
+
+    bool isEnabled(void) const { return ResampleBuffer != NULL; }
+    int getReadSize(void) const { return SoundBlockSize; }
+    int getBlockSize(void) const { return blockSize; }
+
+    int resample(u8 *buffer, int size) {
+        return Resample(buffer, size);
+    }
+private:
+    int blockSize;
+};
+
+//! power of the best fitting sine of frequency freq against the residual in dB
+static double measureSnr(const std::vector<s16> &samples, u32 channels, u32 ch, double freq, u32 skip)
+{
+    double ss = 0.0, sc = 0.0, cc = 0.0, ys = 0.0, yc = 0.0;
+    u32 frames = samples.size() / channels;
+
+    for(u32 i = skip; i < frames; i++)
+    {
+        double w = 2.0 * M_PI * freq * i / 48000.0;
+        double s = sin(w), c = cos(w);
+        double y = samples[i * channels + ch];
+        ss += s * s; sc += s * c; cc += c * c;
+        ys += y * s; yc += y * c;
+    }
+
+    double det = ss * cc - sc * sc;
+    double a = (ys * cc - yc * sc) / det;
+    double b = (yc * ss - ys * sc) / det;
+    double signal = 0.0, noise = 0.0;
+
+    for(u32 i = skip; i < frames; i++)
+    {
+        double w = 2.0 * M_PI * freq * i / 48000.0;
+        double fit = a * sin(w) + b * cos(w);
+        double err = samples[i * channels + ch] - fit;
+        signal += fit * fit;
+        noise += err * err;
+    }
+
+    if(noise <= 0.0)
+        return 200.0;
+
+    return 10.0 * log10(signal / noise);
+}
+
+static int runCase(u16 rate, bool stereo, int resize, const double *freqs)
+{
+    ResampleProbe probe(rate, stereo, resize);
+    if(!probe.isEnabled() || probe.getBlockSize() != (resize ? resize : 0x4000))
+    {
+        printf("%5u Hz %s: resampler not set up for %d byte blocks\n", rate, stereo ? "stereo" : "mono", probe.getBlockSize());
+        return 1;
+    }
+
+    u32 channels = stereo ? 2 : 1;
+    u32 frameSize = channels * sizeof(s16);
+    u32 inputFrames = rate * 2;
+    std::vector<s16> output;
+    std::vector<u8> block(probe.getBlockSize());
+    u32 pos = 0;
+
+    //! same sizes as DecodeBlock() reads after EnableUpsample()
+    while(pos < inputFrames)
+    {
+        u32 frames = probe.getReadSize() / frameSize;
+        if(frames > inputFrames - pos)
+            frames = inputFrames - pos;
+
+        s16 *in = (s16*)&block[0];
+        for(u32 i = 0; i < frames; i++)
+        {
+            for(u32 ch = 0; ch < channels; ch++)
+                in[i * channels + ch] = (s16)lrint(16000.0 * sin(2.0 * M_PI * freqs[ch] * (pos + i) / rate));
+        }
+        pos += frames;
+
+        int done = probe.resample(&block[0], frames * frameSize);
+        if(done > probe.getBlockSize())
+        {
+            printf("%5u Hz: block overflow %d > %d\n", rate, done, probe.getBlockSize());
+            return 1;
+        }
+        output.insert(output.end(), (s16*)&block[0], (s16*)&block[0] + done / sizeof(s16));
+    }
+
+    //! output rate has to follow the input length
+    u32 expected = (u32)((u64)inputFrames * 48000 / rate);
+    u32 outFrames = output.size() / channels;
+    int failed = (outFrames + 16 < expected || outFrames > expected + 1);
+
+    for(u32 ch = 0; ch < channels; ch++)
+    {
+        //! skip the silent history the filter starts with
+        double snr = measureSnr(output, channels, ch, freqs[ch], 64);
+        printf("%5u Hz %s ch%u %6.0f Hz, %5u byte blocks: %u frames, snr %.1f dB\n",
+               rate, stereo ? "stereo" : "mono", ch, freqs[ch], probe.getBlockSize(), outFrames, snr);
+        if(snr < MIN_SNR_DB)
+            failed = 1;
+    }
+
+    return failed;
+}
+
+int main(void)
+{
+    static const double tones[2] = { 1000.0, 3150.0 };
+    int failed = 0;
+
+    failed |= runCase(32000, false, 0, tones);
+    failed |= runCase(44100, false, 0, tones);
+    failed |= runCase(22050, true, 0, tones);
+    failed |= runCase(44100, true, 0, tones);
+    failed |= runCase(44100, true, 0x8000, tones);
+
+    printf("resampler: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,145 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <gctypes.h>
+#include "resources/Resources.h"
+#include "gui/GuiImageData.h"
+#include "gui/GuiSound.h"
+
+//! Resources without the embedded file list, files are read from the data folder
+//! of the repository and sounds are not loaded as there is no audio on the host
+
+Resources * Resources::instance = NULL;
+
+static std::map<std::string, std::vector<u8> > fileMap;
+
+static const std::vector<u8> * findFile(const char * filename)
+{
+    std::map<std::string, std::vector<u8> >::iterator itr = fileMap.find(filename);
+    if(itr != fileMap.end())
+        return itr->second.empty() ? NULL : &itr->second;
+
+    static const char * folders[] = { "../data/images/", "../data/sounds/", "../data/fonts/" };
+    std::vector<u8> & buffer = fileMap[filename];
+
+    for(u32 i = 0; i < sizeof(folders) / sizeof(folders[0]) && buffer.empty(); i++)
+    {
+        std::string fullpath = std::string(folders[i]) + filename;
+        FILE *file = fopen(fullpath.c_str(), "rb");
+        if(!file)
+            continue;
+
+        fseek(file, 0, SEEK_END);
+        buffer.resize(ftell(file));
+        fseek(file, 0, SEEK_SET);
+        if(buffer.empty() || fread(&buffer[0], 1, buffer.size(), file) != buffer.size())
+            buffer.clear();
+        fclose(file);
+    }
+
+    return buffer.empty() ? NULL : &buffer;
+}
+
+void Resources::Clear()
+{
+    fileMap.clear();
+
+    if(instance)
+        delete instance;
+
+    instance = NULL;
+}
+
+bool Resources::LoadFiles(const char * path)
+{
+    return false;
+}
+
+const u8 * Resources::GetFile(const char * filename)
+{
+    const std::vector<u8> * file = findFile(filename);
+    return file ? &(*file)[0] : NULL;
+}
+
+u32 Resources::GetFileSize(const char * filename)
+{
+    const std::vector<u8> * file = findFile(filename);
+    return file ? file->size() : 0;
+}
+
+GuiImageData * Resources::GetImageData(const char * filename)
+{
+    if(!instance)
+        instance = new Resources;
+
+    std::map<std::string, std::pair<unsigned int, GuiImageData *> >::iterator itr = instance->imageDataMap.find(std::string(filename));
+    if(itr != instance->imageDataMap.end())
+    {
+        itr->second.first++;
+        return itr->second.second;
+    }
+
+    const std::vector<u8> * file = findFile(filename);
+    if(!file)
+        return NULL;
+
+    GuiImageData * image = new GuiImageData(&(*file)[0], file->size());
+    instance->imageDataMap[std::string(filename)].first = 1;
+    instance->imageDataMap[std::string(filename)].second = image;
+    return image;
+}
+
+void Resources::RemoveImageData(GuiImageData * image)
+{
+    if(!instance)
+        return;
+
+    std::map<std::string, std::pair<unsigned int, GuiImageData *> >::iterator itr;
+
+    for(itr = instance->imageDataMap.begin(); itr != instance->imageDataMap.end(); itr++)
+    {
+        if(itr->second.second == image)
+        {
+            itr->second.first--;
+
+            if(itr->second.first == 0)
+            {
+                delete itr->second.second;
+                instance->imageDataMap.erase(itr);
+            }
+            break;
+        }
+    }
+}
+
+GuiSound * Resources::GetSound(const char * filename)
+{
+    return NULL;
+}
+
+void Resources::RemoveSound(GuiSound * sound)
+{
+}
+
+//! GetSound() never creates a sound on the host, the buttons only call this with one
+void GuiSound::Play()
+{
+}
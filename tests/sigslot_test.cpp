@@ -0,0 +1,173 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include "gui/sigslot.h"
+
+//! Checks the connection list of the signals when slots connect and
+//! disconnect receivers while the signal is being emitted.
+
+static int failures = 0;
+
+#define CHECK(cond) \
+    do { if(!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); failures++; } } while(0)
+
+class Receiver : public sigslot::has_slots<>
+{
+public:
+    Receiver() : calls(0), signal(NULL), other(NULL), nested(false) {}
+
+    void OnCount(int value) {
+        calls++;
+    }
+    void OnDisconnectSelf(int value) {
+        calls++;
+        signal->disconnect(this);
+    }
+    void OnDisconnectOther(int value) {
+        calls++;
+        signal->disconnect(other);
+    }
+    void OnDeleteOther(int value) {
+        calls++;
+        delete other;
+        other = NULL;
+    }
+    void OnConnectOther(int value) {
+        calls++;
+        signal->connect(other, &Receiver::OnCount);
+        signal->disconnect(this);
+    }
+    void OnNestedDisconnect(int value) {
+        calls++;
+        if(!nested)
+        {
+            nested = true;
+            (*signal)(value);
+            signal->disconnect(other);
+        }
+    }
+
+    int calls;
+    sigslot::signal1<int> *signal;
+    Receiver *other;
+    bool nested;
+};
+
+static void testDisconnectSelf(void)
+{
+    sigslot::signal1<int> signal;
+    Receiver a, b, c;
+    b.signal = &signal;
+
+    signal.connect(&a, &Receiver::OnCount);
+    signal.connect(&b, &Receiver::OnDisconnectSelf);
+    signal.connect(&c, &Receiver::OnCount);
+
+    signal(1);
+    CHECK(a.calls == 1 && b.calls == 1 && c.calls == 1);
+
+    signal(2);
+    CHECK(a.calls == 2 && b.calls == 1 && c.calls == 2);
+}
+
+static void testDisconnectLater(void)
+{
+    sigslot::signal1<int> signal;
+    Receiver a, b;
+    a.signal = &signal;
+    a.other = &b;
+
+    signal.connect(&a, &Receiver::OnDisconnectOther);
+    signal.connect(&b, &Receiver::OnCount);
+
+    //! b is removed before its turn
+    signal(1);
+    CHECK(a.calls == 1 && b.calls == 0);
+
+    signal(2);
+    CHECK(a.calls == 2 && b.calls == 0);
+}
+
+static void testDeleteReceiver(void)
+{
+    sigslot::signal1<int> signal;
+    Receiver a, c;
+    Receiver *b = new Receiver();
+    a.other = b;
+
+    signal.connect(&a, &Receiver::OnDeleteOther);
+    signal.connect(b, &Receiver::OnCount);
+    signal.connect(&c, &Receiver::OnCount);
+
+    //! the destructor of has_slots disconnects from the signal that is emitted
+    signal(1);
+    CHECK(a.calls == 1 && a.other == NULL && c.calls == 1);
+
+    signal(2);
+    CHECK(a.calls == 2 && c.calls == 2);
+}
+
+static void testConnectDuringEmit(void)
+{
+    sigslot::signal1<int> signal;
+    Receiver a, b;
+    a.signal = &signal;
+    a.other = &b;
+
+    signal.connect(&a, &Receiver::OnConnectOther);
+
+    //! new connections are appended and only reached from the next emission on
+    signal(1);
+    CHECK(a.calls == 1 && b.calls == 0);
+
+    signal(2);
+    CHECK(a.calls == 1 && b.calls == 1);
+}
+
+static void testNestedEmit(void)
+{
+    sigslot::signal1<int> signal;
+    Receiver a, b;
+    a.signal = &signal;
+    a.other = &b;
+
+    signal.connect(&a, &Receiver::OnNestedDisconnect);
+    signal.connect(&b, &Receiver::OnCount);
+
+    //! the inner emission reaches b, the removal after it must not drop a
+    signal(1);
+    CHECK(a.calls == 2 && b.calls == 1);
+
+    signal(2);
+    CHECK(a.calls == 3 && b.calls == 1);
+
+    signal.disconnect_all();
+    signal(3);
+    CHECK(a.calls == 3 && b.calls == 1);
+}
+
+int main(void)
+{
+    testDisconnectSelf();
+    testDisconnectLater();
+    testDeleteReceiver();
+    testConnectDuringEmit();
+    testNestedEmit();
+
+    printf("sigslot: %s\n", failures ? "FAILED" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,316 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "gui/GuiText.h"
+#include "video/CVideo.h"
+#include "system/CProfiler.h"
+
+//! Wraps and scrolls long multilingual game titles with GuiText and with a copy
+//! of the old code that asked the font for every character on each wrap and
+//! scroll step. Both have to produce the same lines, the times are printed.
+//! The bundled font only has latin glyphs, DejaVu Sans is used as well for the
+//! greek and cyrillic parts when it is installed.
+
+static const u32 TITLES = 200;
+static const int FONT_SIZE = 28;
+static const int WRAP_WIDTHS[] = { 600, 450, 300, 200 };
+static const int SCROLL_WIDTH = 300;
+static const u32 SCROLL_STEPS = 500;
+static const char *MULTILINGUAL_FONT = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+
+static bool loadFile(const char *path, std::vector<u8> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if(!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    data.resize(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    bool ok = fread(&data[0], 1, data.size(), file) == data.size();
+    fclose(file);
+    return ok;
+}
+
+//! titles of 15 to 30 words with latin, greek and cyrillic words mixed
+static std::vector<std::wstring> makeTitles(void)
+{
+    static const wchar_t *words[] =
+    {
+        L"The", L"Legend", L"of", L"Zelda:", L"Twilight", L"Princess", L"HD", L"Édition", L"Spéciale",
+        L"für", L"Straßen", L"und", L"Brücken", L"Pokémon", L"Mystery", L"Dungeon", L"Año", L"Nuevo",
+        L"Ελληνική", L"Περιπέτεια", L"στο", L"Νησί", L"Русская", L"Версия", L"Приключения", L"Героев",
+        L"Chronicles", L"Deluxe", L"Collector's", L"Bundle", L"-", L"Complete", L"Season", L"Pass"
+    };
+    static const u32 wordCount = sizeof(words) / sizeof(words[0]);
+
+    std::vector<std::wstring> titles(TITLES);
+    u32 seed = 4242;
+
+    for(u32 t = 0; t < TITLES; t++)
+    {
+        seed = seed * 1103515245 + 12345;
+        u32 count = 15 + ((seed >> 16) % 16);
+
+        for(u32 w = 0; w < count; w++)
+        {
+            seed = seed * 1103515245 + 12345;
+            if(w > 0)
+                titles[t] += L' ';
+            titles[t] += words[(seed >> 16) % wordCount];
+        }
+    }
+    return titles;
+}
+
+//! gives access to the wrapping and scrolling of GuiText
+class LayoutText : public GuiText
+{
+public:
+    LayoutText(const wchar_t *t) : GuiText(t, FONT_SIZE, glm::vec4(1.0f)) {}
+
+    void rewrap(int width)
+    {
+        clearDynamicText();
+        maxWidth = width;
+        wrapText();
+    }
+
+    void startScroll(int width)
+    {
+        clearDynamicText();
+        maxWidth = width;
+    }
+
+    void scrollTo(int pos)
+    {
+        textScrollPos = pos;
+        scrollText();
+    }
+
+    std::vector<std::wstring> getLines(void)
+    {
+        std::vector<std::wstring> lines;
+        for(u32 i = 0; i < textDyn.size(); i++)
+            lines.push_back(textDyn[i]);
+        return lines;
+    }
+
+    int getLinesToDraw(void) const {
+        return linestodraw;
+    }
+};
+
+//! GuiText::wrapText() before the advances were kept
+static std::vector<std::wstring> referenceWrap(FreeTypeGX *font, const wchar_t *text, int maxWidth, int linestodraw)
+{
+    std::vector<std::wstring> lines;
+    std::vector<wchar_t> line(maxWidth);
+    int i = 0, ch = 0, linenum = 0;
+    int lastSpace = -1, lastSpaceIndex = -1;
+    int currentWidth = 0;
+
+    while (text[ch] && linenum < linestodraw)
+    {
+        if (linenum >= (int) lines.size())
+            lines.resize(linenum + 1);
+
+        line[i] = text[ch];
+        line[i + 1] = 0;
+
+        currentWidth += font->getCharWidth(text[ch], FONT_SIZE, ch > 0 ? text[ch - 1] : 0x0000);
+
+        if (currentWidth >= maxWidth)
+        {
+            if (lastSpace >= 0)
+            {
+                line[lastSpaceIndex] = 0;
+                ch = lastSpace;
+                lastSpace = -1;
+                lastSpaceIndex = -1;
+            }
+
+            if (linenum + 1 == linestodraw && text[ch + 1] != 0x0000)
+            {
+                line[i - 2] = '.';
+                line[i - 1] = '.';
+                line[i] = '.';
+                line[i + 1] = 0;
+            }
+
+            lines[linenum] = &line[0];
+            currentWidth = 0;
+            ++linenum;
+            i = -1;
+        }
+        if (text[ch] == ' ' && i >= 0)
+        {
+            lastSpace = ch;
+            lastSpaceIndex = i;
+        }
+        ++ch;
+        ++i;
+    }
+
+    if (linenum < (int) lines.size())
+        lines[linenum] = &line[0];
+    return lines;
+}
+
+//! the visible part of GuiText::scrollText() before the advances were kept
+static std::wstring referenceScroll(FreeTypeGX *font, const wchar_t *text, int maxWidth, int pos)
+{
+    std::vector<wchar_t> window(maxWidth);
+    int stringlen = wcslen(text);
+    int ch = pos;
+    int i = 0, currentWidth = 0;
+
+    while (currentWidth < maxWidth)
+    {
+        if (ch > stringlen - 1)
+        {
+            window[i++] = ' ';
+            currentWidth += font->getCharWidth(L' ', FONT_SIZE, ch > 0 ? text[ch - 1] : 0);
+            window[i++] = ' ';
+            currentWidth += font->getCharWidth(L' ', FONT_SIZE, L' ');
+            window[i++] = ' ';
+            currentWidth += font->getCharWidth(L' ', FONT_SIZE, L' ');
+            ch = 0;
+
+            if(currentWidth >= maxWidth)
+                break;
+        }
+
+        window[i] = text[ch];
+        currentWidth += font->getCharWidth(text[ch], FONT_SIZE, ch > 0 ? text[ch - 1] : 0);
+        ++ch;
+        ++i;
+    }
+    window[i] = 0;
+    return &window[0];
+}
+
+static int runFont(const char *name, const std::vector<u8> &font, const std::vector<std::wstring> &titles)
+{
+    CVideo video;
+    FreeTypeGX ftgx(&font[0], font.size());
+    GuiText::setPresetFont(&ftgx);
+
+    std::vector<LayoutText *> texts(titles.size());
+    const u32 widths = sizeof(WRAP_WIDTHS) / sizeof(WRAP_WIDTHS[0]);
+    u32 differences = 0;
+
+    //! the first draw sets the size
+    for(u32 t = 0; t < titles.size(); t++)
+    {
+        texts[t] = new LayoutText(titles[t].c_str());
+        texts[t]->draw(&video);
+    }
+
+    //! the first wrap measures every character, the phases are timed as a whole
+    u64 start = CProfiler::getTime();
+    for(u32 t = 0; t < titles.size(); t++)
+        texts[t]->rewrap(WRAP_WIDTHS[0]);
+    u64 measureTicks = CProfiler::getTime() - start;
+
+    start = CProfiler::getTime();
+    for(u32 t = 0; t < titles.size(); t++)
+        for(u32 w = 0; w < widths; w++)
+            texts[t]->rewrap(WRAP_WIDTHS[w]);
+    u64 wrapTicks = CProfiler::getTime() - start;
+
+    start = CProfiler::getTime();
+    for(u32 t = 0; t < titles.size(); t++)
+        for(u32 w = 0; w < widths; w++)
+            referenceWrap(&ftgx, titles[t].c_str(), WRAP_WIDTHS[w], texts[t]->getLinesToDraw());
+    u64 referenceWrapTicks = CProfiler::getTime() - start;
+
+    for(u32 t = 0; t < titles.size(); t++)
+    {
+        for(u32 w = 0; w < widths; w++)
+        {
+            texts[t]->rewrap(WRAP_WIDTHS[w]);
+            if(referenceWrap(&ftgx, titles[t].c_str(), WRAP_WIDTHS[w], texts[t]->getLinesToDraw()) != texts[t]->getLines())
+                differences++;
+        }
+        texts[t]->startScroll(SCROLL_WIDTH);
+    }
+
+    start = CProfiler::getTime();
+    for(u32 t = 0; t < titles.size(); t++)
+        for(u32 s = 0; s < SCROLL_STEPS; s++)
+            texts[t]->scrollTo(s % (titles[t].size() + 1));
+    u64 scrollTicks = CProfiler::getTime() - start;
+
+    start = CProfiler::getTime();
+    for(u32 t = 0; t < titles.size(); t++)
+        for(u32 s = 0; s < SCROLL_STEPS; s++)
+            referenceScroll(&ftgx, titles[t].c_str(), SCROLL_WIDTH, s % (titles[t].size() + 1));
+    u64 referenceScrollTicks = CProfiler::getTime() - start;
+
+    for(u32 t = 0; t < titles.size(); t++)
+    {
+        for(u32 s = 0; s < SCROLL_STEPS; s++)
+        {
+            int pos = s % (titles[t].size() + 1);
+            texts[t]->scrollTo(pos);
+            std::vector<std::wstring> lines = texts[t]->getLines();
+            if(lines.size() != 1 || lines[0] != referenceScroll(&ftgx, titles[t].c_str(), SCROLL_WIDTH, pos))
+                differences++;
+        }
+        delete texts[t];
+    }
+
+    u32 wraps = titles.size() * widths;
+    u32 scrolls = titles.size() * SCROLL_STEPS;
+    printf("%-12s first wrap %.2f us, rewrap %.2f us (%.2f us before), scroll step %.3f us (%.3f us before), %u layouts differ\n",
+           name, CProfiler::ticksToMicroseconds(measureTicks) / (double)titles.size(),
+           CProfiler::ticksToMicroseconds(wrapTicks) / (double)wraps, CProfiler::ticksToMicroseconds(referenceWrapTicks) / (double)wraps,
+           CProfiler::ticksToMicroseconds(scrollTicks) / (double)scrolls, CProfiler::ticksToMicroseconds(referenceScrollTicks) / (double)scrolls,
+           differences);
+
+    GuiText::setPresetFont(NULL);
+    return differences ? 1 : 0;
+}
+
+int main(void)
+{
+    std::vector<u8> font;
+    if(!loadFile("../data/fonts/font.ttf", font))
+    {
+        printf("font.ttf could not be read\n");
+        return 1;
+    }
+
+    std::vector<std::wstring> titles = makeTitles();
+
+    int failed = 0;
+    failed |= runFont("font.ttf", font, titles);
+
+    std::vector<u8> multilingualFont;
+    if(loadFile(MULTILINGUAL_FONT, multilingualFont))
+        failed |= runFont("DejaVuSans", multilingualFont, titles);
+    else
+        printf("%s not found, greek and cyrillic glyphs not measured\n", MULTILINGUAL_FONT);
+
+    printf("text layout: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "gui/GuiText.h"
+#include "video/CVideo.h"
+#include "system/CProfiler.h"
+#include "gx2_record.h"
+
+//! Runs a scrolling GuiText through the main loop order of Application and counts
+//! the frames that have to be drawn, and overfills the glyph vertex ring of
+//! FreeTypeGX to check that the quads that fit are drawn and the rest counted.
+
+//! same as in FreeTypeGX.cpp
+static const u32 RING_QUADS = 4096;
+
+static bool loadFile(const char *path, std::vector<u8> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if(!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    data.resize(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    bool ok = fread(&data[0], 1, data.size(), file) == data.size();
+    fclose(file);
+    return ok;
+}
+
+static int runScroll(FreeTypeGX &ftgx)
+{
+    static const u32 FRAMES = 600;
+
+    CVideo video;
+    GuiText::setPresetFont(&ftgx);
+    GuiText text("A game title that is far too long for its box", 28, glm::vec4(1.0f));
+    text.setMaxWidth(200, GuiText::SCROLL_HORIZONTAL);
+
+    u32 drawn = 0;
+    u32 unchanged = 0;
+    std::wstring last;
+
+    for(u32 frame = 0; frame < FRAMES; frame++)
+    {
+        //! like Application::executeThread()
+        if(GuiElement::checkRedrawRequest() || frame == 0)
+        {
+            text.draw(&video);
+            drawn++;
+
+            std::wstring visible = text.getDynText() ? text.getDynText() : L"";
+            if(visible == last)
+                unchanged++;
+            last = visible;
+        }
+
+        text.updateEffects();
+        video.waitForVSync();
+    }
+
+    //! one step every 5 frames at most, minus the initial delays at the start and after each wrap
+    printf("scroll: %u of %u frames drawn, %u drawn without the text moving\n", drawn, FRAMES, unchanged);
+
+    return (drawn > FRAMES / 5 + 1 || drawn < FRAMES / 10 || unchanged > 1) ? 1 : 0;
+}
+
+static int runRingOverflow(FreeTypeGX &ftgx)
+{
+    static const u32 GLYPHS = 5000;
+
+    CVideo video;
+    CProfiler *profiler = CProfiler::instance();
+    profiler->setEnabled(true);
+    profiler->beginFrame();
+
+    std::wstring longText(GLYPHS, L'a');
+    std::vector<ftgxGlyphQuad> quads;
+    ftgx.layoutText(quads, 0, 0, longText.c_str(), 20, 0, 0);
+
+    GX2Record::reset();
+    ftgx.drawGlyphQuads(&video, 0, 0, 0, quads, 20, glm::vec4(1.0f), 0.0f, 0.0f, glm::vec4(0.0f));
+    //! the ring is full now, the next string of the frame is dropped completely
+    ftgx.drawGlyphQuads(&video, 0, 0, 0, quads, 20, glm::vec4(1.0f), 0.0f, 0.0f, glm::vec4(0.0f));
+    u32 vertices = GX2Record::get(GX2Record::CALL_VERTICES);
+
+    //! the next frame has its own half of the ring
+    video.waitForVSync();
+    GX2Record::reset();
+    ftgx.drawGlyphQuads(&video, 0, 0, 0, quads, 20, glm::vec4(1.0f), 0.0f, 0.0f, glm::vec4(0.0f));
+    u32 nextVertices = GX2Record::get(GX2Record::CALL_VERTICES);
+
+    profiler->beginFrame();
+    u32 dropped = profiler->getCounterTotal(CProfiler::COUNTER_GLYPHS_DROPPED);
+    CProfiler::destroyInstance();
+
+    //! a horizontal and a vertical blur pass, four vertices per quad
+    u32 expected = RING_QUADS * 4 * 2;
+    u32 expectedDropped = (GLYPHS - RING_QUADS) * 2 + GLYPHS;
+
+    printf("ring overflow: %u glyphs, %u vertices drawn then %u in the next frame (%u expected), %u glyphs dropped (%u expected)\n",
+           (u32)quads.size(), vertices, nextVertices, expected, dropped, expectedDropped);
+
+    return (quads.size() != GLYPHS || vertices != expected || nextVertices != expected || dropped != expectedDropped) ? 1 : 0;
+}
+
+int main(void)
+{
+    std::vector<u8> font;
+    if(!loadFile("../data/fonts/font.ttf", font))
+    {
+        printf("font.ttf could not be read\n");
+        return 1;
+    }
+
+    FreeTypeGX ftgx(&font[0], font.size());
+
+    int failed = 0;
+    failed |= runScroll(ftgx);
+    failed |= runRingOverflow(ftgx);
+
+    printf("text: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
@@ -0,0 +1,63 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+#include "resources/TextureDiskCache.h"
+#include "gui/GuiImageData.h"
+
+//! TextureDiskCache without the SD card, every image is decoded from its file again
+
+TextureDiskCache *TextureDiskCache::cacheInstance = NULL;
+
+TextureDiskCache::TextureDiskCache()
+    : totalSize(0)
+    , useCounter(0)
+{
+}
+
+TextureDiskCache::~TextureDiskCache()
+{
+}
+
+GuiImageData * TextureDiskCache::loadImage(const std::string & filepath, int textureClamp, int textureFormat)
+{
+    FILE *file = fopen(filepath.c_str(), "rb");
+    if(!file)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+    std::vector<u8> buffer(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    bool ok = !buffer.empty() && fread(&buffer[0], 1, buffer.size(), file) == buffer.size();
+    fclose(file);
+
+    if(!ok)
+        return NULL;
+
+    GuiImageData *image = new GuiImageData(&buffer[0], buffer.size(), textureClamp, textureFormat);
+    if(!image->getTexture())
+    {
+        delete image;
+        return NULL;
+    }
+    return image;
+}
+
+void TextureDiskCache::clear()
+{
+}
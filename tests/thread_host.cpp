@@ -0,0 +1,135 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <new>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "dynamic_libs/os_functions.h"
+
+//! coreinit threads backed by std::thread. Threads start suspended like on the
+//! console and the GUI only ever suspends the calling thread, so suspending is
+//! a wait on a condition variable until the suspend count drops to zero.
+
+typedef struct
+{
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable resumed;
+    int suspendCount;
+    bool terminated;
+    s32 (*callback)(s32, void*);
+    s32 argc;
+    void *args;
+    int result;
+} HostThread;
+
+//! CThread allocates 0x1000 bytes for the OSThread
+static_assert(sizeof(HostThread) <= 0x1000, "HostThread does not fit into an OSThread");
+
+static void waitWhileSuspended(HostThread *t)
+{
+    std::unique_lock<std::mutex> lock(t->mutex);
+    t->resumed.wait(lock, [t] { return t->suspendCount == 0; });
+}
+
+static void threadEntry(HostThread *t)
+{
+    waitWhileSuspended(t);
+
+    int result = t->callback(t->argc, t->args);
+
+    std::lock_guard<std::mutex> lock(t->mutex);
+    t->result = result;
+    t->terminated = true;
+}
+
+static int hostCreateThread(void *thread, s32 (*callback)(s32, void*), s32 argc, void *args, u32 stack, u32 stack_size, s32 priority, u32 attr)
+{
+    HostThread *t = new (thread) HostThread();
+    t->suspendCount = 1;
+    t->terminated = false;
+    t->callback = callback;
+    t->argc = argc;
+    t->args = args;
+    t->result = 0;
+    t->thread = std::thread(threadEntry, t);
+    return 1;
+}
+
+static int hostResumeThread(void *thread)
+{
+    HostThread *t = (HostThread *)thread;
+    std::lock_guard<std::mutex> lock(t->mutex);
+    int previous = t->suspendCount;
+    if(t->suspendCount > 0 && --t->suspendCount == 0)
+        t->resumed.notify_all();
+    return previous;
+}
+
+static int hostSuspendThread(void *thread)
+{
+    HostThread *t = (HostThread *)thread;
+    int previous;
+    {
+        std::lock_guard<std::mutex> lock(t->mutex);
+        previous = t->suspendCount++;
+    }
+
+    if(t->thread.get_id() == std::this_thread::get_id())
+        waitWhileSuspended(t);
+    return previous;
+}
+
+static int hostIsThreadSuspended(void *thread)
+{
+    HostThread *t = (HostThread *)thread;
+    std::lock_guard<std::mutex> lock(t->mutex);
+    return t->suspendCount > 0;
+}
+
+static int hostIsThreadTerminated(void *thread)
+{
+    HostThread *t = (HostThread *)thread;
+    std::lock_guard<std::mutex> lock(t->mutex);
+    return t->terminated;
+}
+
+static int hostJoinThread(void *thread, int *ret_val)
+{
+    HostThread *t = (HostThread *)thread;
+    if(t->thread.joinable())
+        t->thread.join();
+    if(ret_val)
+        *ret_val = t->result;
+
+    //! CThread frees the memory afterwards
+    t->~HostThread();
+    return 1;
+}
+
+static int hostSetThreadPriority(void *thread, int priority)
+{
+    return 1;
+}
+
+int (* OSCreateThread)(void *thread, s32 (*callback)(s32, void*), s32 argc, void *args, u32 stack, u32 stack_size, s32 priority, u32 attr) = hostCreateThread;
+int (* OSResumeThread)(void *thread) = hostResumeThread;
+int (* OSSuspendThread)(void *thread) = hostSuspendThread;
+int (* OSIsThreadTerminated)(void *thread) = hostIsThreadTerminated;
+int (* OSIsThreadSuspended)(void *thread) = hostIsThreadSuspended;
+int (* OSJoinThread)(void * thread, int * ret_val) = hostJoinThread;
+int (* OSSetThreadPriority)(void * thread, int priority) = hostSetThreadPriority;
@@ -0,0 +1,158 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <stdio.h>
+#include <vector>
+#include "gui/GuiFrame.h"
+#include "gui/GuiImage.h"
+#include "gui/GuiButton.h"
+#include "gui/GuiController.h"
+#include "gui/GuiTrigger.h"
+#include "system/CProfiler.h"
+
+//! Builds a tree of 40 frames with 50 images each and a screen of 10 buttons
+//! and times update() and updateEffects() of the root for 1000 frames. The
+//! idle tree, a tree with one image fading, and a walk over every element as
+//! the frames did before are compared. Idle images must not be visited.
+
+static const int FRAMES = 1000;
+static const int GROUPS = 40;
+static const int GROUP_IMAGES = 50;
+static const int BUTTONS = 10;
+
+static u32 updateVisits = 0;
+static u32 effectVisits = 0;
+
+class CountedImage : public GuiImage
+{
+public:
+    CountedImage() : GuiImage(10, 10, (GX2Color){ 255, 255, 255, 255 }) {}
+
+    void update(GuiController *c) {
+        updateVisits++;
+        GuiImage::update(c);
+    }
+    void updateEffects() {
+        effectVisits++;
+        GuiImage::updateEffects();
+    }
+};
+
+//! what every frame did before, forward to all children whether they need it or not
+static void walkAll(GuiElement *element, GuiController *c)
+{
+    GuiFrame *frame = dynamic_cast<GuiFrame *>(element);
+    if(!frame)
+    {
+        element->update(c);
+        element->updateEffects();
+        return;
+    }
+
+    for(u32 i = 0; i < frame->getSize(); i++)
+        walkAll(frame->getGuiElementAt(i), c);
+}
+
+static double runFrames(GuiFrame *root, GuiController *c, bool bWalkAll, u32 & updates, u32 & effects)
+{
+    updateVisits = 0;
+    effectVisits = 0;
+
+    u64 start = CProfiler::getTime();
+    for(int frame = 0; frame < FRAMES; frame++)
+    {
+        if(bWalkAll)
+        {
+            walkAll(root, c);
+        }
+        else
+        {
+            root->update(c);
+            root->updateEffects();
+        }
+    }
+    u64 ticks = CProfiler::getTime() - start;
+
+    updates = updateVisits;
+    effects = effectVisits;
+    return CProfiler::ticksToMicroseconds(ticks) / (double)FRAMES;
+}
+
+int main(void)
+{
+    GuiController controller;
+    GuiTrigger trigger(GuiTrigger::CHANNEL_ALL, GuiTrigger::BUTTON_A, true);
+
+    GuiFrame root(1280, 720);
+    std::vector<GuiFrame *> groups(GROUPS);
+    std::vector<CountedImage *> images;
+
+    for(int i = 0; i < GROUPS; i++)
+    {
+        groups[i] = new GuiFrame(1280, 720);
+        for(int n = 0; n < GROUP_IMAGES; n++)
+        {
+            images.push_back(new CountedImage);
+            groups[i]->append(images.back());
+        }
+        root.append(groups[i]);
+    }
+
+    //! the screen in front takes the input
+    GuiFrame buttonFrame(1280, 720);
+    std::vector<GuiButton *> buttons(BUTTONS);
+    for(int i = 0; i < BUTTONS; i++)
+    {
+        buttons[i] = new GuiButton(100, 50);
+        buttons[i]->setTrigger(&trigger);
+        buttonFrame.append(buttons[i]);
+    }
+    root.append(&buttonFrame);
+
+    //! let the effects of the initial state run out
+    root.updateEffects();
+
+    u32 updates, effects;
+    double idleUs = runFrames(&root, &controller, false, updates, effects);
+    printf("update tree of %i images and %i buttons, idle: %.1f us per frame, %.1f image updates and %.1f image effect updates\n",
+           GROUPS * GROUP_IMAGES, BUTTONS, idleUs, updates / (double)FRAMES, effects / (double)FRAMES);
+
+    int failed = (updates != 0 || effects != 0);
+
+    //! a scale effect slow enough to run through all frames
+    images[GROUP_IMAGES / 2]->setEffect(EFFECT_SCALE, 1, 100 + FRAMES + 10);
+
+    double animatedUs = runFrames(&root, &controller, false, updates, effects);
+    printf("update tree of %i images and %i buttons, one image animated: %.1f us per frame, %.1f image updates and %.1f image effect updates\n",
+           GROUPS * GROUP_IMAGES, BUTTONS, animatedUs, updates / (double)FRAMES, effects / (double)FRAMES);
+
+    //! only the group of the animated image is visited
+    failed |= (updates != 0 || effects != (u32)(FRAMES * GROUP_IMAGES));
+
+    double walkUs = runFrames(&root, &controller, true, updates, effects);
+    printf("update tree of %i images and %i buttons, every element visited: %.1f us per frame, %.1f image updates and %.1f image effect updates\n",
+           GROUPS * GROUP_IMAGES, BUTTONS, walkUs, updates / (double)FRAMES, effects / (double)FRAMES);
+
+    for(int i = 0; i < BUTTONS; i++)
+        delete buttons[i];
+    for(size_t i = 0; i < images.size(); i++)
+        delete images[i];
+    for(int i = 0; i < GROUPS; i++)
+        delete groups[i];
+
+    printf("update tree: %s\n", failed ? "FAILED" : "ok");
+    return failed;
+}
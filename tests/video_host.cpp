@@ -0,0 +1,82 @@
+/****************************************************************************
+ * Copyright (C) 2015 Dimok
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ ****************************************************************************/
+#include <string.h>
+#include "video/CVideo.h"
+#include "video/shaders/Texture2DShader.h"
+#include "video/shaders/ColorShader.h"
+
+//! CVideo without scan, color and depth buffers, the host has no GPU to set up.
+//! Only the sizes and scale factors the GUI layer reads are filled in, with the
+//! TV at 720p like the default scan mode on the console.
+
+CVideo::CVideo(s32 forceTvScanMode, s32 forceDrcScanMode)
+{
+    tvEnabled = false;
+    drcEnabled = false;
+    fxaaMode = AA_MODE_ALWAYS;
+    stillFrame = false;
+    frameCount = 0;
+
+    gx2CommandBuffer = NULL;
+    tvScanBuffer = NULL;
+    drcScanBuffer = NULL;
+    tvContextState = NULL;
+    drcContextState = NULL;
+    currContextState = NULL;
+    currColorBuffer = &tvColorBuffer;
+    currDepthBuffer = &tvDepthBuffer;
+
+    memset(&tvColorBuffer, 0, sizeof(tvColorBuffer));
+    memset(&tvDepthBuffer, 0, sizeof(tvDepthBuffer));
+    memset(&drcColorBuffer, 0, sizeof(drcColorBuffer));
+    memset(&drcDepthBuffer, 0, sizeof(drcDepthBuffer));
+    memset(&tvAaTexture, 0, sizeof(tvAaTexture));
+    memset(&aaSampler, 0, sizeof(aaSampler));
+
+    tvColorBuffer.surface.width = 1280;
+    tvColorBuffer.surface.height = 720;
+    drcColorBuffer.surface.width = 854;
+    drcColorBuffer.surface.height = 480;
+
+    widthScaleFactor = 1.0f / (f32)tvColorBuffer.surface.width;
+    heightScaleFactor = 1.0f / (f32)tvColorBuffer.surface.height;
+    depthScaleFactor = widthScaleFactor;
+
+    projectionMtx = glm::perspective(45.0f, 1.0f, 0.1f, 100.0f);
+    viewMtx = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -2.5f));
+}
+
+CVideo::~CVideo()
+{
+    ColorShader::destroyInstance();
+    Texture2DShader::destroyInstance();
+    SpriteBatch::destroy();
+}
+
+void CVideo::renderFXAA(const GX2Texture * texture, const GX2Sampler *sampler)
+{
+}
+
+void* CVideo::GX2RAlloc(u32 flags, u32 size, u32 align)
+{
+    return memalign(align < 4 ? 4 : align, size);
+}
+
+void CVideo::GX2RFree(u32 flags, void* p)
+{
+    free(p);
+}